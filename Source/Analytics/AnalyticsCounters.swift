@@ -0,0 +1,69 @@
+//
+// Wire
+// Copyright (C) 2022 Wire Swiss GmbH
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see http://www.gnu.org/licenses/.
+//
+
+import Foundation
+
+/// In-memory counters which can be incremented from any thread at the cost of an
+/// uncontended unfair lock. The counts are meant to be drained periodically into
+/// a slower store, such as the persisted analytics attributes.
+final class AnalyticsCounters<Key: Hashable> {
+
+    private let lock: UnsafeMutablePointer<os_unfair_lock>
+    private var counts = [Key: Int]()
+
+    init() {
+        lock = .allocate(capacity: 1)
+        lock.initialize(to: os_unfair_lock())
+    }
+
+    deinit {
+        lock.deinitialize(count: 1)
+        lock.deallocate()
+    }
+
+    /// Increments the count of the key.
+    /// - returns: `true` if there were no pending counts before, i.e. a drain needs to be scheduled
+    @discardableResult
+    func increment(_ key: Key, by amount: Int = 1) -> Bool {
+        os_unfair_lock_lock(lock)
+        defer { os_unfair_lock_unlock(lock) }
+
+        let wasEmpty = counts.isEmpty
+        counts[key, default: 0] += amount
+        return wasEmpty
+    }
+
+    /// The counts since the last drain
+    var pendingCounts: [Key: Int] {
+        os_unfair_lock_lock(lock)
+        defer { os_unfair_lock_unlock(lock) }
+
+        return counts
+    }
+
+    /// Returns the counts since the last drain and resets them
+    func drain() -> [Key: Int] {
+        os_unfair_lock_lock(lock)
+        defer { os_unfair_lock_unlock(lock) }
+
+        let drained = counts
+        counts.removeAll(keepingCapacity: true)
+        return drained
+    }
+
+}
@@ -38,6 +38,11 @@ import WireDataModel
     }
     private let isolationQueue = DispatchQueue(label: "NotificationsProcessing")
 
+    /// Counts are kept in memory and written to the persisted attributes at most this often
+    static let flushInterval: TimeInterval = 5
+
+    private let counters = AnalyticsCounters<Attributes>()
+
     weak var analytics: AnalyticsType?
     public init(analytics: AnalyticsType) {
         self.analytics = analytics
@@ -49,6 +54,7 @@ import WireDataModel
 
     public func registerNotificationProcessingCompleted() {
         increment(attribute: .finishedProcessing)
+        flush()
     }
 
     public func registerFinishStreamFetching() {
@@ -61,28 +67,54 @@ import WireDataModel
 
     public func registerProcessingExpired() {
         increment(attribute: .processingExpired)
+        flush()
     }
 
     public func registerProcessingAborted() {
         increment(attribute: .abortedProcessing)
+        flush()
     }
 
     public func registerTokenMismatch() {
         increment(attribute: .tokenMismatch)
     }
 
-    private func increment(attribute: Attributes, by amount: Double = 1) {
+    private func increment(attribute: Attributes, by amount: Int = 1) {
+        guard counters.increment(attribute, by: amount) else { return }
+
+        isolationQueue.asyncAfter(deadline: .now() + Self.flushInterval) { [weak self] in
+            self?.flushCounters()
+        }
+    }
+
+    /// Writes the counts since the last flush to the persisted attributes.
+    /// Called when processing a push ends, as the app may be suspended before the flush timer fires.
+    public func flush() {
         isolationQueue.sync {
-            var currentAttributes = analytics?.persistedAttributes(for: eventName) ?? [:]
-            var value = (currentAttributes[attribute.identifier] as? Double) ?? 0
-            value += amount
-            currentAttributes[attribute.identifier] = value as NSObject
-            analytics?.setPersistedAttributes(currentAttributes, for: eventName)
+            flushCounters()
+        }
+    }
+
+    /// Must be called on the isolation queue
+    private func flushCounters() {
+        let counts = counters.drain()
+
+        guard !counts.isEmpty, let analytics = analytics else { return }
+
+        var currentAttributes = analytics.persistedAttributes(for: eventName) ?? [:]
+
+        for (attribute, amount) in counts {
+            let value = (currentAttributes[attribute.identifier] as? Double) ?? 0
+            currentAttributes[attribute.identifier] = (value + Double(amount)) as NSObject
         }
+
+        analytics.setPersistedAttributes(currentAttributes, for: eventName)
     }
 
     public func dispatchEvent() {
         isolationQueue.sync {
+            flushCounters()
+
             if let analytics = analytics, let attributes = analytics.persistedAttributes(for: eventName), !attributes.isEmpty {
                 analytics.tagEvent(eventName, attributes: attributes)
                 analytics.setPersistedAttributes(nil, for: eventName)
@@ -93,6 +125,6 @@ import WireDataModel
 
 extension NotificationsTracker {
     override public var debugDescription: String {
-        return "Current values: \(analytics?.persistedAttributes(for: eventName) ?? [:])"
+        return "Current values: \(analytics?.persistedAttributes(for: eventName) ?? [:]), pending: \(counters.pendingCounts)"
     }
 }
@@ -0,0 +1,212 @@
+//
+// Wire
+// Copyright (C) 2022 Wire Swiss GmbH
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see http://www.gnu.org/licenses/.
+//
+
+import Foundation
+
+private let zmLog = ZMSLog(tag: "calling")
+
+/// Collects the call events received before AVS is ready, and drops the ones
+/// which AVS doesn't need anymore when they're forwarded.
+///
+/// - Duplicates of an event which is already buffered are dropped.
+/// - Events which were older than the call timeout when they were received are dropped,
+///   except for the event which started the call, which AVS needs to report a missed call.
+/// - Later starts of a call session which was started already are dropped.
+/// - When a call session was ended by an event in the buffer, only its first start and
+///   its last end are forwarded, so that AVS never rings for a call which was cancelled.
+/// - When the buffer is full, the oldest events are dropped.
+///
+/// The completion handler of dropped events is called right away.
+struct CallEventBuffer {
+
+    typealias Item = (event: CallEvent, completionHandler: () -> Void)
+
+    /// Counted since the buffer was created or the statistics were last reset
+    struct Statistics: Equatable {
+        /// Number of events added to the buffer
+        var bufferedCount = 0
+        /// Number of events dropped because they were buffered already
+        var deduplicatedCount = 0
+        /// Number of events dropped because they were too old or superseded
+        var prunedCount = 0
+        /// Number of events dropped because the buffer was full
+        var overflowCount = 0
+        /// Number of events forwarded to AVS
+        var forwardedCount = 0
+    }
+
+    /// The subset of an AVS calling message needed to decide whether it can be dropped
+    struct Message: Decodable, Equatable {
+
+        let type: String
+        let sessionId: String?
+        let isResponse: Bool
+
+        enum CodingKeys: String, CodingKey {
+            case type
+            case sessionId = "sessid"
+            case isResponse = "resp"
+        }
+
+        init(from decoder: Decoder) throws {
+            let container = try decoder.container(keyedBy: CodingKeys.self)
+            type = try container.decode(String.self, forKey: .type)
+            sessionId = try container.decodeIfPresent(String.self, forKey: .sessionId)
+            isResponse = try container.decodeIfPresent(Bool.self, forKey: .isResponse) ?? false
+        }
+
+        /// Whether the message starts a call
+        var isCallStart: Bool {
+            return !isResponse && ["SETUP", "GROUPSTART", "CONFSTART"].contains(type)
+        }
+
+        /// Whether the message ends the call session it belongs to
+        var isCallEnd: Bool {
+            return ["CANCEL", "HANGUP", "REJECT", "GROUPEND", "CONFEND"].contains(type)
+        }
+
+    }
+
+    /// Identifies duplicates of a call event
+    private struct EventKey: Hashable {
+        let conversationId: AVSIdentifier
+        let userId: AVSIdentifier
+        let clientId: String
+        let serverTimestamp: Date
+        let data: Data
+
+        init(_ event: CallEvent) {
+            conversationId = event.conversationId
+            userId = event.userId
+            clientId = event.clientId
+            serverTimestamp = event.serverTimestamp
+            data = event.data
+        }
+    }
+
+    private struct Entry {
+        let item: Item
+        let message: Message?
+
+        var sessionKey: String? {
+            guard let sessionId = message?.sessionId else { return nil }
+            return "\(item.event.conversationId.serialized)/\(sessionId)"
+        }
+
+        /// Whether AVS considers the event as expired, it compares the same timestamps
+        var isStale: Bool {
+            return item.event.currentTimestamp.timeIntervalSince(item.event.serverTimestamp) > CallEventBuffer.callTimeout
+        }
+    }
+
+    /// Events older than this have no effect on ongoing calls anymore
+    static let callTimeout: TimeInterval = 60
+
+    static let defaultMaxCount = 500
+
+    let maxCount: Int
+    private(set) var statistics = Statistics()
+    private var entries = [Entry]()
+    private var eventKeys = Set<EventKey>()
+    private let decoder = JSONDecoder()
+
+    init(maxCount: Int = defaultMaxCount) {
+        self.maxCount = maxCount
+    }
+
+    var count: Int {
+        return entries.count
+    }
+
+    mutating func resetStatistics() {
+        statistics = Statistics()
+    }
+
+    mutating func append(_ event: CallEvent, completionHandler: @escaping () -> Void) {
+        guard eventKeys.insert(EventKey(event)).inserted else {
+            statistics.deduplicatedCount += 1
+            completionHandler()
+            return
+        }
+
+        statistics.bufferedCount += 1
+        entries.append(Entry(item: (event, completionHandler),
+                             message: try? decoder.decode(Message.self, from: event.data)))
+
+        if entries.count > maxCount {
+            dropOldestEntry()
+        }
+    }
+
+    /// Removes all events from the buffer.
+    /// - returns: the events which should be forwarded to AVS, in the order they were received
+    mutating func flush() -> [Item] {
+        defer {
+            entries.removeAll()
+            eventKeys.removeAll()
+        }
+
+        // Index of the last event which ended each session
+        var sessionEnds = [String: Int]()
+        for (index, entry) in entries.enumerated() where entry.message?.isCallEnd == true {
+            entry.sessionKey.map { sessionEnds[$0] = index }
+        }
+
+        var startedSessions = Set<String>()
+        var items = [Item]()
+
+        for (index, entry) in entries.enumerated() {
+            guard let message = entry.message else {
+                // Events we can't interpret are always forwarded
+                items.append(entry.item)
+                continue
+            }
+
+            let sessionEnd = entry.sessionKey.flatMap { sessionEnds[$0] }
+            let isSessionStart = message.isCallStart && entry.sessionKey.map { startedSessions.insert($0).inserted } != false
+            let isSessionEnd = sessionEnd == index
+            let isSuperseded = message.isCallStart ? !isSessionStart : sessionEnd.map { index < $0 } ?? false
+
+            if isSessionStart || isSessionEnd || (!entry.isStale && !isSuperseded) {
+                items.append(entry.item)
+            } else {
+                statistics.prunedCount += 1
+                entry.item.completionHandler()
+            }
+        }
+
+        statistics.forwardedCount += items.count
+
+        if items.count < entries.count {
+            zmLog.info("Forwarding \(items.count) of \(entries.count) buffered call events")
+        }
+
+        return items
+    }
+
+    private mutating func dropOldestEntry() {
+        // Keep call starts as long as possible, AVS needs them to report missed calls
+        let index = entries.firstIndex { $0.message?.isCallStart != true } ?? entries.startIndex
+        let entry = entries.remove(at: index)
+
+        eventKeys.remove(EventKey(entry.item.event))
+        statistics.overflowCount += 1
+        entry.item.completionHandler()
+    }
+
+}
@@ -396,6 +396,7 @@ public class CallKitManager: NSObject, CallKitManagerInterface {
         hasVideo: Bool
     ) {
         Self.logger.trace("report incoming call preemptively")
+        CallSetupTracer.tracer(forAccount: handle.accountID).stamp(.incomingCallReported, conversationId: handle.conversationID)
 
         guard !callRegister.callExists(for: handle) else {
             Self.logger.critical("fail: report incoming call preemptively: call doesn't exist")
@@ -487,6 +488,7 @@ public class CallKitManager: NSObject, CallKitManagerInterface {
 
         let call = callRegister.registerNewCall(with: handle)
 
+        CallSetupTracer.tracer(forAccount: handle.accountID).stamp(.incomingCallReported, conversationId: handle.conversationID)
         log("provider.reportNewIncomingCall")
 
         provider.reportNewIncomingCall(
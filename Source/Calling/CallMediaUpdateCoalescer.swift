@@ -0,0 +1,174 @@
+//
+// Wire
+// Copyright (C) 2022 Wire Swiss GmbH
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see http://www.gnu.org/licenses/.
+//
+
+import Foundation
+
+/// Media related changes of a call reported by AVS, which can be merged
+/// with later changes of the same call.
+struct CallMediaUpdate {
+
+    /// The latest audio levels, `nil` if they didn't change
+    var activeSpeakers: [AVSActiveSpeakersChange.ActiveSpeaker]?
+
+    /// The latest network quality of each client which reported a change
+    var networkQualityByClient: [AVSClient: NetworkQuality] = [:]
+
+    /// The latest network quality of the call, `nil` if it didn't change
+    var networkQuality: NetworkQuality?
+
+    var isEmpty: Bool {
+        return activeSpeakers == nil && networkQualityByClient.isEmpty && networkQuality == nil
+    }
+
+    /// Applies a later update on top of this one
+    mutating func merge(_ update: CallMediaUpdate) {
+        activeSpeakers = update.activeSpeakers ?? activeSpeakers
+        networkQualityByClient.merge(update.networkQualityByClient) { _, new in new }
+        networkQuality = update.networkQuality ?? networkQuality
+    }
+
+}
+
+/// Counts the media updates reported by AVS and the notifications posted for them
+/// since the call center was created.
+public struct CallMediaUpdateStatistics: Equatable {
+    /// Number of active speaker changes received from AVS
+    public internal(set) var activeSpeakersChangesReceived = 0
+    /// Number of active speaker notifications posted to observers
+    public internal(set) var activeSpeakersNotificationsPosted = 0
+    /// Number of network quality changes received from AVS
+    public internal(set) var networkQualityChangesReceived = 0
+    /// Number of network quality notifications posted to observers
+    public internal(set) var networkQualityNotificationsPosted = 0
+}
+
+/// Rate limits the media updates of each call, which AVS reports many times
+/// per second in large calls.
+///
+/// The first update of a call is delivered right away and opens a frame. Updates
+/// arriving while the frame is open are merged and delivered together when it closes.
+///
+/// Must be used from the queue of the context passed to `add(_:for:in:)`.
+final class CallMediaUpdateCoalescer {
+
+    typealias Handler = (AVSIdentifier, CallMediaUpdate) -> Void
+
+    /// Runs a block after a delay
+    typealias Scheduler = (TimeInterval, @escaping () -> Void) -> Void
+
+    static let defaultFrameInterval: TimeInterval = 0.1
+
+    /// Minimum time between two deliveries for the same call, updates are
+    /// delivered immediately when it's zero
+    var frameInterval: TimeInterval
+
+    var statistics = CallMediaUpdateStatistics()
+
+    /// Schedules the end of the frames, on the main queue by default
+    var scheduler: Scheduler
+
+    /// Queue on which AVS payloads are decoded
+    let decodingQueue = DispatchQueue(label: "CallMediaUpdateCoalescer.decoding", qos: .userInitiated)
+
+    /// Decoder which must only be used on the decoding queue
+    let decoder = JSONDecoder()
+
+    /// Called with the updates to apply
+    var handler: Handler?
+
+    private var pendingUpdates = [AVSIdentifier: CallMediaUpdate]()
+    private var openFrames = Set<AVSIdentifier>()
+
+    init(frameInterval: TimeInterval = defaultFrameInterval,
+         scheduler: @escaping Scheduler = { DispatchQueue.main.asyncAfter(deadline: .now() + $0, execute: $1) }) {
+        self.frameInterval = frameInterval
+        self.scheduler = scheduler
+    }
+
+    func add(_ update: CallMediaUpdate, for conversationId: AVSIdentifier, in context: NSManagedObjectContext) {
+        if update.activeSpeakers != nil {
+            statistics.activeSpeakersChangesReceived += 1
+        }
+
+        if update.networkQuality != nil || !update.networkQualityByClient.isEmpty {
+            statistics.networkQualityChangesReceived += 1
+        }
+
+        guard frameInterval > 0 else {
+            handler?(conversationId, update)
+            return
+        }
+
+        guard !openFrames.contains(conversationId) else {
+            pendingUpdates[conversationId, default: CallMediaUpdate()].merge(update)
+            return
+        }
+
+        handler?(conversationId, update)
+        openFrame(for: conversationId, in: context)
+    }
+
+    /// Drops the pending updates of a call which ended
+    func discardUpdates(for conversationId: AVSIdentifier) {
+        pendingUpdates.removeValue(forKey: conversationId)
+        openFrames.remove(conversationId)
+    }
+
+    private func openFrame(for conversationId: AVSIdentifier, in context: NSManagedObjectContext) {
+        openFrames.insert(conversationId)
+
+        scheduler(frameInterval) { [weak self, weak context] in
+            context?.performGroupedBlock {
+                self?.closeFrame(for: conversationId, in: context)
+            }
+        }
+    }
+
+    private func closeFrame(for conversationId: AVSIdentifier, in context: NSManagedObjectContext?) {
+        guard openFrames.remove(conversationId) != nil else { return }
+
+        guard
+            let update = pendingUpdates.removeValue(forKey: conversationId),
+            !update.isEmpty,
+            let context = context
+        else {
+            return
+        }
+
+        handler?(conversationId, update)
+        openFrame(for: conversationId, in: context)
+    }
+
+}
+
+extension Array where Element == AVSActiveSpeakersChange.ActiveSpeaker {
+
+    /// Whether both lists rank the same clients in the same order, with the same speaking
+    /// state. The magnitude of the audio levels is ignored.
+    func hasSameRanking(as other: [AVSActiveSpeakersChange.ActiveSpeaker]) -> Bool {
+        guard count == other.count else { return false }
+
+        return zip(self, other).allSatisfy { lhs, rhs in
+            lhs.userId == rhs.userId &&
+            lhs.clientId == rhs.clientId &&
+            (lhs.audioLevel > 0) == (rhs.audioLevel > 0) &&
+            (lhs.audioLevelNow > 0) == (rhs.audioLevelNow > 0)
+        }
+    }
+
+}
@@ -26,28 +26,30 @@ class CallParticipantsSnapshot {
     private unowned var callCenter: WireCallCenterV3
     private let conversationId: AVSIdentifier
 
-    private(set) var members: OrderedSetState<AVSCallMember> {
-        didSet {
-            guard let moc = callCenter.uiMOC else { return }
+    /// Members in AVS order, with the index of each client for constant time updates.
+    private var memberList: [AVSCallMember]
+    private var memberIndexes: [AVSClient: Int]
 
-            participants = members
-                .map { CallParticipant(member: $0, context: moc) }
-                .compactMap(\.self)
-        }
+    var members: OrderedSetState<AVSCallMember> {
+        return memberList.toOrderedSetState()
     }
 
-    private var participants = [CallParticipant]() {
-        didSet {
-            updateUserVerifiedMap()
-            notifyChange()
-        }
-    }
+    private var participants = [CallParticipant]()
+
+    /// Participants created for the current members, reused as long as the member doesn't change.
+    private var participantCache = [AVSClient: (member: AVSCallMember, participant: CallParticipant)]()
+    private var userCache = [AVSIdentifier: ZMUser]()
 
     private var userVerifiedMap = [ZMUser: Bool]()
 
     private func updateUserVerifiedMap() {
+        var checkedUsers = Set<ZMUser>()
+
         for user in participants.map(\.user) {
             let zmuser = user as! ZMUser
+
+            guard checkedUsers.insert(zmuser).inserted else { continue }
+
             let userWasVerified = userVerifiedMap[zmuser] ?? false
             let userIsVerified = zmuser.isVerified
 
@@ -70,10 +72,9 @@ class CallParticipantsSnapshot {
     /// Worst network quality of all the participants.
 
     var networkQuality: NetworkQuality {
-        return members.array
+        return memberList
             .map(\.networkQuality)
-            .sorted { $0.rawValue < $1.rawValue }
-            .last ?? .normal
+            .max { $0.rawValue < $1.rawValue } ?? .normal
     }
 
     // MARK: - Life Cycle
@@ -81,43 +82,80 @@ class CallParticipantsSnapshot {
     init(conversationId: AVSIdentifier, members: [AVSCallMember], callCenter: WireCallCenterV3) {
         self.callCenter = callCenter
         self.conversationId = conversationId
-        self.members = type(of: self).removeDuplicateMembers(members)
+        self.memberList = type(of: self).removeDuplicateMembers(members)
+        self.memberIndexes = type(of: self).indexes(of: memberList)
     }
 
     // MARK: - Updates
 
     func callParticipantsChanged(participants: [AVSCallMember]) {
-        members = type(of: self).removeDuplicateMembers(participants)
+        memberList = type(of: self).removeDuplicateMembers(participants)
+        memberIndexes = type(of: self).indexes(of: memberList)
+        participantCache = participantCache.filter { memberIndexes[$0.key] != nil }
+        updateParticipants()
     }
 
     func callParticipantNetworkQualityChanged(client: AVSClient, networkQuality: NetworkQuality) {
-        guard let localMember = findMember(with: client) else { return }
+        guard let index = memberIndexes[client] else { return }
 
-        let updatedMember = AVSCallMember(client: client,
+        let localMember = memberList[index]
+
+        memberList[index] = AVSCallMember(client: client,
                                           audioState: localMember.audioState,
                                           videoState: localMember.videoState,
                                           microphoneState: localMember.microphoneState,
                                           networkQuality: networkQuality)
 
-        members = OrderedSetState(array: members.array.map({ member in
-            member == localMember ? updatedMember : member
-        }))
+        // The network quality is not part of the participant, so there is no need to
+        // re-create participants nor to notify participant observers.
     }
 
     // MARK: - Helpers
 
-    /// Returns the member matching the given userId and clientId.
+    /// Re-creates participants for members that changed, and notifies observers of the differences.
+
+    private func updateParticipants() {
+        guard let moc = callCenter.uiMOC else { return }
 
-    private func findMember(with client: AVSClient) -> AVSCallMember? {
-        return members.array.first { $0.client == client }
+        let updatedParticipants = memberList.compactMap { participant(for: $0, in: moc) }
+        let changes = CallParticipantsChangeSet(from: participants, to: updatedParticipants)
+
+        participants = updatedParticipants
+        updateUserVerifiedMap()
+
+        if !changes.isEmpty {
+            notifyChange(changes)
+        }
     }
 
-    /// Notifies observers of a potential change in the participants set.
+    private func participant(for member: AVSCallMember, in context: NSManagedObjectContext) -> CallParticipant? {
+        if let cached = participantCache[member.client], cached.member.hasSameState(as: member) {
+            return cached.participant
+        }
+
+        let userId = member.client.avsIdentifier
+        let user = userCache[userId] ?? ZMUser.fetch(with: userId.identifier, domain: userId.domain, in: context)
 
-    private func notifyChange() {
+        guard let existingUser = user else { return nil }
+
+        userCache[userId] = existingUser
+
+        let participant = CallParticipant(user: existingUser,
+                                          userId: userId,
+                                          clientId: member.client.clientId,
+                                          state: member.callParticipantState,
+                                          activeSpeakerState: .inactive)
+        participantCache[member.client] = (member, participant)
+
+        return participant
+    }
+
+    /// Notifies observers of a change in the participants set.
+
+    private func notifyChange(_ changes: CallParticipantsChangeSet) {
         guard let context = callCenter.uiMOC else { return }
 
-        WireCallCenterCallParticipantNotification(conversationId: conversationId, participants: participants)
+        WireCallCenterCallParticipantNotification(conversationId: conversationId, participants: participants, changes: changes)
             .post(in: context.notificationContext)
     }
 
@@ -126,11 +164,147 @@ class CallParticipantsSnapshot {
 extension CallParticipantsSnapshot {
 
     // Remove duplicates see: https://wearezeta.atlassian.net/browse/ZIOS-8610
-    private static func removeDuplicateMembers(_ members: [AVSCallMember]) -> OrderedSetState<AVSCallMember> {
-        let callMembers = members.reduce([AVSCallMember]()) { (filtered, member) in
-            filtered + (filtered.contains(member) ? [] : [member])
+    private static func removeDuplicateMembers(_ members: [AVSCallMember]) -> [AVSCallMember] {
+        var clients = Set<AVSClient>()
+        clients.reserveCapacity(members.count)
+
+        return members.filter { clients.insert($0.client).inserted }
+    }
+
+    private static func indexes(of members: [AVSCallMember]) -> [AVSClient: Int] {
+        var indexes = [AVSClient: Int](minimumCapacity: members.count)
+
+        for (index, member) in members.enumerated() {
+            indexes[member.client] = index
+        }
+
+        return indexes
+    }
+}
+
+private extension AVSCallMember {
+
+    /// `==` only compares clients, this compares all the states of the member.
+    func hasSameState(as other: AVSCallMember) -> Bool {
+        return client == other.client &&
+            audioState == other.audioState &&
+            videoState == other.videoState &&
+            microphoneState == other.microphoneState &&
+            networkQuality == other.networkQuality
+    }
+
+}
+
+// MARK: - Change set
+
+/// Differences between two lists of call participants, identified by user and client.
+public struct CallParticipantsChangeSet: Equatable {
+
+    public struct Move: Equatable {
+        public let from: Int
+        public let to: Int
+    }
+
+    /// Indexes of removed participants, relative to the previous list
+    public let deletedIndexes: IndexSet
+    /// Indexes of added participants, relative to the new list
+    public let insertedIndexes: IndexSet
+    /// Indexes of participants whose state changed, relative to the new list.
+    /// Moved participants are not included, their new state is found at the destination of the move.
+    public let updatedIndexes: IndexSet
+    /// Participants which changed position relative to the other remaining participants.
+    /// The participants which keep their relative order are the longest such sequence,
+    /// so that as few participants as possible are moved.
+    public let movedIndexes: [Move]
+
+    public var isEmpty: Bool {
+        return deletedIndexes.isEmpty && insertedIndexes.isEmpty && updatedIndexes.isEmpty && movedIndexes.isEmpty
+    }
+
+    init(from old: [CallParticipant], to new: [CallParticipant]) {
+        let oldIndexes = Self.indexes(of: old)
+        let newIndexes = Self.indexes(of: new)
+
+        deletedIndexes = IndexSet(old.indices.filter { newIndexes[Self.key(old[$0])] == nil })
+        insertedIndexes = IndexSet(new.indices.filter { oldIndexes[Self.key(new[$0])] == nil })
+
+        // participants present in both lists, in their new order
+        let remaining: [(from: Int, to: Int)] = new.indices.compactMap { newIndex in
+            oldIndexes[Self.key(new[newIndex])].map { (from: $0, to: newIndex) }
+        }
+        let unmoved = Self.longestIncreasingSubsequence(of: remaining.map(\.from))
+
+        var moves = [Move]()
+        var updates = IndexSet()
+
+        for (position, indexes) in remaining.enumerated() {
+            if !unmoved.contains(position) {
+                moves.append(Move(from: indexes.from, to: indexes.to))
+            } else if old[indexes.from].state != new[indexes.to].state {
+                updates.insert(indexes.to)
+            }
         }
 
-        return callMembers.toOrderedSetState()
+        movedIndexes = moves
+        updatedIndexes = updates
     }
+
+    /// Returns the positions of the elements forming the longest strictly increasing subsequence
+    private static func longestIncreasingSubsequence(of values: [Int]) -> IndexSet {
+        // positions of the last element of the best subsequence of each length
+        var tails = [Int]()
+        var predecessors = [Int?](repeating: nil, count: values.count)
+
+        for (position, value) in values.enumerated() {
+            var lowerBound = 0
+            var upperBound = tails.count
+
+            while lowerBound < upperBound {
+                let middle = (lowerBound + upperBound) / 2
+                if values[tails[middle]] < value {
+                    lowerBound = middle + 1
+                } else {
+                    upperBound = middle
+                }
+            }
+
+            predecessors[position] = lowerBound > 0 ? tails[lowerBound - 1] : nil
+
+            if lowerBound == tails.count {
+                tails.append(position)
+            } else {
+                tails[lowerBound] = position
+            }
+        }
+
+        var subsequence = IndexSet()
+        var position = tails.last
+
+        while let current = position {
+            subsequence.insert(current)
+            position = predecessors[current]
+        }
+
+        return subsequence
+    }
+
+    private struct Key: Hashable {
+        let userId: AVSIdentifier
+        let clientId: String
+    }
+
+    private static func key(_ participant: CallParticipant) -> Key {
+        return Key(userId: participant.userId, clientId: participant.clientId)
+    }
+
+    private static func indexes(of participants: [CallParticipant]) -> [Key: Int] {
+        var indexes = [Key: Int](minimumCapacity: participants.count)
+
+        for (index, participant) in participants.enumerated() {
+            indexes[key(participant)] = index
+        }
+
+        return indexes
+    }
+
 }
@@ -0,0 +1,277 @@
+//
+// Wire
+// Copyright (C) 2022 Wire Swiss GmbH
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see http://www.gnu.org/licenses/.
+//
+
+import Foundation
+
+private let zmLog = ZMSLog(tag: "calling")
+
+/// Records when a call passes each step of its setup, from the push notification
+/// to the call being established, and aggregates the time spent between the steps.
+///
+/// A trace starts when an incoming call is first noticed, by a push, CallKit or AVS, and ends
+/// when the call is established, or is discarded when the call ends before. Stamps for a
+/// conversation without an incoming call being set up are dropped, so that the events of an
+/// established call, like every participant of a group call being established, don't start new
+/// traces. Only the first stamp of each stage counts. Stamps can be made from any thread.
+///
+/// There is one tracer per account, like CallKit, calls are identified by the account and the conversation.
+public final class CallSetupTracer {
+
+    public enum Stage: Int, CaseIterable, Codable {
+        /// A VoIP push for the call was received
+        case pushReceived
+        /// A calling message was received and scheduled for processing
+        case callEventScheduled
+        /// The calling message was passed to AVS
+        case callEventForwarded
+        /// AVS reported the incoming call
+        case incomingCallHandled
+        /// The call was reported to CallKit
+        case incomingCallReported
+        /// The user answered the call
+        case answered
+        /// The data channel was established
+        case dataChannelEstablished
+        /// Media is flowing
+        case established
+
+        var name: String {
+            return String(describing: self)
+        }
+
+        /// Whether the stage can start the trace of an incoming call
+        var startsTrace: Bool {
+            switch self {
+            case .pushReceived, .incomingCallReported, .incomingCallHandled:
+                return true
+            default:
+                return false
+            }
+        }
+    }
+
+    /// Durations in milliseconds, bucketed by upper bound
+    public struct Histogram: Equatable, Codable {
+
+        public static let bucketBounds: [UInt64] = [10, 50, 100, 250, 500, 1000, 2500, 5000, 10000]
+
+        /// Counts per bucket, the last bucket counts durations above the highest bound
+        public private(set) var bucketCounts = [Int](repeating: 0, count: bucketBounds.count + 1)
+        public private(set) var count = 0
+        public private(set) var totalMilliseconds: UInt64 = 0
+
+        public var averageMilliseconds: Double {
+            return count == 0 ? 0 : Double(totalMilliseconds) / Double(count)
+        }
+
+        mutating func record(milliseconds: UInt64) {
+            let bucket = Self.bucketBounds.firstIndex { milliseconds <= $0 } ?? Self.bucketBounds.count
+            bucketCounts[bucket] += 1
+            count += 1
+            totalMilliseconds += milliseconds
+        }
+    }
+
+    /// The time between two consecutive stages of a trace
+    public struct Step: Hashable, Codable {
+        public let from: Stage
+        public let to: Stage
+    }
+
+    struct Trace {
+        let callNumber: Int
+        var stamps: [Stage: UInt64] = [:]
+        let startTime: UInt64
+    }
+
+    /// The call of a conversation, from the start of its trace until it ends
+    enum Call {
+        case settingUp(Trace)
+        case established
+    }
+
+    typealias Clock = () -> UInt64
+
+    private static var tracersByAccount = [UUID: CallSetupTracer]()
+    private static let tracersQueue = DispatchQueue(label: "CallSetupTracer.tracers")
+
+    /// The tracer of the account, used by the push handling, CallKit and the call center of the account
+    public static func tracer(forAccount accountID: UUID) -> CallSetupTracer {
+        return tracersQueue.sync {
+            if let tracer = tracersByAccount[accountID] {
+                return tracer
+            }
+
+            let tracer = CallSetupTracer()
+            tracersByAccount[accountID] = tracer
+            return tracer
+        }
+    }
+
+    /// Traces which didn't complete within this time are discarded
+    static let traceTimeout: UInt64 = 120 * NSEC_PER_SEC
+
+    private let clock: Clock
+    private let isolationQueue = DispatchQueue(label: "CallSetupTracer")
+    private var calls = [UUID: Call]()
+    private var callCount = 0
+    private var histogramsByStep = [Step: Histogram]()
+    private var setupHistogram = Histogram()
+
+    /// - parameter clock: returns a monotonic time in nanoseconds
+    init(clock: @escaping Clock = { DispatchTime.now().uptimeNanoseconds }) {
+        self.clock = clock
+    }
+
+    // MARK: - Stamping
+
+    /// Records that the call in the conversation reached the stage
+    public func stamp(_ stage: Stage, conversationId: UUID) {
+        let time = clock()
+
+        isolationQueue.async {
+            self.discardExpiredTraces(at: time)
+
+            var trace: Trace
+
+            switch self.calls[conversationId] {
+            case .settingUp(let openTrace):
+                trace = openTrace
+            case .established:
+                return
+            case nil:
+                guard stage.startsTrace else { return }
+                self.callCount += 1
+                trace = Trace(callNumber: self.callCount, startTime: time)
+            }
+
+            if trace.stamps[stage] == nil {
+                trace.stamps[stage] = time
+            }
+
+            if stage == .established {
+                self.calls[conversationId] = .established
+                self.record(trace)
+            } else {
+                self.calls[conversationId] = .settingUp(trace)
+            }
+        }
+    }
+
+    /// Ends the call in the conversation, discarding its trace if it wasn't established
+    public func discardTrace(conversationId: UUID) {
+        isolationQueue.async {
+            self.calls.removeValue(forKey: conversationId)
+        }
+    }
+
+    // MARK: - Results
+
+    /// Histograms of the time between consecutive stages of established calls
+    public var stepHistograms: [Step: Histogram] {
+        return isolationQueue.sync { histogramsByStep }
+    }
+
+    /// Histogram of the time from the first stamp until the call was established
+    public var totalHistogram: Histogram {
+        return isolationQueue.sync { setupHistogram }
+    }
+
+    /// JSON description of the histograms and open traces, for debug reports
+    public func debugExport() -> String {
+        return isolationQueue.sync {
+            let now = clock()
+
+            let export: [String: Any] = [
+                "bucket_bounds_ms": Histogram.bucketBounds,
+                "total": setupHistogram.exportValue,
+                "steps": histogramsByStep
+                    .sorted { ($0.key.from.rawValue, $0.key.to.rawValue) < ($1.key.from.rawValue, $1.key.to.rawValue) }
+                    .map { ["from": $0.key.from.name, "to": $0.key.to.name, "histogram": $0.value.exportValue] as [String: Any] },
+                "open_traces": openTraces.map { trace -> [String: Any] in
+                    [
+                        "call": trace.callNumber,
+                        "age_ms": Self.milliseconds(from: trace.startTime, to: now),
+                        "stages": trace.stamps.keys.sorted { $0.rawValue < $1.rawValue }.map(\.name)
+                    ]
+                }
+            ]
+
+            guard
+                let data = try? JSONSerialization.data(withJSONObject: export, options: [.prettyPrinted, .sortedKeys]),
+                let string = String(data: data, encoding: .utf8)
+            else {
+                return "{}"
+            }
+
+            return string
+        }
+    }
+
+    // MARK: - Private
+
+    /// Must be called on the isolation queue
+    private func record(_ trace: Trace) {
+        // The stages aren't always reached in the same order, e.g. CallKit is told about a call from a push before the calling message arrives
+        let stamps = trace.stamps.sorted { ($0.value, $0.key.rawValue) < ($1.value, $1.key.rawValue) }
+
+        for (previous, next) in zip(stamps, stamps.dropFirst()) {
+            let step = Step(from: previous.key, to: next.key)
+            histogramsByStep[step, default: Histogram()].record(milliseconds: Self.milliseconds(from: previous.value, to: next.value))
+        }
+
+        if let first = stamps.first, let last = stamps.last {
+            let total = Self.milliseconds(from: first.value, to: last.value)
+            setupHistogram.record(milliseconds: total)
+            zmLog.info("Call setup took \(total) ms, stages: \(stamps.map(\.key.name))")
+        }
+    }
+
+    /// Must be called on the isolation queue
+    private var openTraces: [Trace] {
+        return calls.values.compactMap {
+            guard case .settingUp(let trace) = $0 else { return nil }
+            return trace
+        }
+    }
+
+    /// Must be called on the isolation queue
+    private func discardExpiredTraces(at time: UInt64) {
+        calls = calls.filter {
+            guard case .settingUp(let trace) = $0.value else { return true }
+            return time < trace.startTime + Self.traceTimeout
+        }
+    }
+
+    private static func milliseconds(from start: UInt64, to end: UInt64) -> UInt64 {
+        return end > start ? (end - start) / NSEC_PER_MSEC : 0
+    }
+
+}
+
+private extension CallSetupTracer.Histogram {
+
+    var exportValue: [String: Any] {
+        return [
+            "count": count,
+            "average_ms": averageMilliseconds,
+            "buckets": bucketCounts
+        ]
+    }
+
+}
@@ -106,6 +106,8 @@ extension WireCallCenterV3 {
 
     /// Handles incoming calls.
     func handleIncomingCall(conversationId: AVSIdentifier, messageTime: Date, client: AVSClient, isVideoCall: Bool, shouldRing: Bool, conversationType: AVSConversationType) {
+        callSetupTracer.stamp(.incomingCallHandled, conversationId: conversationId.identifier)
+
         handleEvent("incoming-call") {
             let isDegraded = self.isDegraded(conversationId: conversationId)
             let callState = CallState.incoming(video: isVideoCall, shouldRing: shouldRing, degraded: isDegraded)
@@ -134,6 +136,8 @@ extension WireCallCenterV3 {
 
     /// Handles when data channel gets established.
     func handleDataChannelEstablishement(conversationId: AVSIdentifier) {
+        callSetupTracer.stamp(.dataChannelEstablished, conversationId: conversationId.identifier)
+
         handleEvent("data-channel-established") {
             // Ignore if data channel was established after audio
             if self.callState(conversationId: conversationId) != .established {
@@ -144,6 +148,8 @@ extension WireCallCenterV3 {
 
     /// Handles established calls.
     func handleEstablishedCall(conversationId: AVSIdentifier) {
+        callSetupTracer.stamp(.established, conversationId: conversationId.identifier)
+
         handleEvent("established-call") {
             // WORKAROUND: the call established handler is called once for every participant in a
             // group call. Until that's no longer the case we must take care to only set establishedDate once.
@@ -289,20 +295,13 @@ extension WireCallCenterV3 {
     /// Handles network quality change
     func handleNetworkQualityChange(conversationId: AVSIdentifier, userId: String, clientId: String, quality: NetworkQuality) {
         handleEventInContext("network-quality-change") {
+            var update = CallMediaUpdate(networkQuality: quality)
+
             if let identifier = AVSIdentifier(string: userId) {
-                self.callParticipantNetworkQualityChanged(
-                    conversationId: conversationId,
-                    client: AVSClient(userId: identifier, clientId: clientId),
-                    quality: quality
-                )
+                update.networkQualityByClient[AVSClient(userId: identifier, clientId: clientId)] = quality
             }
 
-            if let call = self.callSnapshots[conversationId] {
-                self.callSnapshots[conversationId] = call.updateNetworkQuality(quality)
-                let notification = WireCallCenterNetworkQualityNotification(conversationId: conversationId,
-                                                                            networkQuality: quality)
-                notification.post(in: $0.notificationContext)
-            }
+            self.mediaUpdateCoalescer.add(update, for: conversationId, in: $0)
         }
     }
 
@@ -333,7 +332,18 @@ extension WireCallCenterV3 {
     }
 
     func handleActiveSpeakersChange(conversationId: AVSIdentifier, data: String) {
-        handleEventInContext("active-speakers-change") {
+        guard let context = uiMOC else {
+            zmLog.error("Cannot handle event 'active-speakers-change' because the UI context is not available.")
+            return
+        }
+
+        // Decoding happens off the UI context since AVS reports audio levels many times per second
+        let dispatchGroup = context.dispatchGroup
+        dispatchGroup?.enter()
+
+        mediaUpdateCoalescer.decodingQueue.async { [decoder = mediaUpdateCoalescer.decoder] in
+            defer { dispatchGroup?.leave() }
+
             guard let data = data.data(using: .utf8) else {
                 zmLog.safePublic("Invalid active speakers data")
                 return
@@ -352,10 +362,11 @@ extension WireCallCenterV3 {
             // }
 
             do {
-                let change = try self.decoder.decode(AVSActiveSpeakersChange.self, from: data)
-                if let call = self.callSnapshots[conversationId] {
-                    self.callSnapshots[conversationId] = call.updateActiveSpeakers(change.activeSpeakers)
-                    WireCallCenterActiveSpeakersNotification().post(in: $0.notificationContext)
+                let change = try decoder.decode(AVSActiveSpeakersChange.self, from: data)
+                context.performGroupedBlock {
+                    self.mediaUpdateCoalescer.add(CallMediaUpdate(activeSpeakers: change.activeSpeakers),
+                                                  for: conversationId,
+                                                  in: context)
                 }
             } catch {
                 zmLog.safePublic("Cannot decode active speakers change JSON")
@@ -364,6 +375,41 @@ extension WireCallCenterV3 {
     }
 }
 
+// MARK: - Media Updates
+
+extension WireCallCenterV3 {
+
+    /// Applies coalesced media updates to the call and notifies observers when the
+    /// network quality or the ranking of the active speakers changed.
+    func applyMediaUpdate(_ update: CallMediaUpdate, conversationId: AVSIdentifier) {
+        guard let context = uiMOC else { return }
+
+        for (client, quality) in update.networkQualityByClient {
+            callParticipantNetworkQualityChanged(conversationId: conversationId, client: client, quality: quality)
+        }
+
+        if let quality = update.networkQuality,
+           let call = callSnapshots[conversationId],
+           call.networkQuality != quality {
+            callSnapshots[conversationId] = call.updateNetworkQuality(quality)
+            WireCallCenterNetworkQualityNotification(conversationId: conversationId, networkQuality: quality).post(in: context.notificationContext)
+            mediaUpdateCoalescer.statistics.networkQualityNotificationsPosted += 1
+        }
+
+        if let activeSpeakers = update.activeSpeakers,
+           let call = callSnapshots[conversationId],
+           call.activeSpeakers != activeSpeakers {
+            callSnapshots[conversationId] = call.updateActiveSpeakers(activeSpeakers)
+
+            if !activeSpeakers.hasSameRanking(as: call.activeSpeakers) {
+                WireCallCenterActiveSpeakersNotification().post(in: context.notificationContext)
+                mediaUpdateCoalescer.statistics.activeSpeakersNotificationsPosted += 1
+            }
+        }
+    }
+
+}
+
 private extension Set where Element == ZMUser {
 
     var avsClients: Set<AVSClient> {
@@ -156,6 +156,17 @@ public protocol WireCallCenterCallParticipantObserver: AnyObject {
     func callParticipantsDidChange(conversation: ZMConversation, participants: [CallParticipant])
 }
 
+public protocol WireCallCenterCallParticipantChangeObserver: AnyObject {
+    /**
+     Called when a participant of the call joins / leaves or when their call state changes
+
+     - parameter conversation: where the call is ongoing
+     - parameter particpants: updated list of call participants
+     - parameter changes: differences to the previous list of call participants
+     */
+    func callParticipantsDidChange(conversation: ZMConversation, participants: [CallParticipant], changes: CallParticipantsChangeSet)
+}
+
 public struct WireCallCenterCallParticipantNotification: SelfPostingNotification {
 
     static let notificationName = Notification.Name("VoiceChannelParticipantNotification")
@@ -163,9 +174,13 @@ public struct WireCallCenterCallParticipantNotification: SelfPostingNotification
     let conversationId: AVSIdentifier
     let participants: [CallParticipant]
 
-    init(conversationId: AVSIdentifier, participants: [CallParticipant]) {
+    /// Differences to the previously posted participants, if known
+    let changes: CallParticipantsChangeSet?
+
+    init(conversationId: AVSIdentifier, participants: [CallParticipant], changes: CallParticipantsChangeSet? = nil) {
         self.conversationId = conversationId
         self.participants = participants
+        self.changes = changes
     }
 
 }
@@ -346,6 +361,27 @@ extension WireCallCenterV3 {
         }
     }
 
+    /// Add observer of incremental changes of call particpants in a conversation.
+    /// Returns a token which needs to be retained as long as the observer should be active.
+    public class func addCallParticipantChangeObserver(observer: WireCallCenterCallParticipantChangeObserver, for conversation: ZMConversation, userSession: ZMUserSession) -> Any {
+        return addCallParticipantChangeObserver(observer: observer, for: conversation, context: userSession.managedObjectContext)
+    }
+
+    /// Add observer of incremental changes of call particpants in a conversation.
+    /// Returns a token which needs to be retained as long as the observer should be active.
+    internal class func addCallParticipantChangeObserver(observer: WireCallCenterCallParticipantChangeObserver, for conversation: ZMConversation, context: NSManagedObjectContext) -> Any {
+        return NotificationInContext.addObserver(name: WireCallCenterCallParticipantNotification.notificationName, context: context.notificationContext, queue: .main) { [weak observer] note in
+            guard
+                let note = note.userInfo[WireCallCenterCallParticipantNotification.userInfoKey] as? WireCallCenterCallParticipantNotification,
+                let changes = note.changes,
+                let observer = observer,
+                note.conversationId == conversation.avsIdentifier
+            else { return }
+
+            observer.callParticipantsDidChange(conversation: conversation, participants: note.participants, changes: changes)
+        }
+    }
+
     /// Add observer of voice gain. Returns a token which needs to be retained as long as the observer should be active.
     /// Returns a token which needs to be retained as long as the observer should be active.
     public class func addVoiceGainObserver(observer: VoiceGainObserver, for conversation: ZMConversation, userSession: ZMUserSession) -> Any {
@@ -87,7 +87,7 @@ public class WireCallCenterV3: NSObject {
     var callSnapshots: [AVSIdentifier: CallSnapshot] = [:]
 
     /// Used to collect incoming events (e.g. from fetching the notification stream) until AVS is ready to process them.
-    var bufferedEvents: [(event: CallEvent, completionHandler: () -> Void)]  = []
+    var bufferedEvents = CallEventBuffer()
 
     /// Set to true once AVS calls the ReadyHandler. Setting it to `true` forwards all previously buffered events to AVS.
     var isReady: Bool = false {
@@ -95,11 +95,13 @@ public class WireCallCenterV3: NSObject {
             VoIPPushHelper.isAVSReady = isReady
 
             if isReady {
-                bufferedEvents.forEach { (item: (event: CallEvent, completionHandler: () -> Void)) in
-                    let (event, completionHandler) = item
+                let forwardedEvents = bufferedEvents.flush()
+
+                forwardedEvents.forEach { event, completionHandler in
                     handleCallEvent(event, completionHandler: completionHandler)
                 }
-                bufferedEvents = []
+
+                tagBufferedEventStatistics()
             }
         }
     }
@@ -110,6 +112,18 @@ public class WireCallCenterV3: NSObject {
 
     private(set) var isEnabled = true
 
+    /// Records the timeline of incoming call setups.
+    lazy var callSetupTracer = CallSetupTracer.tracer(forAccount: selfUserId.identifier)
+
+    /// Rate limits the active speaker and network quality updates reported by AVS.
+    let mediaUpdateCoalescer = CallMediaUpdateCoalescer()
+
+    /// Number of media updates received from AVS and of notifications posted for them.
+    /// Must be accessed on the main thread.
+    public var mediaUpdateStatistics: CallMediaUpdateStatistics {
+        return mediaUpdateCoalescer.statistics
+    }
+
     let encoder = JSONEncoder()
     let decoder = JSONDecoder()
 
@@ -147,6 +161,10 @@ public class WireCallCenterV3: NSObject {
 
         super.init()
 
+        mediaUpdateCoalescer.handler = { [weak self] conversationId, update in
+            self?.applyMediaUpdate(update, conversationId: conversationId)
+        }
+
         let observer = Unmanaged.passUnretained(self).toOpaque()
         self.avsWrapper = avsWrapper ?? AVSWrapper(userId: userId, clientId: clientId, observer: observer)
     }
@@ -165,6 +183,7 @@ extension WireCallCenterV3 {
     func clearSnapshot(conversationId: AVSIdentifier) {
         callSnapshots.removeValue(forKey: conversationId)
         clientsRequestCompletionsByConversationId.removeValue(forKey: conversationId)
+        mediaUpdateCoalescer.discardUpdates(for: conversationId)
     }
 
     /**
@@ -335,6 +354,16 @@ extension WireCallCenterV3 {
         return callSnapshots[conversationId]?.isConferenceCall ?? false
     }
 
+    /// Histograms of the time incoming calls spent between the steps of their setup.
+    public var callSetupHistograms: [CallSetupTracer.Step: CallSetupTracer.Histogram] {
+        return callSetupTracer.stepHistograms
+    }
+
+    /// JSON report of the call setup timings, to be attached to debug reports.
+    public func callSetupDebugReport() -> String {
+        return callSetupTracer.debugExport()
+    }
+
     func degradedUser(conversationId: AVSIdentifier) -> ZMUser? {
         return callSnapshots[conversationId]?.degradedUser
     }
@@ -443,6 +472,8 @@ extension WireCallCenterV3 {
 
         let answered = avsWrapper.answerCall(conversationId: conversationId, callType: callType, useCBR: useConstantBitRateAudio)
         if answered {
+            callSetupTracer.stamp(.answered, conversationId: conversationId.identifier)
+
             let callState: CallState = .answered(degraded: isDegraded(conversationId: conversationId))
 
             let previousSnapshot = callSnapshots[conversationId]
@@ -681,12 +712,29 @@ extension WireCallCenterV3 {
         if isReady {
             handleCallEvent(callEvent, completionHandler: completionHandler)
         } else {
-            bufferedEvents.append((callEvent, completionHandler))
+            bufferedEvents.append(callEvent, completionHandler: completionHandler)
         }
     }
 
+    /// Reports the events buffered while AVS wasn't ready, each buffered event is only reported once
+    private func tagBufferedEventStatistics() {
+        let statistics = bufferedEvents.statistics
+        bufferedEvents.resetStatistics()
+
+        guard statistics.bufferedCount > 0 else { return }
+
+        analytics?.tagEvent("calling.buffered_events", attributes: [
+            "buffered": NSNumber(value: statistics.bufferedCount),
+            "deduplicated": NSNumber(value: statistics.deduplicatedCount),
+            "pruned": NSNumber(value: statistics.prunedCount),
+            "overflowed": NSNumber(value: statistics.overflowCount),
+            "forwarded": NSNumber(value: statistics.forwardedCount)
+        ])
+    }
+
     fileprivate func handleCallEvent(_ callEvent: CallEvent, completionHandler: @escaping () -> Void) {
         Self.logger.trace("handle call event")
+        callSetupTracer.stamp(.callEventForwarded, conversationId: callEvent.conversationId.identifier)
         let result = avsWrapper.received(callEvent: callEvent)
 
         if let context = uiMOC, let error = result {
@@ -725,6 +773,7 @@ extension WireCallCenterV3 {
 
         if case .terminating = callState {
             clearSnapshot(conversationId: conversationId)
+            callSetupTracer.discardTrace(conversationId: conversationId.identifier)
         } else if let previousSnapshot = callSnapshots[conversationId] {
             callSnapshots[conversationId] = previousSnapshot.update(with: callState)
         }
@@ -22,18 +22,29 @@ class TypingUsersTimeout: NSObject {
 
     private var timeouts = [Key: Date]()
 
+    /// The typing users of each conversation
+    private var userIdsByConversation = [NSManagedObjectID: Set<NSManagedObjectID>]()
+
+    /// The timeouts ordered by date. Entries of keys which were removed or got a new timeout
+    /// are left in the heap and skipped when they reach the top.
+    private var timeoutHeap = TimeoutHeap()
+
     var firstTimeout: Date? {
-        return timeouts.values.min()
+        removeOutdatedHeapEntries()
+        return timeoutHeap.first?.timeout
     }
 
     func add(_ user: ZMUser, for conversation: ZMConversation, withTimeout timeout: Date) {
         let key = Key(user: user, conversation: conversation)
         timeouts[key] = timeout
+        userIdsByConversation[key.conversationObjectId, default: Set()].insert(key.userObjectId)
+        timeoutHeap.insert(TimeoutHeap.Entry(key: key, timeout: timeout))
+        compactHeapIfNeeded()
     }
 
     func remove(_ user: ZMUser, for conversation: ZMConversation) {
         let key = Key(user: user, conversation: conversation)
-        timeouts.removeValue(forKey: key)
+        removeTimeout(for: key)
     }
 
     func contains(_ user: ZMUser, for conversation: ZMConversation) -> Bool {
@@ -42,19 +53,107 @@ class TypingUsersTimeout: NSObject {
     }
 
     func userIds(in conversation: ZMConversation) -> Set<NSManagedObjectID> {
-        let userIds = timeouts.keys
-            .filter { $0.conversationObjectId == conversation.objectID }
-            .map(\.userObjectId)
-
-        return Set(userIds)
+        return userIdsByConversation[conversation.objectID] ?? Set()
     }
 
     func pruneConversationsThatHaveTimoutBefore(date pruneDate: Date) -> Set<NSManagedObjectID> {
-        let keysToRemove = timeouts
-            .filter { $0.value < pruneDate }
-            .keys
+        var prunedConversations = Set<NSManagedObjectID>()
+
+        while let entry = timeoutHeap.first, entry.timeout < pruneDate {
+            timeoutHeap.removeFirst()
+
+            guard isCurrent(entry) else { continue }
+
+            removeTimeout(for: entry.key)
+            prunedConversations.insert(entry.key.conversationObjectId)
+        }
+
+        return prunedConversations
+    }
+
+    private func removeTimeout(for key: Key) {
+        guard timeouts.removeValue(forKey: key) != nil else { return }
+
+        userIdsByConversation[key.conversationObjectId]?.remove(key.userObjectId)
+
+        if userIdsByConversation[key.conversationObjectId]?.isEmpty == true {
+            userIdsByConversation.removeValue(forKey: key.conversationObjectId)
+        }
+    }
+
+    private func isCurrent(_ entry: TimeoutHeap.Entry) -> Bool {
+        return timeouts[entry.key] == entry.timeout
+    }
+
+    private func removeOutdatedHeapEntries() {
+        while let entry = timeoutHeap.first, !isCurrent(entry) {
+            timeoutHeap.removeFirst()
+        }
+    }
+
+    /// Rebuilds the heap once most of its entries are outdated, e.g. because
+    /// the same users keep typing and their timeouts keep being extended
+    private func compactHeapIfNeeded() {
+        guard timeoutHeap.count > 2 * timeouts.count + 16 else { return }
+
+        timeoutHeap = TimeoutHeap()
+        timeouts.forEach { timeoutHeap.insert(TimeoutHeap.Entry(key: $0.key, timeout: $0.value)) }
+    }
+}
+
+/// A binary min-heap of the typing timeouts
+private struct TimeoutHeap {
+
+    struct Entry {
+        let key: TypingUsersTimeout.Key
+        let timeout: Date
+    }
+
+    private var entries = [Entry]()
+
+    var first: Entry? {
+        return entries.first
+    }
+
+    var count: Int {
+        return entries.count
+    }
+
+    mutating func insert(_ entry: Entry) {
+        entries.append(entry)
 
-        keysToRemove.forEach { self.timeouts.removeValue(forKey: $0) }
-        return Set(keysToRemove.map(\.conversationObjectId))
+        var index = entries.count - 1
+        while index > 0 {
+            let parent = (index - 1) / 2
+            guard entries[index].timeout < entries[parent].timeout else { break }
+            entries.swapAt(index, parent)
+            index = parent
+        }
     }
+
+    mutating func removeFirst() {
+        guard !entries.isEmpty else { return }
+
+        entries.swapAt(0, entries.count - 1)
+        entries.removeLast()
+
+        var index = 0
+        while true {
+            let left = 2 * index + 1
+            let right = left + 1
+            var smallest = index
+
+            if left < entries.count, entries[left].timeout < entries[smallest].timeout {
+                smallest = left
+            }
+            if right < entries.count, entries[right].timeout < entries[smallest].timeout {
+                smallest = right
+            }
+            guard smallest != index else { break }
+
+            entries.swapAt(index, smallest)
+            index = smallest
+        }
+    }
+
 }
@@ -28,21 +28,41 @@ import UserNotifications
 
     let archivingKey: String
     let keyValueStore: ZMSynchonizableKeyValueStore
+    let journalURL: URL?
     var notificationCenter: UserNotificationCenter = UNUserNotificationCenter.current()
 
-    fileprivate(set) var notifications = Set<ZMLocalNotification>() {
-        didSet { updateArchive() }
-    }
+    /// Number of journal records after which the journal is folded into the archive
+    static let maxJournalLength = 50
+
+    fileprivate(set) var notifications = Set<ZMLocalNotification>()
+
+    /// Indexes of `notifications`, to avoid scanning all of them on every lookup
+    private var notificationsByMessageNonce = [UUID: Set<ZMLocalNotification>]()
+    private var notificationsByConversationID = [UUID: Set<ZMLocalNotification>]()
 
     private(set) var oldNotifications = [NotificationUserInfo]()
 
+    /// Number of records written to the journal since the last compaction
+    private(set) var journalLength = 0
+
+    /// Incremented every time the notifications are archived, so that the journal records the
+    /// archive covers can be told apart from the ones written after it
+    private var archiveGeneration = 0
+
+    private var archiveGenerationKey: String {
+        return "\(archivingKey).generation"
+    }
+
     private var allNotifications: [NotificationUserInfo] {
         return notifications.compactMap { $0.userInfo } + oldNotifications
     }
 
-    init(archivingKey: String, keyValueStore: ZMSynchonizableKeyValueStore) {
+    /// - parameter journalURL: file to which the changes since the last archive are appended,
+    /// `nil` archives all notifications on every change
+    init(archivingKey: String, keyValueStore: ZMSynchonizableKeyValueStore, journalURL: URL? = nil) {
         self.archivingKey = archivingKey
         self.keyValueStore = keyValueStore
+        self.journalURL = journalURL
         super.init()
 
         unarchiveOldNotifications()
@@ -50,30 +70,75 @@ import UserNotifications
 
     /// Unarchives all previously created notifications that haven't been cancelled yet
     func unarchiveOldNotifications() {
-        guard let archive = keyValueStore.storedValue(key: archivingKey) as? Data,
-        let unarchivedNotes =  NSKeyedUnarchiver.unarchiveObject(with: archive) as? [NotificationUserInfo]
-            else { return }
+        var unarchivedNotes = [NotificationUserInfo]()
+
+        if let archive = keyValueStore.storedValue(key: archivingKey) as? Data,
+           let archivedNotes = NSKeyedUnarchiver.unarchiveObject(with: archive) as? [NotificationUserInfo] {
+            unarchivedNotes = archivedNotes
+        }
+
+        archiveGeneration = (keyValueStore.storedValue(key: archiveGenerationKey) as? NSNumber)?.intValue ?? 0
+
+        let journal = readJournal()
+        let archiveMarker = journal.lastIndex { $0.isArchiveMarker(generation: archiveGeneration) }
+        let unarchivedRecords = archiveMarker.map { journal[($0 + 1)...] } ?? journal[...]
+
+        for record in unarchivedRecords {
+            switch record {
+            case .added(let userInfo):
+                unarchivedNotes.removeAll { $0.requestID == userInfo.requestID }
+                unarchivedNotes.append(userInfo)
+            case .removed(let requestID):
+                unarchivedNotes.removeAll { $0.requestID == requestID }
+            case .removedAll:
+                unarchivedNotes.removeAll()
+            case .archived:
+                break
+            }
+        }
+
+        // The stored archive was saved, the records it covers aren't needed anymore
+        if let archiveMarker = archiveMarker, archiveMarker > 0 {
+            rewriteJournal(Array(journal[archiveMarker...]))
+        }
+
+        journalLength = unarchivedRecords.count
         self.oldNotifications = unarchivedNotes
     }
 
-    /// Archives all scheduled notifications - this could be optimized
+    /// Archives all scheduled notifications and starts a new section of the journal. The journal
+    /// is only truncated on the next launch, once it's known that the archive was saved.
     func updateArchive() {
+        archiveGeneration += 1
+
         let data = NSKeyedArchiver.archivedData(withRootObject: allNotifications)
         keyValueStore.store(value: data as NSData, key: archivingKey)
+        keyValueStore.store(value: NSNumber(value: archiveGeneration), key: archiveGenerationKey)
         keyValueStore.enqueueDelayedSave() // we need to save otherwise changes might not be stored
+
+        writeToJournal(.archived(generation: archiveGeneration))
+        journalLength = 0
     }
 
     @discardableResult func remove(_ notification: ZMLocalNotification) -> ZMLocalNotification? {
-        return notifications.remove(notification)
+        let removed = notifications.remove(notification)
+        removed.map(removeFromIndexes)
+        removed.map { appendToJournal(.removed(requestID: $0.id)) }
+        return removed
+    }
+
+    /// Whether a notification was created in this run for the message with the given nonce
+    func containsNotification(messageNonce: UUID) -> Bool {
+        return notificationsByMessageNonce[messageNonce] != nil
     }
 
     func addObject(_ notification: ZMLocalNotification) {
-        notifications.insert(notification)
+        insert(notification)
     }
 
     func replaceObject(_ toReplace: ZMLocalNotification, newObject: ZMLocalNotification) {
-        notifications.remove(toReplace)
-        notifications.insert(newObject)
+        remove(toReplace)
+        insert(newObject)
     }
 
     /// Cancels all notifications
@@ -81,7 +146,11 @@ import UserNotifications
         let ids = allNotifications.compactMap { $0.requestID?.uuidString }
         notificationCenter.removeAllNotifications(withIdentifiers: ids)
         notifications = Set()
+        notificationsByMessageNonce = [:]
+        notificationsByConversationID = [:]
         oldNotifications = []
+        writeToJournal(.removedAll)
+        updateArchive()
     }
 
     /// This cancels all notifications of a specific conversation
@@ -92,34 +161,207 @@ import UserNotifications
 
     /// Cancel all notifications created in this run
     func cancelCurrentNotifications(_ conversation: ZMConversation) {
-        guard notifications.count > 0 else { return }
-        let toRemove = notifications.filter { $0.conversationID == conversation.remoteIdentifier }
+        guard
+            let conversationID = conversation.remoteIdentifier,
+            let toRemove = notificationsByConversationID[conversationID]
+        else { return }
+
         notificationCenter.removeAllNotifications(withIdentifiers: toRemove.map { $0.id.uuidString })
-        notifications.subtract(toRemove)
+        subtract(toRemove)
     }
 
     /// Cancels all notifications created in previous runs
     func cancelOldNotifications(_ conversation: ZMConversation) {
         guard oldNotifications.count > 0 else { return }
 
+        var removedRequestIDs = [UUID]()
+
         oldNotifications = oldNotifications.filter { userInfo in
             guard
                 userInfo.conversationID == conversation.remoteIdentifier,
-                let requestID = userInfo.requestID?.uuidString
+                let requestID = userInfo.requestID
                 else { return true }
 
-            notificationCenter.removeAllNotifications(withIdentifiers: [requestID])
+            notificationCenter.removeAllNotifications(withIdentifiers: [requestID.uuidString])
+            removedRequestIDs.append(requestID)
             return false
         }
+
+        removedRequestIDs.forEach { appendToJournal(.removed(requestID: $0)) }
     }
 
     /// Cancal all notifications with the given message nonce
     func cancelCurrentNotifications(messageNonce: UUID) {
-        guard notifications.count > 0 else { return }
-        let toRemove = notifications.filter { $0.messageNonce == messageNonce }
+        guard let toRemove = notificationsByMessageNonce[messageNonce] else { return }
         notificationCenter.removeAllNotifications(withIdentifiers: toRemove.map { $0.id.uuidString })
+        subtract(toRemove)
+    }
+
+    private func insert(_ notification: ZMLocalNotification) {
+        guard notifications.insert(notification).inserted else { return }
+
+        if let messageNonce = notification.messageNonce {
+            notificationsByMessageNonce[messageNonce, default: []].insert(notification)
+        }
+
+        if let conversationID = notification.conversationID {
+            notificationsByConversationID[conversationID, default: []].insert(notification)
+        }
+
+        notification.userInfo.map { appendToJournal(.added($0)) }
+    }
+
+    private func subtract(_ toRemove: Set<ZMLocalNotification>) {
         notifications.subtract(toRemove)
+        toRemove.forEach(removeFromIndexes)
+        toRemove.forEach { appendToJournal(.removed(requestID: $0.id)) }
+    }
+
+    private func removeFromIndexes(_ notification: ZMLocalNotification) {
+        if let messageNonce = notification.messageNonce {
+            notificationsByMessageNonce[messageNonce]?.remove(notification)
+
+            if notificationsByMessageNonce[messageNonce]?.isEmpty == true {
+                notificationsByMessageNonce.removeValue(forKey: messageNonce)
+            }
+        }
+
+        if let conversationID = notification.conversationID {
+            notificationsByConversationID[conversationID]?.remove(notification)
+
+            if notificationsByConversationID[conversationID]?.isEmpty == true {
+                notificationsByConversationID.removeValue(forKey: conversationID)
+            }
+        }
+    }
+}
+
+// MARK: - Journal
+
+/// Changes since the last archive are appended to a journal file as small records, so that a
+/// change doesn't require archiving all notifications. Each record is prefixed with its length.
+/// When the journal gets long, it is folded into the archive and a marker with the generation of
+/// the archive is appended. On launch only the records after the marker of the stored archive are
+/// replayed, so the journal stays valid when the archive wasn't saved before the app was killed.
+extension ZMLocalNotificationSet {
+
+    enum JournalRecord {
+        case added(NotificationUserInfo)
+        case removed(requestID: UUID)
+        case removedAll
+        case archived(generation: Int)
+
+        private static let addedKey = "added"
+        private static let removedKey = "removed"
+        private static let removedAllKey = "removedAll"
+        private static let archivedKey = "archived"
+
+        init?(data: Data) {
+            guard let record = NSKeyedUnarchiver.unarchiveObject(with: data) as? [String: Any] else { return nil }
+
+            if let userInfo = record[Self.addedKey] as? NotificationUserInfo {
+                self = .added(userInfo)
+            } else if let requestID = (record[Self.removedKey] as? String).flatMap(UUID.init(uuidString:)) {
+                self = .removed(requestID: requestID)
+            } else if record[Self.removedAllKey] != nil {
+                self = .removedAll
+            } else if let generation = record[Self.archivedKey] as? NSNumber {
+                self = .archived(generation: generation.intValue)
+            } else {
+                return nil
+            }
+        }
+
+        var data: Data {
+            switch self {
+            case .added(let userInfo):
+                return NSKeyedArchiver.archivedData(withRootObject: [Self.addedKey: userInfo])
+            case .removed(let requestID):
+                return NSKeyedArchiver.archivedData(withRootObject: [Self.removedKey: requestID.uuidString])
+            case .removedAll:
+                return NSKeyedArchiver.archivedData(withRootObject: [Self.removedAllKey: true])
+            case .archived(let generation):
+                return NSKeyedArchiver.archivedData(withRootObject: [Self.archivedKey: generation])
+            }
+        }
+
+        func isArchiveMarker(generation: Int) -> Bool {
+            guard case .archived(generation) = self else { return false }
+            return true
+        }
     }
+
+    private static let recordLengthSize = MemoryLayout<UInt32>.size
+
+    /// Reads the records of the journal, a record which was only partially written is ignored
+    private func readJournal() -> [JournalRecord] {
+        guard let journalURL = journalURL, let data = try? Data(contentsOf: journalURL) else { return [] }
+
+        var records = [JournalRecord]()
+        var offset = data.startIndex
+
+        while data.endIndex - offset >= Self.recordLengthSize {
+            let length = data[offset..<offset + Self.recordLengthSize].reduce(0) { $0 << 8 | Int($1) }
+            let recordStart = offset + Self.recordLengthSize
+
+            guard data.endIndex - recordStart >= length else { break }
+
+            if let record = JournalRecord(data: data.subdata(in: recordStart..<recordStart + length)) {
+                records.append(record)
+            }
+
+            offset = recordStart + length
+        }
+
+        return records
+    }
+
+    private func appendToJournal(_ record: JournalRecord) {
+        guard journalLength < Self.maxJournalLength, writeToJournal(record) else {
+            return updateArchive()
+        }
+
+        journalLength += 1
+    }
+
+    private func entry(for record: JournalRecord) -> Data {
+        let recordData = record.data
+        var length = UInt32(recordData.count).bigEndian
+        var entry = Data(bytes: &length, count: Self.recordLengthSize)
+        entry.append(recordData)
+        return entry
+    }
+
+    /// - returns: `false` if there is no journal or the record couldn't be written
+    @discardableResult
+    private func writeToJournal(_ record: JournalRecord) -> Bool {
+        guard let journalURL = journalURL else { return false }
+
+        do {
+            let fileManager = FileManager.default
+
+            if !fileManager.fileExists(atPath: journalURL.path) {
+                try fileManager.createDirectory(at: journalURL.deletingLastPathComponent(), withIntermediateDirectories: true)
+                fileManager.createFile(atPath: journalURL.path, contents: nil)
+            }
+
+            let fileHandle = try FileHandle(forWritingTo: journalURL)
+            defer { fileHandle.closeFile() }
+            fileHandle.seekToEndOfFile()
+            fileHandle.write(entry(for: record))
+            return true
+        } catch {
+            return false
+        }
+    }
+
+    private func rewriteJournal(_ records: [JournalRecord]) {
+        guard let journalURL = journalURL else { return }
+
+        let data = records.reduce(into: Data()) { $0.append(entry(for: $1)) }
+        try? data.write(to: journalURL, options: .atomic)
+    }
+
 }
 
 // Event Notifications
@@ -130,6 +372,6 @@ extension ZMLocalNotificationSet {
             $0.conversationID == conversation.remoteIdentifier && $0.isCallingNotification
         }
         notificationCenter.removeAllNotifications(withIdentifiers: toRemove.map { $0.id.uuidString })
-        notifications.subtract(toRemove)
+        subtract(toRemove)
     }
 }
@@ -35,12 +35,29 @@ import UserNotifications
 
     var localNotificationBuffer = [ZMLocalNotification]()
 
+    /// Number of message notifications of a conversation within a batch of events from which
+    /// they are scheduled as a single summary notification. `0` disables coalescing.
+    var coalescingThreshold = 3
+
+    /// The summary notifications scheduled in this run, by the nonces of the messages they cover
+    var summariesByMessageNonce = [UUID: NotificationSummary]()
+
     @objc(initWithManagedObjectContext:)
-    public init(in managedObjectContext: NSManagedObjectContext) {
+    public convenience init(in managedObjectContext: NSManagedObjectContext) {
+        self.init(in: managedObjectContext, accountContainer: nil)
+    }
+
+    /// - parameter accountContainer: where the notification sets keep the journal of their changes
+    public init(in managedObjectContext: NSManagedObjectContext, accountContainer: URL?) {
+        func notificationSet(archivingKey: String) -> ZMLocalNotificationSet {
+            let journalURL = accountContainer?.appendingPathComponent("local-notifications").appendingPathComponent("\(archivingKey).journal")
+            return ZMLocalNotificationSet(archivingKey: archivingKey, keyValueStore: managedObjectContext, journalURL: journalURL)
+        }
+
         self.syncMOC = managedObjectContext
-        self.eventNotifications = ZMLocalNotificationSet(archivingKey: "ZMLocalNotificationDispatcherEventNotificationsKey", keyValueStore: managedObjectContext)
-        self.failedMessageNotifications = ZMLocalNotificationSet(archivingKey: "ZMLocalNotificationDispatcherFailedNotificationsKey", keyValueStore: managedObjectContext)
-        self.callingNotifications = ZMLocalNotificationSet(archivingKey: "ZMLocalNotificationDispatcherCallingNotificationsKey", keyValueStore: managedObjectContext)
+        self.eventNotifications = notificationSet(archivingKey: "ZMLocalNotificationDispatcherEventNotificationsKey")
+        self.failedMessageNotifications = notificationSet(archivingKey: "ZMLocalNotificationDispatcherFailedNotificationsKey")
+        self.callingNotifications = notificationSet(archivingKey: "ZMLocalNotificationDispatcherCallingNotificationsKey")
         super.init()
         observers.append(
             NotificationInContext.addObserver(name: ZMConversation.lastReadDidChangeNotificationName,
@@ -79,20 +96,55 @@ extension LocalNotificationDispatcher: ZMEventConsumer {
 
     public func processEventsWhileInBackground(_ events: [ZMUpdateEvent]) {
         let eventsToForward = events.filter { $0.source.isOne(of: .pushNotification, .webSocket) }
-        self.didReceive(events: eventsToForward, conversationMap: [:])
+        self.didReceive(events: eventsToForward, conversationMap: prefetchConversations(for: eventsToForward))
+    }
+
+    /// Identifies a conversation in the conversation map of a batch of events
+    struct ConversationKey: Hashable {
+        let id: UUID
+        let domain: String?
+
+        /// A missing domain refers to the local backend, domains are ignored when federation is disabled
+        init(id: UUID, domain: String?) {
+            self.id = id
+            self.domain = BackendInfo.isFederationEnabled ? (domain.nonEmptyValue ?? BackendInfo.domain) : nil
+        }
+    }
+
+    /// Fetches the conversations of all events with a single fetch request
+    func prefetchConversations(for events: [ZMUpdateEvent]) -> [ConversationKey: ZMConversation] {
+        let conversationIDs = Set(events.compactMap(\.conversationUUID))
+
+        guard
+            !conversationIDs.isEmpty,
+            let conversations = ZMConversation.fetchObjects(withRemoteIdentifiers: conversationIDs, in: syncMOC) as? Set<ZMConversation>
+        else {
+            return [:]
+        }
+
+        var conversationMap = [ConversationKey: ZMConversation]()
+        for conversation in conversations {
+            guard let conversationID = conversation.remoteIdentifier else { continue }
+            conversationMap[ConversationKey(id: conversationID, domain: conversation.domain)] = conversation
+        }
+
+        return conversationMap
     }
 
-    func didReceive(events: [ZMUpdateEvent], conversationMap: [UUID: ZMConversation]) {
+    func didReceive(events: [ZMUpdateEvent], conversationMap: [ConversationKey: ZMConversation]) {
+        var notes = [(note: ZMLocalNotification, conversation: ZMConversation?)]()
+
         events.forEach { event in
 
             var conversation: ZMConversation?
             if let conversationID = event.conversationUUID {
                 // Fetch the conversation here to avoid refetching every time we try to create a notification
-                conversation = conversationMap[conversationID] ?? ZMConversation.fetch(with: conversationID, domain: event.conversationDomain, in: self.syncMOC)
+                let key = ConversationKey(id: conversationID, domain: event.conversationDomain)
+                conversation = conversationMap[key] ?? ZMConversation.fetch(with: conversationID, domain: event.conversationDomain, in: self.syncMOC)
             }
 
             if let messageNonce = event.messageNonce {
-                if eventNotifications.notifications.contains(where: { $0.messageNonce == messageNonce }) {
+                if eventNotifications.containsNotification(messageNonce: messageNonce) {
                     // ignore events which we already scheduled a notification for
                     return
                 }
@@ -117,8 +169,61 @@ extension LocalNotificationDispatcher: ZMEventConsumer {
 
             note?.increaseEstimatedUnreadCount(on: conversation)
             note.apply(eventNotifications.addObject)
-            note.apply(scheduleLocalNotification)
+            note.map { notes.append(($0, conversation)) }
         }
+
+        // Notifications cancelled by a later event of the batch aren't scheduled at all
+        scheduleLocalNotifications(notes.filter { eventNotifications.notifications.contains($0.note) })
+    }
+
+    /// Schedules the notifications created for a batch of events. When a conversation has many message
+    /// notifications in the batch, a single notification summarizing them is scheduled instead.
+    private func scheduleLocalNotifications(_ notes: [(note: ZMLocalNotification, conversation: ZMConversation?)]) {
+        var coalescableNotes = [UUID: [ZMLocalNotification]]()
+
+        if coalescingThreshold > 0 {
+            for (note, conversation) in notes where note.isCoalescable {
+                guard let conversationID = conversation?.remoteIdentifier else { continue }
+                coalescableNotes[conversationID, default: []].append(note)
+            }
+
+            coalescableNotes = coalescableNotes.filter { $0.value.count >= coalescingThreshold }
+        }
+
+        for (note, conversation) in notes {
+            guard
+                let conversation = conversation,
+                let conversationID = conversation.remoteIdentifier,
+                let coalescedNotes = coalescableNotes[conversationID],
+                coalescedNotes.contains(note)
+            else {
+                scheduleLocalNotification(note)
+                continue
+            }
+
+            // The summary is scheduled in place of the last message it covers
+            if note == coalescedNotes.last {
+                scheduleSummary(of: coalescedNotes, in: conversation)
+            }
+        }
+    }
+
+    /// A summary notification and the message notifications it stands for
+    struct NotificationSummary {
+        let summary: ZMLocalNotification
+        let notes: [ZMLocalNotification]
+        let conversation: ZMConversation
+    }
+
+    private func scheduleSummary(of notes: [ZMLocalNotification], in conversation: ZMConversation) {
+        guard let summary = ZMLocalNotification(coalescing: notes, in: conversation, moc: syncMOC) else { return }
+
+        Logging.push.safePublic("Coalescing \(SanitizedString(stringLiteral: String(notes.count))) local notifications into id=\(summary.id)")
+        eventNotifications.addObject(summary)
+        scheduleLocalNotification(summary)
+
+        let notificationSummary = NotificationSummary(summary: summary, notes: notes, conversation: conversation)
+        notes.compactMap(\.messageNonce).forEach { summariesByMessageNonce[$0] = notificationSummary }
     }
 }
 
@@ -176,6 +281,7 @@ extension LocalNotificationDispatcher {
     /// Can be used for cancelling all conversations if need
     public func cancelAllNotifications() {
         self.allNotificationSets.forEach { $0.cancelAllNotifications() }
+        summariesByMessageNonce.removeAll()
     }
 
     /// Cancels all notifications for a specific conversation
@@ -183,6 +289,7 @@ extension LocalNotificationDispatcher {
     /// ZMConversationDidChangeVisibleWindowNotification is called
     public func cancelNotification(for conversation: ZMConversation) {
         self.allNotificationSets.forEach { $0.cancelNotifications(conversation) }
+        summariesByMessageNonce = summariesByMessageNonce.filter { $0.value.conversation != conversation }
     }
 
     func cancelMessageForDeletedMessage(_ genericMessage: GenericMessage) {
@@ -198,6 +305,27 @@ extension LocalNotificationDispatcher {
 
         if let idToDelete = idToDelete {
             eventNotifications.cancelCurrentNotifications(messageNonce: idToDelete)
+            cancelSummary(coveringMessageNonce: idToDelete)
+        }
+    }
+
+    /// Cancels the summary covering the message. The other messages it covers are summarized again,
+    /// or notified one by one when there are fewer of them than `coalescingThreshold`.
+    func cancelSummary(coveringMessageNonce messageNonce: UUID) {
+        guard let notificationSummary = summariesByMessageNonce[messageNonce] else { return }
+
+        notificationSummary.notes.compactMap(\.messageNonce).forEach { summariesByMessageNonce.removeValue(forKey: $0) }
+
+        // The summary may have been cancelled already, e.g. when the conversation was read
+        guard eventNotifications.remove(notificationSummary.summary) != nil else { return }
+        notificationCenter.removeAllNotifications(withIdentifiers: [notificationSummary.summary.id.uuidString])
+
+        let remainingNotes = notificationSummary.notes.filter { eventNotifications.notifications.contains($0) }
+
+        if coalescingThreshold > 0, remainingNotes.count >= coalescingThreshold {
+            scheduleSummary(of: remainingNotes, in: notificationSummary.conversation)
+        } else {
+            remainingNotes.forEach(scheduleLocalNotification)
         }
     }
 
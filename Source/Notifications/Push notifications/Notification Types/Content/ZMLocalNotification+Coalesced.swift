@@ -0,0 +1,90 @@
+//
+// Wire
+// Copyright (C) 2022 Wire Swiss GmbH
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see http://www.gnu.org/licenses/.
+//
+
+import Foundation
+
+// MARK: - Coalesced Messages
+
+extension ZMLocalNotification {
+
+    /// Creates a single notification summarizing the message notifications of a conversation,
+    /// e.g. "5 messages in [conversationName]".
+    convenience init?(coalescing notifications: [ZMLocalNotification], in conversation: ZMConversation, moc: NSManagedObjectContext) {
+        guard let builder = CoalescedMessagesNotificationBuilder(notifications: notifications, conversation: conversation, moc: moc) else { return nil }
+        self.init(builder: builder, moc: moc)
+    }
+
+    /// Whether the notification can be replaced by a summary of the conversation. Mentions,
+    /// replies, pings, ephemeral and hidden messages, system messages and calls are always
+    /// notified individually.
+    var isCoalescable: Bool {
+        guard case .message(let contentType) = type else { return false }
+
+        switch contentType {
+        case .text(_, isMention: false, isReply: false), .image, .video, .audio, .location, .fileUpload:
+            return true
+        default:
+            return false
+        }
+    }
+
+    private class CoalescedMessagesNotificationBuilder: NotificationBuilder {
+
+        private let notifications: [ZMLocalNotification]
+        private let conversation: ZMConversation
+        private let moc: NSManagedObjectContext
+
+        init?(notifications: [ZMLocalNotification], conversation: ZMConversation, moc: NSManagedObjectContext) {
+            guard let lastNotification = notifications.last, lastNotification.userInfo != nil else { return nil }
+
+            self.notifications = notifications
+            self.conversation = conversation
+            self.moc = moc
+        }
+
+        var notificationType: LocalNotificationType {
+            return notifications.last!.type
+        }
+
+        func shouldCreateNotification() -> Bool {
+            return true
+        }
+
+        func titleText() -> String? {
+            return notificationType.titleText(selfUser: ZMUser.selfUser(in: moc), conversation: conversation)
+        }
+
+        func bodyText() -> String {
+            let senderIDs = Set(notifications.compactMap(\.senderID))
+            let sender = senderIDs.count == 1 ? notifications.last?.sender(in: moc) : nil
+
+            return LocalNotificationType.coalescedMessagesBodyText(count: notifications.count, sender: sender, conversation: conversation)
+        }
+
+        func userInfo() -> NotificationUserInfo? {
+            guard let lastUserInfo = notifications.last?.userInfo else { return nil }
+
+            // The summary doesn't stand for a single message, it needs its own request id
+            let userInfo = NotificationUserInfo(storage: lastUserInfo.storage)
+            userInfo.messageNonce = nil
+            userInfo.requestID = nil
+
+            return userInfo
+        }
+    }
+}
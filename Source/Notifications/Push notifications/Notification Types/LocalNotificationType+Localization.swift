@@ -38,8 +38,7 @@ private let ZMPushStringAudioAdd            = "add.audio"            // "[sender
 private let ZMPushStringFileAdd             = "add.file"             // "[senderName] shared a file"
 private let ZMPushStringLocationAdd         = "add.location"         // "[senderName] shared a location"
 
-// currently disabled
-// public let ZMPushStringMessageAddMany      = "add.message.many"    // "x new messages in [conversationName] / from [senderName]"
+private let ZMPushStringMessageAddMany      = "add.message.many"     // "x new messages in [conversationName] / from [senderName]"
 
 private let ZMPushStringFailedToSend        = "failed.message"       // "Unable to send a message"
 
@@ -298,6 +297,33 @@ extension LocalNotificationType {
         return .localizedStringWithFormat(localizationKey.pushFormatString, arguments: arguments)
     }
 
+    /// Body of a notification summarizing several messages in a conversation
+    static func coalescedMessagesBodyText(count: Int, sender: ZMUser?, conversation: ZMConversation?) -> String {
+        let isOneOnOne = conversation?.conversationType == .oneOnOne
+        let conversationTypeKey = isOneOnOne ? OneOnOneKey : GroupKey
+        var nameKey: String?
+        var arguments: [CVarArg] = []
+
+        if isOneOnOne {
+            if let senderName = sender?.name, !senderName.isEmpty {
+                arguments.append(senderName)
+            } else {
+                nameKey = NoUserNameKey
+            }
+        } else {
+            if let conversationName = conversation?.meaningfulDisplayName {
+                arguments.append(conversationName)
+            } else {
+                nameKey = NoConversationNameKey
+            }
+        }
+
+        arguments.append(NSNumber(value: count))
+
+        let localizationKey = [ZMPushStringMessageAddMany, conversationTypeKey, nameKey].compactMap({ $0 }).joined(separator: ".")
+        return .localizedStringWithFormat(localizationKey.pushFormatString, arguments: arguments)
+    }
+
 }
 
 extension String {
@@ -152,6 +152,8 @@ public final class VoIPPushManager: NSObject, PKPushRegistryDelegate {
             return
         }
 
+        CallSetupTracer.tracer(forAccount: accountID).stamp(.pushReceived, conversationId: conversationID)
+
         let handle = CallHandle(
             accountID: accountID,
             conversationID: conversationID
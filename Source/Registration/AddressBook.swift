@@ -62,51 +62,24 @@ extension AddressBookAccessor {
     }
 
     /// Encodes an arbitraty part the address book asynchronously. Will invoke the completion handler when done.
+    /// - note: this enumerates the address book from the start on every call, keep one `AddressBookChunkEncoder`
+    ///     and use its `encodeChunk` to encode the address book in successive chunks
     /// - parameter groupQueue: group queue to enter while executing, and where to invoke callback
     /// - parameter completion: closure invoked when the address book encoding ended. It will receive nil parameter
     ///     if there are no contacts to upload
-    /// - parameter maxNumberOfContacts: do not include more than this number of contacts
+    /// - parameter maxNumberOfContacts: do not include more than this number of contacts, with 0 the chunk
+    ///     doesn't include any contact
     /// - parameter startingContactIndex: include contacts starting from this index in the address book
     func encodeWithCompletionHandler(_ groupQueue: ZMSGroupQueue,
                                      startingContactIndex: UInt,
                                      maxNumberOfContacts: UInt,
                                      completion: @escaping (EncodedAddressBookChunk?) -> Void
         ) {
-        // here we are explicitly capturing self, this is executed on a queue that is
-        // never blocked indefinitely as this is the only function using it
-        groupQueue.dispatchGroup.async(on: addressBookProcessingQueue) {
-
-            let range: Range<UInt> = startingContactIndex..<(startingContactIndex+maxNumberOfContacts)
-            let cards = self.generateContactCards(range: range)
-
-            guard cards.count > 0 || startingContactIndex > 0 else {
-                // this should happen if I have zero contacts
-                groupQueue.performGroupedBlock({
-                    completion(nil)
-                })
-                return
-            }
-
-            let cardsRange = startingContactIndex..<(startingContactIndex+UInt(cards.count))
-            let encodedAB = EncodedAddressBookChunk(numberOfTotalContacts: self.numberOfContacts,
-                                                    otherContactsHashes: cards,
-                                                    includedContacts: cardsRange)
-            groupQueue.performGroupedBlock({
-                completion(encodedAB)
-            })
-        }
-    }
-
-    /// Generate contact cards for the given range of contacts
-    fileprivate func generateContactCards(range: Range<UInt>) -> [String: [String]] {
-        var cards = [String: [String]]()
-
-        self.contacts(range: range).enumerated().forEach {
-            let contact = $0.element
-            cards[contact.localIdentifier ?? "\($0.offset)"] = (contact.emailAddresses.map { $0.base64EncodedSHADigest })
-                + (contact.phoneNumbers.map { $0.base64EncodedSHADigest })
-        }
-        return cards
+        AddressBookChunkEncoder(addressBook: self, chunkSize: Swift.max(maxNumberOfContacts, 1))
+            .encodeChunk(groupQueue,
+                         startingContactIndex: startingContactIndex,
+                         maxNumberOfContacts: maxNumberOfContacts,
+                         completion: completion)
     }
 
     /// Returns contacts in a specific range
@@ -114,6 +87,7 @@ extension AddressBookAccessor {
         var contacts = [ZMAddressBookContact]()
 
         let maxElements = Int(range.upperBound - range.lowerBound)
+        guard maxElements > 0 else { return contacts }
         contacts.reserveCapacity(maxElements)
 
         var skipped: UInt = 0
@@ -149,9 +123,18 @@ class AddressBook {
     /// normalizer for phone numbers
     let phoneNumberNormalizer: AddressBook.Normalizer
 
-    init() {
+    /// - parameter normalizationCache: cache for normalized phone numbers, pass `nil`
+    ///     to always normalize with libPhoneNumber
+    init(normalizationCache: PhoneNumberNormalizationCache? = nil) {
         let libPhoneNumber = NBPhoneNumberUtil()
-        self.phoneNumberNormalizer = { libPhoneNumber.normalize(phoneNumber: $0)?.validatedPhoneNumber }
+        let normalizer: Normalizer = { libPhoneNumber.normalize(phoneNumber: $0)?.validatedPhoneNumber }
+
+        if let cache = normalizationCache {
+            cache.invalidateIfNeeded(region: libPhoneNumber.countryCodeByCarrier())
+            self.phoneNumberNormalizer = { cache.normalizedNumber(for: $0, normalizer: normalizer) }
+        } else {
+            self.phoneNumberNormalizer = normalizer
+        }
     }
 
     typealias Normalizer = (String) -> (String?)
@@ -159,12 +142,13 @@ class AddressBook {
 
     /// Will return an instance of the address book accessor best suited for the
     /// current OS version. Will return `nil` if the user did not grant access to the AB
-    static func factory() -> AddressBookAccessor? {
+    /// - parameter normalizationCache: cache for normalized phone numbers of the account
+    static func factory(normalizationCache: PhoneNumberNormalizationCache? = nil) -> AddressBookAccessor? {
         guard self.accessGranted() else {
             return nil
         }
 
-        return ContactAddressBook()
+        return ContactAddressBook(normalizationCache: normalizationCache)
     }
 
     /// Uses the passed in closure, or the standard method if the closure is nil, to
@@ -177,6 +161,188 @@ class AddressBook {
     }
 }
 
+// MARK: - Chunked encoding
+
+/// Encodes the address book in successive chunks, enumerating it only once
+final class AddressBookChunkEncoder {
+
+    private let addressBook: AddressBookAccessor
+    private let chunkSize: UInt
+
+    /// Valid contacts enumerated for `encodeChunk`, they're kept so that the following chunks
+    /// don't need to enumerate the address book again. Only accessed on the processing queue.
+    private var enumeratedContacts = [ZMAddressBookContact]()
+    private var isEnumerationComplete = false
+
+    /// - parameter chunkSize: maximum number of contacts in each chunk
+    init(addressBook: AddressBookAccessor, chunkSize: UInt) {
+        precondition(chunkSize > 0, "Chunk size must be positive")
+        self.addressBook = addressBook
+        self.chunkSize = chunkSize
+    }
+
+    /// Encodes the address book asynchronously.
+    /// - parameter groupQueue: group queue to enter while executing, and where to invoke callbacks
+    /// - parameter maxNumberOfContacts: do not include more than this number of contacts
+    /// - parameter cardKeying: how the cards of contacts without identifier are keyed
+    /// - parameter chunkHandler: closure invoked for each encoded chunk, in address book order
+    /// - parameter completion: closure invoked after the last chunk with the total number of encoded contacts
+    func encode(_ groupQueue: ZMSGroupQueue,
+                maxNumberOfContacts: UInt = .max,
+                cardKeying: AddressBookCardKeying = .position,
+                chunkHandler: @escaping (EncodedAddressBookChunk) -> Void,
+                completion: @escaping (_ numberOfEncodedContacts: UInt) -> Void) {
+
+        groupQueue.dispatchGroup.async(on: addressBookProcessingQueue) {
+            let numberOfTotalContacts = self.addressBook.numberOfContacts
+            var cursor: UInt = 0
+            var pendingContacts = [ZMAddressBookContact]()
+            pendingContacts.reserveCapacity(Int(min(self.chunkSize, maxNumberOfContacts)))
+
+            func flushPendingContacts() {
+                guard !pendingContacts.isEmpty else { return }
+
+                let includedContacts = cursor..<(cursor + UInt(pendingContacts.count))
+                let chunk = EncodedAddressBookChunk(numberOfTotalContacts: numberOfTotalContacts,
+                                                    otherContactsHashes: pendingContacts.contactCards(keying: cardKeying),
+                                                    includedContacts: includedContacts)
+                cursor = includedContacts.upperBound
+                pendingContacts.removeAll(keepingCapacity: true)
+
+                groupQueue.performGroupedBlock {
+                    chunkHandler(chunk)
+                }
+            }
+
+            if maxNumberOfContacts > 0 {
+                self.addressBook.enumerateValidContacts { contact in
+                    pendingContacts.append(contact)
+
+                    if pendingContacts.count == self.chunkSize {
+                        flushPendingContacts()
+                    }
+
+                    return cursor + UInt(pendingContacts.count) < maxNumberOfContacts
+                }
+
+                flushPendingContacts()
+            }
+
+            let numberOfEncodedContacts = cursor
+            groupQueue.performGroupedBlock {
+                completion(numberOfEncodedContacts)
+            }
+        }
+    }
+
+    /// Encodes one chunk of the address book asynchronously, for callers which request the chunks one
+    /// after the other. The contacts enumerated for a chunk are kept for the following ones.
+    /// - parameter completion: closure invoked with the chunk, or with nil if there are no contacts to upload.
+    ///     With a `maxNumberOfContacts` of 0 the chunk doesn't include any contact.
+    func encodeChunk(_ groupQueue: ZMSGroupQueue,
+                     startingContactIndex: UInt,
+                     maxNumberOfContacts: UInt,
+                     completion: @escaping (EncodedAddressBookChunk?) -> Void) {
+
+        groupQueue.dispatchGroup.async(on: addressBookProcessingQueue) {
+            let (end, overflow) = startingContactIndex.addingReportingOverflow(maxNumberOfContacts)
+            let endIndex = overflow ? UInt.max : end
+
+            // At least one contact is needed to tell an empty address book apart
+            self.enumerateContacts(upTo: Swift.max(endIndex, 1))
+
+            let numberOfEnumeratedContacts = UInt(self.enumeratedContacts.count)
+
+            guard numberOfEnumeratedContacts > 0 || startingContactIndex > 0 else {
+                // this should happen if I have zero contacts
+                groupQueue.performGroupedBlock {
+                    completion(nil)
+                }
+                return
+            }
+
+            let includedContacts = startingContactIndex..<Swift.max(startingContactIndex, Swift.min(endIndex, numberOfEnumeratedContacts))
+            let chunk = EncodedAddressBookChunk(numberOfTotalContacts: self.addressBook.numberOfContacts,
+                                                otherContactsHashes: Array(self.enumeratedContacts[Int(includedContacts.lowerBound)..<Int(includedContacts.upperBound)]).contactCards(),
+                                                includedContacts: includedContacts)
+
+            groupQueue.performGroupedBlock {
+                completion(chunk)
+            }
+        }
+    }
+
+    /// Enumerates the address book until `enumeratedContacts` holds `count` contacts or all of them.
+    /// Enumerating again skips the contacts enumerated already, so it goes at least twice as far as
+    /// before, which keeps the total work linear in the number of contacts.
+    /// Must be called on the processing queue.
+    private func enumerateContacts(upTo count: UInt) {
+        guard !isEnumerationComplete, UInt(enumeratedContacts.count) < count else { return }
+
+        let targetCount = Swift.max(count, UInt(enumeratedContacts.count) * 2)
+        var index: UInt = 0
+
+        addressBook.enumerateValidContacts { contact in
+            if index >= UInt(self.enumeratedContacts.count) {
+                self.enumeratedContacts.append(contact)
+            }
+
+            index += 1
+            return index < targetCount
+        }
+
+        isEnumerationComplete = index < targetCount
+    }
+}
+
+extension Array where Element == ZMAddressBookContact {
+
+    /// Maps contact identifiers to the hashes of their emails and phone numbers.
+    /// Hashing is spread across all available cores.
+    /// - parameter keying: how the cards of contacts without identifier are keyed
+    func contactCards(keying: AddressBookCardKeying = .position) -> [String: [String]] {
+        let contactCount = count
+        let batchSize = Swift.max(1, contactCount / (ProcessInfo.processInfo.activeProcessorCount * 4))
+        let numberOfBatches = (contactCount + batchSize - 1) / batchSize
+        var hashes = [[String]](repeating: [], count: contactCount)
+
+        hashes.withUnsafeMutableBufferPointer { buffer in
+            DispatchQueue.concurrentPerform(iterations: numberOfBatches) { batch in
+                let lowerBound = batch * batchSize
+                let upperBound = Swift.min(lowerBound + batchSize, contactCount)
+
+                for index in lowerBound..<upperBound {
+                    let contact = self[index]
+                    buffer[index] = contact.emailAddresses.map { $0.base64EncodedSHADigest }
+                        + contact.phoneNumbers.map { $0.base64EncodedSHADigest }
+                }
+            }
+        }
+
+        var cards = [String: [String]](minimumCapacity: contactCount)
+        for (index, contact) in enumerated() {
+            let key: String
+            switch keying {
+            case .position:
+                key = contact.localIdentifier ?? "\(index)"
+            case .content:
+                key = contact.localIdentifier ?? hashes[index].sorted().joined(separator: ",").base64EncodedSHADigest
+            }
+            cards[key] = hashes[index]
+        }
+        return cards
+    }
+}
+
+/// How the cards of contacts without a local identifier are keyed
+enum AddressBookCardKeying {
+    /// By the position of the contact in the encoded chunk, which is what the uploads use
+    case position
+    /// By a digest of the hashes of the contact, so that the key doesn't change when other
+    /// contacts are added or removed, which is what comparing with a previous upload needs
+    case content
+}
+
 // MARK: - Encoded address book chunk
 struct EncodedAddressBookChunk {
 
@@ -0,0 +1,208 @@
+//
+// Wire
+// Copyright (C) 2022 Wire Swiss GmbH
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see http://www.gnu.org/licenses/.
+//
+
+import Foundation
+
+private let zmLog = ZMSLog(tag: "AddressBook")
+
+/// Contact cards which changed since the last successful upload
+struct AddressBookCardDiff {
+
+    /// Cards of contacts which were not uploaded before
+    let addedCards: [String: [String]]
+
+    /// Cards of contacts which were uploaded with different hashes
+    let changedCards: [String: [String]]
+
+    /// Identifiers of uploaded contacts which are not in the address book anymore
+    let removedIdentifiers: Set<String>
+
+    /// Number of contacts which didn't change
+    let numberOfUnchangedCards: Int
+
+    /// Whether there was no previous upload, in which case all cards are added
+    let isFullUpload: Bool
+
+    var isEmpty: Bool {
+        return addedCards.isEmpty && changedCards.isEmpty && removedIdentifiers.isEmpty
+    }
+
+    /// Cards to send to the backend
+    var cardsToUpload: [String: [String]] {
+        return addedCards.merging(changedCards) { current, _ in current }
+    }
+
+    /// Fraction of the contacts which need to be uploaded or removed, between 0 and 1
+    var changeRatio: Double {
+        let numberOfChanges = addedCards.count + changedCards.count + removedIdentifiers.count
+        let total = numberOfChanges + numberOfUnchangedCards
+        return total == 0 ? 0 : Double(numberOfChanges) / Double(total)
+    }
+}
+
+/// Persists a digest of each contact card that was uploaded, keyed by the
+/// card identifier, so that later uploads only need to include the cards
+/// which changed.
+final class AddressBookUploadDigestStore {
+
+    private let fileURL: URL?
+    private let isolationQueue = DispatchQueue(label: "AddressBookUploadDigestStore")
+    private var digests: [String: String]
+
+    /// - parameter fileURL: where to persist the digests, `nil` keeps them in memory only
+    init(fileURL: URL?) {
+        self.fileURL = fileURL
+        self.digests = fileURL.flatMap(Self.loadDigests) ?? [:]
+    }
+
+    /// Location of the store in the given account container
+    static func fileURL(in accountContainer: URL) -> URL {
+        return accountContainer.appendingPathComponent("address-book-upload.json")
+    }
+
+    /// Number of contacts known to be uploaded
+    var count: Int {
+        return isolationQueue.sync { digests.count }
+    }
+
+    /// Compares the cards of the whole address book with the last uploaded state
+    func diff(with cards: [String: [String]]) -> AddressBookCardDiff {
+        let uploadedDigests = isolationQueue.sync { digests }
+
+        var addedCards = [String: [String]]()
+        var changedCards = [String: [String]]()
+        var numberOfUnchangedCards = 0
+
+        for (identifier, hashes) in cards {
+            switch uploadedDigests[identifier] {
+            case nil:
+                addedCards[identifier] = hashes
+            case Self.digest(of: hashes):
+                numberOfUnchangedCards += 1
+            default:
+                changedCards[identifier] = hashes
+            }
+        }
+
+        let removedIdentifiers = Set(uploadedDigests.keys).subtracting(cards.keys)
+
+        let diff = AddressBookCardDiff(addedCards: addedCards,
+                                       changedCards: changedCards,
+                                       removedIdentifiers: removedIdentifiers,
+                                       numberOfUnchangedCards: numberOfUnchangedCards,
+                                       isFullUpload: uploadedDigests.isEmpty)
+
+        zmLog.info("Address book diff: \(addedCards.count) added, \(changedCards.count) changed, \(removedIdentifiers.count) removed, \(numberOfUnchangedCards) unchanged, change ratio \(String(format: "%.2f", diff.changeRatio))")
+
+        return diff
+    }
+
+    /// Records that the cards of the diff were uploaded successfully
+    func markAsUploaded(_ diff: AddressBookCardDiff) {
+        isolationQueue.sync {
+            for (identifier, hashes) in diff.cardsToUpload {
+                digests[identifier] = Self.digest(of: hashes)
+            }
+            diff.removedIdentifiers.forEach { digests.removeValue(forKey: $0) }
+            save()
+        }
+    }
+
+    /// Forgets about all uploaded cards, so that the next diff results in a full upload
+    func reset() {
+        isolationQueue.sync {
+            digests.removeAll()
+            save()
+        }
+    }
+
+    // MARK: - Digest
+
+    private static func digest(of hashes: [String]) -> String {
+        return hashes.sorted().joined(separator: ",").base64EncodedSHADigest
+    }
+
+    // MARK: - Persistence
+
+    private static func loadDigests(from url: URL) -> [String: String]? {
+        guard let data = try? Data(contentsOf: url) else { return nil }
+        return try? JSONDecoder().decode([String: String].self, from: data)
+    }
+
+    /// Must be called on the isolation queue
+    private func save() {
+        guard var url = fileURL else { return }
+
+        do {
+            let data = try JSONEncoder().encode(digests)
+            try data.write(to: url, options: [.atomic, .completeFileProtectionUntilFirstUserAuthentication])
+
+            var resourceValues = URLResourceValues()
+            resourceValues.isExcludedFromBackup = true
+            try url.setResourceValues(resourceValues)
+        } catch {
+            zmLog.error("Failed to persist address book upload digests: \(error.localizedDescription)")
+        }
+    }
+
+}
+
+extension AddressBookChunkEncoder {
+
+    /// Encodes the whole address book and compares it with the last upload recorded in the store.
+    /// If nothing was uploaded before, the diff contains all cards. Contacts without identifier are
+    /// keyed by content here, so that their keys can be compared across uploads.
+    /// - parameter groupQueue: group queue to enter while executing, and where to invoke the callback
+    func encodeDiff(_ groupQueue: ZMSGroupQueue,
+                    against store: AddressBookUploadDigestStore,
+                    completion: @escaping (AddressBookCardDiff) -> Void) {
+        var cards = [String: [String]]()
+
+        encode(groupQueue, cardKeying: .content, chunkHandler: { chunk in
+            cards.merge(chunk.otherContactsHashes) { _, new in new }
+        }, completion: { _ in
+            completion(store.diff(with: cards))
+        })
+    }
+
+}
+
+extension ZMUserSession {
+
+    /// Number of contacts encoded at once when looking for the address book changes
+    static let addressBookUploadChunkSize: UInt = 1000
+
+    /// Encodes the cards of the address book which changed since the last upload. The completion
+    /// is called on the sync context, with nil if the user did not grant access to the address book.
+    /// Once the cards are uploaded, call `markAddressBookCardsAsUploaded(_:)`.
+    func encodeAddressBookChangesForUpload(completion: @escaping (AddressBookCardDiff?) -> Void) {
+        guard let addressBook = AddressBook.factory(normalizationCache: phoneNumberNormalizationCache) else {
+            syncManagedObjectContext.performGroupedBlock { completion(nil) }
+            return
+        }
+
+        let encoder = AddressBookChunkEncoder(addressBook: addressBook, chunkSize: Self.addressBookUploadChunkSize)
+        encoder.encodeDiff(syncManagedObjectContext, against: addressBookUploadDigestStore, completion: completion)
+    }
+
+    /// Records that the cards of the diff were uploaded successfully
+    func markAddressBookCardsAsUploaded(_ diff: AddressBookCardDiff) {
+        addressBookUploadDigestStore.markAsUploaded(diff)
+    }
+
+}
@@ -0,0 +1,164 @@
+//
+// Wire
+// Copyright (C) 2022 Wire Swiss GmbH
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see http://www.gnu.org/licenses/.
+//
+
+import Foundation
+
+private let zmLog = ZMSLog(tag: "AddressBook")
+
+/// Remembers the result of normalizing raw address book phone numbers, which is
+/// expensive with libPhoneNumber. The content is persisted between launches in the
+/// account container and discarded when the carrier region, which the normalization
+/// depends on, changes. Raw numbers are only stored as digests.
+final class PhoneNumberNormalizationCache {
+
+    private struct Content: Codable {
+        var region: String?
+        /// Maps digests of raw numbers to normalized numbers, or to an empty
+        /// string when the raw number could not be normalized
+        var numbers: [String: String]
+    }
+
+    /// Delay before writing new entries to disk, so that enumerating
+    /// the address book results in a single write
+    static let persistenceDelay: TimeInterval = 2
+
+    private let fileURL: URL?
+    private let maximumCount: Int
+    private let isolationQueue = DispatchQueue(label: "PhoneNumberNormalizationCache")
+    private var content: Content
+    private var isSaveScheduled = false
+
+    /// - parameter fileURL: where to persist the cache, `nil` keeps it in memory only
+    /// - parameter maximumCount: number of entries above which some are evicted
+    init(fileURL: URL?, maximumCount: Int = 10_000) {
+        self.fileURL = fileURL
+        self.maximumCount = maximumCount
+        self.content = fileURL.flatMap(Self.loadContent) ?? Content(region: nil, numbers: [:])
+    }
+
+    /// Location of the cache in the given account container
+    static func fileURL(in accountContainer: URL) -> URL {
+        return accountContainer.appendingPathComponent("phone-number-normalization.json")
+    }
+
+    var count: Int {
+        return isolationQueue.sync { content.numbers.count }
+    }
+
+    /// Discards all entries if they were normalized for a different carrier region
+    func invalidateIfNeeded(region: String?) {
+        isolationQueue.sync {
+            guard content.region != region else { return }
+
+            if !content.numbers.isEmpty {
+                zmLog.info("Carrier region changed, discarding \(content.numbers.count) normalized phone numbers")
+            }
+
+            content = Content(region: region, numbers: [:])
+            scheduleSave()
+        }
+    }
+
+    /// Returns the cached normalization of the raw number, or normalizes and caches it
+    func normalizedNumber(for rawNumber: String, normalizer: AddressBook.Normalizer) -> String? {
+        let key = rawNumber.base64EncodedSHADigest
+
+        if let cached = isolationQueue.sync(execute: { content.numbers[key] }) {
+            return cached.isEmpty ? nil : cached
+        }
+
+        let normalized = normalizer(rawNumber)
+
+        isolationQueue.sync {
+            evictIfNeeded()
+            content.numbers[key] = normalized ?? ""
+            scheduleSave()
+        }
+
+        return normalized
+    }
+
+    /// Writes pending changes to disk immediately
+    func persist() {
+        isolationQueue.sync {
+            save()
+        }
+    }
+
+    /// Discards all entries and deletes the persisted cache
+    func delete() {
+        isolationQueue.sync {
+            content = Content(region: nil, numbers: [:])
+            isSaveScheduled = false
+
+            guard let fileURL = fileURL, FileManager.default.fileExists(atPath: fileURL.path) else { return }
+
+            do {
+                try FileManager.default.removeItem(at: fileURL)
+            } catch {
+                zmLog.error("Failed to delete normalized phone numbers: \(error.localizedDescription)")
+            }
+        }
+    }
+
+    /// Must be called on the isolation queue. Drops a quarter of the entries, in no
+    /// particular order, when the cache is full.
+    private func evictIfNeeded() {
+        guard content.numbers.count >= maximumCount else { return }
+
+        let evictedKeys = Array(content.numbers.keys.prefix(max(1, maximumCount / 4)))
+        evictedKeys.forEach { content.numbers.removeValue(forKey: $0) }
+    }
+
+    // MARK: - Persistence
+
+    private static func loadContent(from url: URL) -> Content? {
+        guard let data = try? Data(contentsOf: url) else { return nil }
+        return try? JSONDecoder().decode(Content.self, from: data)
+    }
+
+    /// Must be called on the isolation queue
+    private func scheduleSave() {
+        guard fileURL != nil, !isSaveScheduled else { return }
+
+        isSaveScheduled = true
+        isolationQueue.asyncAfter(deadline: .now() + Self.persistenceDelay) { [weak self] in
+            self?.save()
+        }
+    }
+
+    /// Must be called on the isolation queue
+    private func save() {
+        guard let fileURL = fileURL, isSaveScheduled else { return }
+
+        isSaveScheduled = false
+
+        do {
+            var url = fileURL
+            let data = try JSONEncoder().encode(content)
+            try data.write(to: url, options: [.atomic, .completeFileProtectionUntilFirstUserAuthentication])
+
+            var resourceValues = URLResourceValues()
+            resourceValues.isExcludedFromBackup = true
+            try url.setResourceValues(resourceValues)
+        } catch {
+            zmLog.error("Failed to persist normalized phone numbers: \(error.localizedDescription)")
+        }
+    }
+
+}
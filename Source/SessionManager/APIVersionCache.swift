@@ -0,0 +1,74 @@
+//
+// Wire
+// Copyright (C) 2022 Wire Swiss GmbH
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see http://www.gnu.org/licenses/.
+//
+
+import Foundation
+
+/// Stores the last `/api-version` response of a backend, so that the API version
+/// can be resolved without waiting for the backend and the response can be
+/// revalidated with a conditional request.
+struct APIVersionCache {
+
+    struct Entry: Codable, Equatable {
+
+        /// The body of the response
+        let payload: Data
+
+        /// The `ETag` header of the response
+        let entityTag: String?
+
+        /// The `Last-Modified` header of the response
+        let lastModified: String?
+
+        /// When the response was received or last revalidated
+        let date: Date
+
+        func isFresh(maxAge: TimeInterval, now: Date = Date()) -> Bool {
+            return now.timeIntervalSince(date) < maxAge
+        }
+
+        func revalidated(at date: Date = Date()) -> Entry {
+            return Entry(payload: payload, entityTag: entityTag, lastModified: lastModified, date: date)
+        }
+
+    }
+
+    private let userDefaults: UserDefaults
+    private let key: String
+
+    init(userDefaults: UserDefaults = .standard, backendURL: URL) {
+        self.userDefaults = userDefaults
+        self.key = "APIVersionCache_\(backendURL.absoluteString)"
+    }
+
+    var entry: Entry? {
+        get {
+            guard let data = userDefaults.data(forKey: key) else { return nil }
+            return try? JSONDecoder().decode(Entry.self, from: data)
+        }
+
+        nonmutating set {
+            guard let entry = newValue, let data = try? JSONEncoder().encode(entry) else {
+                userDefaults.removeObject(forKey: key)
+                return
+            }
+
+            userDefaults.set(data, forKey: key)
+        }
+    }
+
+}
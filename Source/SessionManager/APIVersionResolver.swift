@@ -19,10 +19,15 @@
 import Foundation
 import WireTransport
 
+private let zmLog = ZMSLog(tag: "APIVersion")
+
 final class APIVersionResolver {
 
     // MARK: - Properties
 
+    /// For how long a cached response is used without waiting for the backend
+    static let cacheMaxAge: TimeInterval = 24 * 60 * 60
+
     weak var delegate: APIVersionResolverDelegate?
 
     let clientProdVersions: Set<APIVersion>
@@ -31,6 +36,7 @@ final class APIVersionResolver {
 
     private let queue: ZMSGroupQueue = DispatchGroupQueue(queue: .main)
     private let transportSession: UnauthenticatedTransportSessionProtocol
+    private let cache: APIVersionCache?
 
     // MARK: - Life cycle
 
@@ -38,26 +44,56 @@ final class APIVersionResolver {
         clientProdVersions: Set<APIVersion> = APIVersion.productionVersions,
         clientDevVersions: Set<APIVersion> = APIVersion.developmentVersions,
         transportSession: UnauthenticatedTransportSessionProtocol,
-        isDeveloperModeEnabled: Bool
+        isDeveloperModeEnabled: Bool,
+        cache: APIVersionCache? = nil
     ) {
         self.clientProdVersions = clientProdVersions
         self.clientDevVersions = clientDevVersions
         self.transportSession = transportSession
         self.isDeveloperModeEnabled = isDeveloperModeEnabled
+        self.cache = cache
     }
 
     // MARK: - Methods
 
+    /// Resolves the API version from the `/api-version` response of the backend.
+    ///
+    /// If a version was resolved from a cached response less than `cacheMaxAge` ago, the completion
+    /// is called right away and the response is revalidated in the background. The delegate is
+    /// notified if the revalidated response resolves differently.
     func resolveAPIVersion(completion: @escaping (Error?) -> Void = { _ in }) {
-        // TODO: check if it's been 24hours and proceed or not
-        sendRequest(completion: completion)
+        guard
+            BackendInfo.apiVersion != nil,
+            let cachedEntry = cache?.entry,
+            cachedEntry.isFresh(maxAge: Self.cacheMaxAge)
+        else {
+            sendRequest(isRevalidation: false, completion: completion)
+            return
+        }
+
+        zmLog.debug("using API version resolved \(-Int(cachedEntry.date.timeIntervalSinceNow))s ago, revalidating")
+        queue.performGroupedBlock {
+            completion(nil)
+        }
+
+        sendRequest(isRevalidation: true)
     }
 
-    private func sendRequest(completion: @escaping (Error?) -> Void = {_ in }) {
+    private func sendRequest(isRevalidation: Bool, completion: @escaping (Error?) -> Void = {_ in }) {
         // This is endpoint isn't versioned, so it always version 0.
         let request = ZMTransportRequest(getFromPath: "/api-version", apiVersion: APIVersion.v0.rawValue)
+        let cachedEntry = cache?.entry
+
+        if let entityTag = cachedEntry?.entityTag {
+            request.addValue(entityTag, forAdditionalHeaderField: "If-None-Match")
+        }
+
+        if let lastModified = cachedEntry?.lastModified {
+            request.addValue(lastModified, forAdditionalHeaderField: "If-Modified-Since")
+        }
+
         let completionHandler = ZMCompletionHandler(on: queue) { [weak self] response in
-            self?.handleResponse(response)
+            self?.handleResponse(response, cachedEntry: cachedEntry, isRevalidation: isRevalidation)
             completion(response.transportSessionError)
         }
 
@@ -66,18 +102,42 @@ final class APIVersionResolver {
 
     }
 
-    private func handleResponse(_ response: ZMTransportResponse) {
+    private func handleResponse(_ response: ZMTransportResponse, cachedEntry: APIVersionCache.Entry?, isRevalidation: Bool) {
+        if response.httpStatus == 304, let cachedEntry = cachedEntry {
+            cache?.entry = cachedEntry.revalidated()
+            handlePayload(cachedEntry.payload)
+            return
+        }
+
         guard response.result == .success else {
+            if isRevalidation && response.result != .permanentError {
+                // Keep the version resolved from the cached response until the backend can be reached
+                return
+            }
+
+            cache?.entry = nil
             BackendInfo.apiVersion = .v0
             BackendInfo.domain = "wire.com"
             BackendInfo.isFederationEnabled = false
             return
         }
 
-        guard
-            let data = response.rawData,
-            let payload = APIVersionResponsePayload(data)
-        else {
+        guard let data = response.rawData else {
+            fatalError()
+        }
+
+        cache?.entry = APIVersionCache.Entry(
+            payload: data,
+            entityTag: response.headerValue(for: "ETag"),
+            lastModified: response.headerValue(for: "Last-Modified"),
+            date: Date()
+        )
+
+        handlePayload(data)
+    }
+
+    private func handlePayload(_ data: Data) {
+        guard let payload = APIVersionResponsePayload(data) else {
             fatalError()
         }
 
@@ -147,6 +207,15 @@ final class APIVersionResolver {
 
 }
 
+private extension ZMTransportResponse {
+
+    func headerValue(for field: String) -> String? {
+        let header = headers?.first { ($0.key as? String)?.caseInsensitiveCompare(field) == .orderedSame }
+        return header?.value as? String
+    }
+
+}
+
 // MARK: - Delegate
 
 protocol APIVersionResolverDelegate: AnyObject {
@@ -0,0 +1,176 @@
+//
+// Wire
+// Copyright (C) 2022 Wire Swiss GmbH
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see http://www.gnu.org/licenses/.
+//
+
+import Foundation
+
+private let zmLog = ZMSLog(tag: "MessageRetention")
+
+/// Counts the messages deleted by a `MessageRetentionPurger` and how long each batch took.
+public struct MessageRetentionPurgeStatistics: CustomStringConvertible {
+
+    /// Number of batches which were deleted and saved
+    public private(set) var numberOfBatches = 0
+
+    /// Number of messages which were deleted
+    public private(set) var numberOfDeletedMessages = 0
+
+    /// Time spent deleting and saving the batches, without the time spent waiting in between
+    public private(set) var totalBatchDuration: TimeInterval = 0
+
+    /// Time spent on the slowest batch
+    public private(set) var maximumBatchDuration: TimeInterval = 0
+
+    public var averageBatchDuration: TimeInterval? {
+        guard numberOfBatches > 0 else { return nil }
+        return totalBatchDuration / TimeInterval(numberOfBatches)
+    }
+
+    /// Number of messages deleted per second of batch duration
+    public var throughput: Double? {
+        guard totalBatchDuration > 0 else { return nil }
+        return Double(numberOfDeletedMessages) / totalBatchDuration
+    }
+
+    mutating func recordBatch(deletedMessages: Int, duration: TimeInterval) {
+        numberOfBatches += 1
+        numberOfDeletedMessages += deletedMessages
+        totalBatchDuration += duration
+        maximumBatchDuration = max(maximumBatchDuration, duration)
+    }
+
+    public var description: String {
+        let average = averageBatchDuration.map { "\(Int($0 * 1000))ms" } ?? "-"
+        let throughput = self.throughput.map { "\(Int($0))/s" } ?? "-"
+        return "\(numberOfDeletedMessages) message(s) in \(numberOfBatches) batch(es), \(average) per batch, max \(Int(maximumBatchDuration * 1000))ms, \(throughput)"
+    }
+
+}
+
+/// Deletes the messages older than a date in batches of the oldest messages, saving after each
+/// batch. Each batch is deleted in its own block on the context, so that the work scheduled on
+/// the context in the meantime, like processing events, doesn't wait for the whole purge.
+///
+/// The server timestamp up to which all messages were deleted is stored in the metadata of the
+/// persistent store, so that the next purge first looks for messages newer than that. Messages
+/// which were inserted below it since are still deleted, once no newer ones are left.
+final class MessageRetentionPurger {
+
+    static let defaultBatchSize = 500
+
+    private static let lowWaterMarkKey = "MessageRetentionPurgeLowWaterMark"
+    private static let serverTimestampKey = #keyPath(ZMMessage.serverTimestamp)
+
+    private let context: NSManagedObjectContext
+    private let batchSize: Int
+    private var statistics = MessageRetentionPurgeStatistics()
+
+    init(context: NSManagedObjectContext, batchSize: Int = defaultBatchSize) {
+        self.context = context
+        self.batchSize = batchSize
+    }
+
+    /// Deletes the messages older than `cutoff` and calls the completion on the context once they are all deleted.
+    func deleteMessages(olderThan cutoff: Date, completion: @escaping (MessageRetentionPurgeStatistics) -> Void = { _ in }) {
+        context.performGroupedBlock {
+            self.deleteNextBatch(olderThan: cutoff, completion: completion)
+        }
+    }
+
+    private func deleteNextBatch(olderThan cutoff: Date, completion: @escaping (MessageRetentionPurgeStatistics) -> Void) {
+        let startDate = Date()
+
+        guard let batchEnd = endOfNextBatch(olderThan: cutoff) else {
+            completion(statistics)
+            return
+        }
+
+        do {
+            let fetchRequest = NSFetchRequest<ZMMessage>(entityName: ZMMessage.entityName())
+            fetchRequest.predicate = NSPredicate(format: "%K < %@", Self.serverTimestampKey, batchEnd as NSDate)
+            let deletedMessages = try context.count(for: fetchRequest)
+
+            try ZMMessage.deleteMessagesOlderThan(batchEnd, context: context)
+            lowWaterMark = batchEnd
+            context.saveOrRollback()
+
+            statistics.recordBatch(deletedMessages: deletedMessages, duration: -startDate.timeIntervalSinceNow)
+        } catch {
+            zmLog.error("Failed to delete messages older than the retention limit: \(error)")
+            completion(statistics)
+            return
+        }
+
+        context.performGroupedBlock {
+            self.deleteNextBatch(olderThan: cutoff, completion: completion)
+        }
+    }
+
+    /// The server timestamp before which the next batch of messages are, or nil if there are no messages left to delete
+    private func endOfNextBatch(olderThan cutoff: Date) -> Date? {
+        var predicate = NSPredicate(format: "%K < %@", Self.serverTimestampKey, cutoff as NSDate)
+
+        if let lowWaterMark = lowWaterMark {
+            let newerThanLowWaterMark = NSPredicate(format: "%K >= %@", Self.serverTimestampKey, lowWaterMark as NSDate)
+            predicate = NSCompoundPredicate(andPredicateWithSubpredicates: [predicate, newerThanLowWaterMark])
+        }
+
+        let fetchRequest = NSFetchRequest<NSDictionary>(entityName: ZMMessage.entityName())
+        fetchRequest.predicate = predicate
+        fetchRequest.sortDescriptors = [NSSortDescriptor(key: Self.serverTimestampKey, ascending: true)]
+        fetchRequest.resultType = .dictionaryResultType
+        fetchRequest.propertiesToFetch = [Self.serverTimestampKey]
+        fetchRequest.fetchLimit = batchSize + 1
+
+        let timestamps = context.fetchOrAssert(request: fetchRequest).compactMap { $0[Self.serverTimestampKey] as? Date }
+
+        guard let oldestTimestamp = timestamps.first else {
+            // Messages can be inserted below the low water mark after a purge, e.g. when
+            // importing a backup. They're rare, so they're only looked for once the range is empty.
+            guard let lowWaterMark = lowWaterMark, containsMessages(olderThan: min(lowWaterMark, cutoff)) else { return nil }
+
+            self.lowWaterMark = nil
+            return endOfNextBatch(olderThan: cutoff)
+        }
+        guard timestamps.count > batchSize, let newestTimestamp = timestamps.last else { return cutoff }
+
+        // Messages with the same timestamp as the first message after the batch are deleted with the
+        // next batch, unless the whole batch has the same timestamp.
+        return max(newestTimestamp, min(oldestTimestamp.addingTimeInterval(0.001), cutoff))
+    }
+
+    private func containsMessages(olderThan date: Date) -> Bool {
+        let fetchRequest = NSFetchRequest<ZMMessage>(entityName: ZMMessage.entityName())
+        fetchRequest.predicate = NSPredicate(format: "%K < %@", Self.serverTimestampKey, date as NSDate)
+        fetchRequest.fetchLimit = 1
+
+        return ((try? context.count(for: fetchRequest)) ?? 0) > 0
+    }
+
+    private var lowWaterMark: Date? {
+        get {
+            guard let timeInterval = context.storedValue(key: Self.lowWaterMarkKey) as? NSNumber else { return nil }
+            return Date(timeIntervalSinceReferenceDate: timeInterval.doubleValue)
+        }
+
+        set {
+            let timeInterval = newValue.map { NSNumber(value: $0.timeIntervalSinceReferenceDate) }
+            context.store(value: timeInterval, key: Self.lowWaterMarkKey)
+        }
+    }
+
+}
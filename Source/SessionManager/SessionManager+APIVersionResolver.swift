@@ -43,7 +43,8 @@ extension SessionManager: APIVersionResolverDelegate {
 
         let apiVersionResolver = APIVersionResolver(
             transportSession: transportSession,
-            isDeveloperModeEnabled: isDeveloperModeEnabled
+            isDeveloperModeEnabled: isDeveloperModeEnabled,
+            cache: APIVersionCache(backendURL: environment.backendURL)
         )
 
         apiVersionResolver.delegate = self
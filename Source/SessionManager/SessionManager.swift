@@ -405,6 +405,14 @@ public final class SessionManager: NSObject, SessionManagerType {
                 name: UIApplication.didBecomeActiveNotification,
                 object: nil
             )
+        NotificationCenter
+            .default
+            .addObserver(
+                self,
+                selector: #selector(applicationDidEnterBackground(_:)),
+                name: UIApplication.didEnterBackgroundNotification,
+                object: nil
+            )
     }
 
     init(maxNumberAccounts: Int = defaultMaxNumberAccounts,
@@ -893,12 +901,9 @@ public final class SessionManager: NSObject, SessionManagerType {
 
         log.debug("Deleting messages older than the retention limit = \(messageRetentionInternal)")
 
-        contextProvider.syncContext.performGroupedBlock {
-            do {
-                try ZMMessage.deleteMessagesOlderThan(Date(timeIntervalSinceNow: -messageRetentionInternal), context: contextProvider.syncContext)
-            } catch {
-                log.error("Failed to delete messages older than the retention limit")
-            }
+        let purger = MessageRetentionPurger(context: contextProvider.syncContext)
+        purger.deleteMessages(olderThan: Date(timeIntervalSinceNow: -messageRetentionInternal)) { statistics in
+            log.debug("Deleted messages older than the retention limit: \(statistics)")
         }
     }
 
@@ -1281,6 +1286,10 @@ extension SessionManager {
         notificationsTracker?.dispatchEvent()
     }
 
+    @objc fileprivate func applicationDidEnterBackground(_ note: Notification) {
+        notificationsTracker?.flush()
+    }
+
 }
 
 // MARK: - Unread Conversation Count
@@ -48,6 +48,9 @@ import WireDataModel
 
     private let isolationQueue = DispatchQueue(label: "EventProcessing")
 
+    /// Increments are collected here and folded into the attributes when they are read
+    private let counters = AnalyticsCounters<Attributes>()
+
     public override init() {
         super.init()
     }
@@ -73,34 +76,37 @@ import WireDataModel
     }
 
     private func increment(attribute: Attributes, by amount: Int = 1) {
-        isolationQueue.sync {
-            var currentAttributes = persistedAttributes(for: eventName)
-            var value = (currentAttributes[attribute.identifier] as? Int) ?? 0
-            value += amount
-            currentAttributes[attribute.identifier] = value as NSObject
-            setPersistedAttributes(currentAttributes, for: eventName)
-        }
+        counters.increment(attribute, by: amount)
     }
 
-    private func save(attribute: Attributes, value: Int) {
-        isolationQueue.sync {
-            var currentAttributes = persistedAttributes(for: eventName)
-            var currentValue = (currentAttributes[attribute.identifier] as? Int) ?? 0
-            currentValue = value
-            currentAttributes[attribute.identifier] = currentValue as NSObject
-            setPersistedAttributes(currentAttributes, for: eventName)
+    /// Must be called on the isolation queue
+    private func flushCounters() {
+        let counts = counters.drain()
+
+        guard !counts.isEmpty else { return }
+
+        var currentAttributes = storedAttributes(for: eventName)
+
+        for (attribute, amount) in counts {
+            let value = (currentAttributes[attribute.identifier] as? Int) ?? 0
+            currentAttributes[attribute.identifier] = (value + amount) as NSObject
         }
+
+        setPersistedAttributes(currentAttributes, for: eventName)
     }
 
     public func dispatchEvent() {
         isolationQueue.sync {
-            let attributes = persistedAttributes(for: eventName)
+            flushCounters()
+
+            let attributes = storedAttributes(for: eventName)
             if !attributes.isEmpty {
                 setPersistedAttributes(nil, for: eventName)
             }
         }
     }
 
+    /// Must be called on the isolation queue
     private func setPersistedAttributes(_ attributes: [String: NSObject]?, for event: String) {
         if let attributes = attributes {
             eventAttributes[event] = attributes
@@ -109,15 +115,19 @@ import WireDataModel
         }
     }
 
-    public func persistedAttributes(for event: String) -> [String: NSObject] {
+    /// Must be called on the isolation queue
+    private func storedAttributes(for event: String) -> [String: NSObject] {
         return eventAttributes[event] ?? [:]
     }
 
-    override public var debugDescription: String {
-        let description = isolationQueue.sync {
-            "\(persistedAttributes(for: eventName))"
+    public func persistedAttributes(for event: String) -> [String: NSObject] {
+        return isolationQueue.sync {
+            flushCounters()
+            return storedAttributes(for: event)
         }
+    }
 
-        return description
+    override public var debugDescription: String {
+        return "\(persistedAttributes(for: eventName))"
     }
 }
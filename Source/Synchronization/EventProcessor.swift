@@ -24,6 +24,18 @@ extension NSNotification.Name {
     static let calculateBadgeCount = NSNotification.Name(rawValue: "calculateBadgeCountNotication")
 }
 
+/// An event consumer which looks up the objects it needs for a whole batch of events at once,
+/// before the events of the batch are passed to it one by one.
+protocol BatchPrefetchingEventConsumer: ZMEventConsumer {
+
+    /// Called before the events are processed
+    func prefetchObjects(toProcessEvents events: [ZMUpdateEvent])
+
+    /// Called after all events of the batch were processed, the prefetched objects can be released
+    func didProcessEvents()
+
+}
+
 class EventProcessor: UpdateEventProcessor {
 
     private static let logger = Logger(subsystem: "VoIP Push", category: "EventProcessor")
@@ -119,6 +131,8 @@ class EventProcessor: UpdateEventProcessor {
             let date = Date()
             let fetchRequest = prefetchRequest(updateEvents: decryptedUpdateEvents)
             let prefetchResult = syncContext.executeFetchRequestBatchOrAssert(fetchRequest)
+            let batchPrefetchingConsumers = self.eventConsumers.compactMap { $0 as? BatchPrefetchingEventConsumer }
+            batchPrefetchingConsumers.forEach { $0.prefetchObjects(toProcessEvents: decryptedUpdateEvents) }
 
             Logging.eventProcessing.info("Consuming: [\n\(decryptedUpdateEvents.map({ "\tevent: \(ZMUpdateEvent.eventTypeString(for: $0.type) ?? "Unknown")" }).joined(separator: "\n"))\n]")
 
@@ -128,6 +142,7 @@ class EventProcessor: UpdateEventProcessor {
                 }
                 self.eventProcessingTracker.registerEventProcessed()
             }
+            batchPrefetchingConsumers.forEach { $0.didProcessEvents() }
             ZMConversation.calculateLastUnreadMessages(in: syncContext)
             syncContext.saveOrRollback()
 
@@ -0,0 +1,71 @@
+//
+// Wire
+// Copyright (C) 2022 Wire Swiss GmbH
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see http://www.gnu.org/licenses/.
+//
+
+import Foundation
+
+private let zmLog = ZMSLog(tag: "SyncStatus")
+
+/// Persists a digest of the last payload of a resource which was applied to the database,
+/// so that a later slow sync can skip applying the resource if it didn't change.
+///
+/// The digests are stored in the metadata of the persistent store, so they are saved
+/// together with the objects they describe and are gone when the database is reset.
+/// A digest must be invalidated whenever the local objects are modified by anything
+/// other than the payload, e.g. by an update event or a local change.
+final class SlowSyncFingerprints {
+
+    enum Resource: String, CaseIterable {
+        case labels
+        case teamMembers
+        case teamRoles
+    }
+
+    private let keyValueStore: KeyValueStore
+
+    init(keyValueStore: KeyValueStore) {
+        self.keyValueStore = keyValueStore
+    }
+
+    /// Whether the payload is the same as the one last applied for the resource
+    func isUnchanged(_ payload: Data, for resource: Resource) -> Bool {
+        guard let storedDigest = keyValueStore.storedValue(key: Self.key(for: resource)) as? Data else { return false }
+
+        let isUnchanged = storedDigest == payload.zmSHA256Digest()
+
+        if isUnchanged {
+            zmLog.info("\(resource) didn't change since the last slow sync, skipping \(payload.count) bytes")
+        }
+
+        return isUnchanged
+    }
+
+    /// Records that the payload was applied for the resource
+    func update(_ payload: Data, for resource: Resource) {
+        keyValueStore.store(value: payload.zmSHA256Digest() as NSData, key: Self.key(for: resource))
+    }
+
+    /// Makes sure the next payload of the resource is applied
+    func invalidate(_ resource: Resource) {
+        keyValueStore.store(value: nil, key: Self.key(for: resource))
+    }
+
+    private static func key(for resource: Resource) -> String {
+        return "SlowSyncFingerprint_\(resource.rawValue)"
+    }
+
+}
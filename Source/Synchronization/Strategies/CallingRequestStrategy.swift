@@ -39,10 +39,19 @@ public final class CallingRequestStrategy: AbstractRequestStrategy, ZMSingleRequ
     private var callConfigCompletion: CallConfigRequestCompletion?
 
     private var clientDiscoverySync: ZMSingleRequestSync! = nil
-    private var clientDiscoveryRequest: ClientDiscoveryRequest?
+    private(set) var clientDiscoveryQueue = ClientDiscoveryQueue()
 
     private let ephemeralURLSession = URLSession(configuration: .ephemeral)
 
+    /// Object IDs of the conversations and clients calling messages are sent to, so that
+    /// signalling messages during a call don't need to fetch them again
+    private var callConversationObjectIDs = [AVSIdentifier: NSManagedObjectID]()
+    private var callClientObjectIDs = [AVSClient: NSManagedObjectID]()
+    private let maxCachedCallClients = 1000
+
+    /// Time from AVS handing over calling messages to scheduling them, only accessed on the sync context
+    private(set) var callingMessageSchedulingStatistics = CallingMessageSchedulingStatistics()
+
     // MARK: - Internal Properties
 
     var callCenter: WireCallCenterV3?
@@ -93,6 +102,10 @@ public final class CallingRequestStrategy: AbstractRequestStrategy, ZMSingleRequ
 
     public func dropPendingCallMessages(for conversation: ZMConversation) {
         messageSync.expireMessages(withDependency: conversation)
+
+        if let conversationId = conversation.avsIdentifier {
+            callConversationObjectIDs.removeValue(forKey: conversationId)
+        }
     }
 
     // MARK: - Single Request Transcoder
@@ -112,7 +125,7 @@ public final class CallingRequestStrategy: AbstractRequestStrategy, ZMSingleRequ
 
         case clientDiscoverySync:
             guard
-                let request = clientDiscoveryRequest,
+                let request = clientDiscoveryQueue.nextRequest,
                 let selfClient = ZMUser.selfUser(in: managedObjectContext).selfClient()
             else {
                 return nil
@@ -123,8 +136,8 @@ public final class CallingRequestStrategy: AbstractRequestStrategy, ZMSingleRequ
             let factory = ClientMessageRequestFactory()
 
             return factory.upstreamRequestForFetchingClients(
-                conversationId: request.conversationId,
-                domain: request.domain,
+                conversationId: request.conversationId.identifier,
+                domain: request.conversationId.domain,
                 selfClient: selfClient,
                 apiVersion: apiVersion
             )
@@ -152,25 +165,39 @@ public final class CallingRequestStrategy: AbstractRequestStrategy, ZMSingleRequ
         case clientDiscoverySync:
             zmLog.debug("Received client discovery response for \(self): \(response)")
 
+            guard let conversationId = clientDiscoveryQueue.nextRequest?.conversationId else { return }
+
             defer {
-                clientDiscoveryRequest = nil
+                // Sends the request of the next conversation once the sync has finished with this response
+                if clientDiscoveryQueue.nextRequest != nil {
+                    managedObjectContext.performGroupedBlock {
+                        self.clientDiscoverySync.readyForNextRequestIfNotBusy()
+                        RequestAvailableNotification.notifyNewRequestsAvailable(nil)
+                    }
+                }
             }
 
             guard response.httpStatus == 412 else {
                 zmLog.warn("Expected 412 response: missing clients")
+                clientDiscoveryQueue.completeRequest(for: conversationId, clients: nil)
                 return
             }
 
-            guard let jsonData = response.rawData else { return }
+            guard let jsonData = response.rawData else {
+                clientDiscoveryQueue.completeRequest(for: conversationId, clients: nil)
+                return
+            }
 
             let apiVersion = APIVersion(rawValue: response.apiVersion)!
             decoder.userInfo = [ClientDiscoveryResponsePayload.apiVersionKey: apiVersion]
 
             do {
                 let payload = try decoder.decode(ClientDiscoveryResponsePayload.self, from: jsonData)
-                clientDiscoveryRequest?.completion(payload.clients)
+                let request = clientDiscoveryQueue.completeRequest(for: conversationId, clients: payload.clients)
+                request?.completions.forEach { $0(payload.clients) }
             } catch {
                 zmLog.error("Could not parse client discovery response: \(error.localizedDescription)")
+                clientDiscoveryQueue.completeRequest(for: conversationId, clients: nil)
             }
 
         default:
@@ -193,6 +220,8 @@ public final class CallingRequestStrategy: AbstractRequestStrategy, ZMSingleRequ
     }
 
     public func objectsDidChange(_ objects: Set<NSManagedObject>) {
+        invalidateDiscoveredClients(for: objects)
+
         guard callCenter == nil else { return }
 
         for object in objects {
@@ -226,6 +255,8 @@ public final class CallingRequestStrategy: AbstractRequestStrategy, ZMSingleRequ
     }
 
     private func processEvent(_ event: ZMUpdateEvent) {
+        invalidateDiscoveredClients(for: event)
+
         let serverTimeDelta = managedObjectContext.serverTimeDelta
         guard event.type == .conversationOtrMessageAdd else { return }
 
@@ -291,7 +322,10 @@ public final class CallingRequestStrategy: AbstractRequestStrategy, ZMSingleRequ
             clientId: clientId
         )
 
+        invalidateDiscoveredClients(forCallingMessage: payload, in: conversationId)
+
         callEventStatus.scheduledCallEventForProcessing()
+        callCenter?.callSetupTracer.stamp(.callEventScheduled, conversationId: conversationUUID)
 
         callCenter?.processCallEvent(callEvent, completionHandler: { [weak self] in
             self?.zmLog.debug("processed calling message")
@@ -313,20 +347,19 @@ extension CallingRequestStrategy: WireCallCenterTransport {
             return
         }
 
+        let sendRequestDate = Date()
+
         managedObjectContext.performGroupedBlock {
-            guard let conversation = ZMConversation.fetch(with: conversationId.identifier,
-                                                          domain: conversationId.domain,
-                                                          in: self.managedObjectContext)
-            else {
+            guard let conversation = self.callConversation(with: conversationId) else {
                 self.zmLog.error("Not sending calling messsage since conversation doesn't exist")
                 completionHandler(500)
                 return
             }
 
-            self.zmLog.debug("schedule calling message")
+            self.invalidateDiscoveredClients(forCallingMessage: data, in: conversationId)
 
             let genericMessage = GenericMessage(content: Calling(content: dataString))
-            let recipients = targets.map { self.recipients(for: $0, in: self.managedObjectContext) } ?? .conversationParticipants
+            let recipients = targets.map { self.recipients(for: $0) } ?? .conversationParticipants
             let message = GenericMessageEntity(conversation: conversation,
                                                message: genericMessage,
                                                targetRecipients: recipients,
@@ -337,6 +370,10 @@ extension CallingRequestStrategy: WireCallCenterTransport {
                     completionHandler(response.httpStatus)
                 }
             }
+
+            let latency = -sendRequestDate.timeIntervalSinceNow
+            self.callingMessageSchedulingStatistics.recordMessage(latency: latency)
+            self.zmLog.debug("scheduled calling message \(Int(latency * 1000)) ms after AVS sent it")
         }
     }
 
@@ -384,11 +421,25 @@ extension CallingRequestStrategy: WireCallCenterTransport {
     public func requestClientsList(conversationId: AVSIdentifier, completionHandler: @escaping ([AVSClient]) -> Void) {
         self.zmLog.debug("requestClientList() called, moc = \(managedObjectContext)")
         managedObjectContext.performGroupedBlock { [unowned self] in
-            self.clientDiscoveryRequest = ClientDiscoveryRequest(
-                conversationId: conversationId.identifier,
-                domain: conversationId.domain,
-                completion: completionHandler
+            let cachedClients = self.clientDiscoveryQueue.cachedClients(for: conversationId)
+            self.clientDiscoveryQueue.recordRequest(answeredFromCache: cachedClients != nil)
+
+            if let clients = cachedClients {
+                self.zmLog.debug("Using cached client list")
+                completionHandler(clients)
+                return
+            }
+
+            let request = ClientDiscoveryRequest(
+                conversationId: conversationId,
+                completions: [completionHandler]
             )
+
+            guard self.clientDiscoveryQueue.enqueue(request) else {
+                self.zmLog.debug("Joining pending client discovery")
+                return
+            }
+
             self.clientDiscoverySync.readyForNextRequestIfNotBusy()
             RequestAvailableNotification.notifyNewRequestsAvailable(nil)
         }
@@ -413,15 +464,109 @@ extension CallingRequestStrategy: WireCallCenterTransport {
 
     }
 
-    private func recipients(for targets: [AVSClient], in managedObjectContext: NSManagedObjectContext) -> GenericMessageEntity.Recipients {
-        let clientsByUser = targets
-            .compactMap { UserClient.fetchExistingUserClient(with: $0.clientId, in: managedObjectContext) }
+    private func callConversation(with conversationId: AVSIdentifier) -> ZMConversation? {
+        if let objectID = callConversationObjectIDs[conversationId],
+           let conversation = (try? managedObjectContext.existingObject(with: objectID)) as? ZMConversation,
+           !conversation.isZombieObject {
+            return conversation
+        }
+
+        guard let conversation = ZMConversation.fetch(with: conversationId.identifier,
+                                                      domain: conversationId.domain,
+                                                      in: managedObjectContext)
+        else {
+            return nil
+        }
+
+        if !conversation.objectID.isTemporaryID {
+            callConversationObjectIDs[conversationId] = conversation.objectID
+        }
+
+        return conversation
+    }
+
+    private func recipients(for targets: [AVSClient]) -> GenericMessageEntity.Recipients {
+        var clients = [UserClient]()
+        var uncachedTargets = [AVSClient]()
+
+        for target in targets {
+            if let objectID = callClientObjectIDs[target],
+               let client = (try? managedObjectContext.existingObject(with: objectID)) as? UserClient,
+               !client.isZombieObject {
+                clients.append(client)
+            } else {
+                uncachedTargets.append(target)
+            }
+        }
+
+        if !uncachedTargets.isEmpty {
+            clients += fetchUserClients(for: uncachedTargets)
+        }
+
+        let clientsByUser = clients
             .partition(by: \.user)
             .mapValues { Set($0) }
 
         return .clients(clientsByUser)
     }
 
+    /// Fetches the clients of all targets at once and remembers their object IDs
+    private func fetchUserClients(for targets: [AVSClient]) -> [UserClient] {
+        let request = NSFetchRequest<UserClient>(entityName: UserClient.entityName())
+        request.predicate = NSPredicate(format: "%K IN %@", #keyPath(UserClient.remoteIdentifier), targets.map(\.clientId))
+        request.relationshipKeyPathsForPrefetching = [#keyPath(UserClient.user)]
+        request.returnsObjectsAsFaults = false
+
+        let clientsById = Dictionary(grouping: managedObjectContext.fetchOrAssert(request: request), by: \.remoteIdentifier)
+
+        if callClientObjectIDs.count + targets.count > maxCachedCallClients {
+            callClientObjectIDs.removeAll()
+        }
+
+        return targets.compactMap { target in
+            // Client identifiers are only unique per user
+            let candidates = clientsById[target.clientId] ?? []
+
+            guard let client = candidates.first(where: { $0.user?.avsIdentifier == target.avsIdentifier }) else {
+                return nil
+            }
+
+            if !client.objectID.isTemporaryID {
+                callClientObjectIDs[target] = client.objectID
+            }
+
+            return client
+        }
+    }
+
+}
+
+// MARK: - Calling Message Scheduling Statistics
+
+extension CallingRequestStrategy {
+
+    struct CallingMessageSchedulingStatistics: Equatable {
+
+        /// Number of calling messages scheduled
+        private(set) var messageCount = 0
+        /// Sum of the time between AVS handing over each message and scheduling it
+        private(set) var totalLatency: TimeInterval = 0
+        /// Longest time between AVS handing over a message and scheduling it
+        private(set) var maximumLatency: TimeInterval = 0
+
+        var averageLatency: TimeInterval? {
+            guard messageCount > 0 else { return nil }
+            return totalLatency / TimeInterval(messageCount)
+        }
+
+        mutating func recordMessage(latency: TimeInterval) {
+            messageCount += 1
+            totalLatency += latency
+            maximumLatency = max(maximumLatency, latency)
+        }
+
+    }
+
 }
 
 // MARK: - Client Discovery Request
@@ -430,10 +575,47 @@ extension CallingRequestStrategy {
 
     struct ClientDiscoveryRequest {
 
-        let conversationId: UUID
-        let domain: String?
-        let completion: ([AVSClient]) -> Void
+        let conversationId: AVSIdentifier
+        var completions: [([AVSClient]) -> Void]
+
+    }
 
+    /// Invalidates the client lists of the conversations whose members changed, and of all
+    /// conversations when the self user's clients changed.
+    private func invalidateDiscoveredClients(for event: ZMUpdateEvent) {
+        switch event.type {
+        case .conversationMemberJoin, .conversationMemberLeave:
+            if let conversationId = event.conversationUUID {
+                clientDiscoveryQueue.invalidate(conversationId: AVSIdentifier(identifier: conversationId, domain: event.conversationDomain))
+            }
+        case .userClientAdd, .userClientRemove:
+            clientDiscoveryQueue.invalidateAll()
+        default:
+            break
+        }
+    }
+
+    /// Invalidates the client list of the conversation when a call starts in it, so that the
+    /// call always reaches the clients other users added since the list was discovered.
+    private func invalidateDiscoveredClients(forCallingMessage data: Data, in conversationId: AVSIdentifier) {
+        guard
+            let message = try? decoder.decode(CallEventBuffer.Message.self, from: data),
+            message.isCallStart
+        else {
+            return
+        }
+
+        clientDiscoveryQueue.invalidate(conversationId: conversationId)
+    }
+
+    /// Invalidates the client lists which are missing an added client, or contain a deleted one.
+    private func invalidateDiscoveredClients(for objects: Set<NSManagedObject>) {
+        guard !clientDiscoveryQueue.isCacheEmpty else { return }
+
+        for case let userClient as UserClient in objects {
+            guard let client = AVSClient(userClient: userClient) else { continue }
+            clientDiscoveryQueue.invalidate(changedClient: client, isDeleted: userClient.isZombieObject)
+        }
     }
 
     struct ClientDiscoveryResponsePayload: Decodable {
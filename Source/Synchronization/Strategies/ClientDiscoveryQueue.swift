@@ -0,0 +1,145 @@
+//
+// Wire
+// Copyright (C) 2022 Wire Swiss GmbH
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see http://www.gnu.org/licenses/.
+//
+
+import Foundation
+
+extension CallingRequestStrategy {
+
+    /// Keeps track of the client discovery requests AVS makes for calls.
+    ///
+    /// There is at most one pending request per conversation: requests for a conversation
+    /// which is already being discovered are merged. Requests for different conversations are
+    /// sent one after the other. Discovered client lists are only cached for a few seconds,
+    /// to answer the repeated requests AVS makes while setting up a call, and are dropped
+    /// when a call starts or the members or clients of the conversation change.
+    struct ClientDiscoveryQueue {
+
+        struct Statistics: Equatable {
+            /// Number of client lists requested by AVS
+            var requestCount = 0
+            /// Number of requests answered from the cache
+            var cacheHitCount = 0
+            /// Number of requests merged with a pending request for the same conversation
+            var mergedRequestCount = 0
+        }
+
+        private struct CacheEntry {
+            let clients: [AVSClient]
+            let date: Date
+        }
+
+        /// How long a discovered client list is trusted, new clients of other users aren't noticed meanwhile
+        static let cacheLifetime: TimeInterval = 10
+
+        private(set) var statistics = Statistics()
+        private var pendingRequests = [ClientDiscoveryRequest]()
+        private var cache = [AVSIdentifier: CacheEntry]()
+        /// Conversations which were invalidated while their request was pending
+        private var invalidatedPendingConversations = Set<AVSIdentifier>()
+
+        /// The request to send next
+        var nextRequest: ClientDiscoveryRequest? {
+            return pendingRequests.first
+        }
+
+        var isCacheEmpty: Bool {
+            return cache.isEmpty
+        }
+
+        /// Returns the cached client list of the conversation if it's still valid
+        mutating func cachedClients(for conversationId: AVSIdentifier, now: Date = Date()) -> [AVSClient]? {
+            guard let entry = cache[conversationId] else { return nil }
+
+            guard now.timeIntervalSince(entry.date) < Self.cacheLifetime else {
+                cache.removeValue(forKey: conversationId)
+                return nil
+            }
+
+            return entry.clients
+        }
+
+        /// Counts a client list requested by AVS
+        mutating func recordRequest(answeredFromCache: Bool) {
+            statistics.requestCount += 1
+
+            if answeredFromCache {
+                statistics.cacheHitCount += 1
+            }
+        }
+
+        /// Adds the request to the queue.
+        /// - returns: `false` if it was merged with a pending request for the same conversation
+        mutating func enqueue(_ request: ClientDiscoveryRequest) -> Bool {
+            guard let index = pendingRequests.firstIndex(where: { $0.conversationId == request.conversationId }) else {
+                pendingRequests.append(request)
+                return true
+            }
+
+            pendingRequests[index].completions += request.completions
+            statistics.mergedRequestCount += 1
+            return false
+        }
+
+        /// Removes the pending request of the conversation and caches the discovered clients.
+        /// - parameter clients: the discovered clients, `nil` if the discovery failed
+        /// - returns: the completed request
+        @discardableResult
+        mutating func completeRequest(for conversationId: AVSIdentifier, clients: [AVSClient]?, now: Date = Date()) -> ClientDiscoveryRequest? {
+            guard let index = pendingRequests.firstIndex(where: { $0.conversationId == conversationId }) else { return nil }
+
+            let request = pendingRequests.remove(at: index)
+
+            if let clients = clients, invalidatedPendingConversations.remove(conversationId) == nil {
+                cache[conversationId] = CacheEntry(clients: clients, date: now)
+            }
+
+            return request
+        }
+
+        mutating func invalidate(conversationId: AVSIdentifier) {
+            cache.removeValue(forKey: conversationId)
+
+            if pendingRequests.contains(where: { $0.conversationId == conversationId }) {
+                invalidatedPendingConversations.insert(conversationId)
+            }
+        }
+
+        mutating func invalidateAll() {
+            cache.removeAll()
+            invalidatedPendingConversations.formUnion(pendingRequests.map(\.conversationId))
+        }
+
+        /// Invalidates the lists which miss a new client of one of their users, or contain a deleted client
+        mutating func invalidate(changedClient client: AVSClient, isDeleted: Bool) {
+            let affectedConversations = cache.compactMap { conversationId, entry -> AVSIdentifier? in
+                let containsClient = entry.clients.contains(client)
+                let containsUser = containsClient || entry.clients.contains { $0.userId == client.userId }
+
+                if isDeleted ? containsClient : (containsUser && !containsClient) {
+                    return conversationId
+                }
+
+                return nil
+            }
+
+            affectedConversations.forEach { cache.removeValue(forKey: $0) }
+        }
+
+    }
+
+}
@@ -48,9 +48,11 @@ public class LabelDownstreamRequestStrategy: AbstractRequestStrategy, ZMEventCon
 
     fileprivate var slowSync: ZMSingleRequestSync!
     fileprivate let jsonDecoder = JSONDecoder()
+    fileprivate let fingerprints: SlowSyncFingerprints
 
     public init(withManagedObjectContext managedObjectContext: NSManagedObjectContext, applicationStatus: ApplicationStatus, syncStatus: SyncStatus) {
         self.syncStatus = syncStatus
+        self.fingerprints = SlowSyncFingerprints(keyValueStore: managedObjectContext)
 
         super.init(withManagedObjectContext: managedObjectContext, applicationStatus: applicationStatus)
 
@@ -62,54 +64,115 @@ public class LabelDownstreamRequestStrategy: AbstractRequestStrategy, ZMEventCon
     }
 
     override public func nextRequestIfAllowed(for apiVersion: APIVersion) -> ZMTransportRequest? {
-        guard syncStatus.currentSyncPhase == .fetchingLabels || ZMUser.selfUser(in: managedObjectContext).needsToRefetchLabels else { return nil }
+        guard syncStatus.isActive(phase: .fetchingLabels) || ZMUser.selfUser(in: managedObjectContext).needsToRefetchLabels else { return nil }
 
         slowSync.readyForNextRequestIfNotBusy()
 
         return slowSync.nextRequest(for: apiVersion)
     }
 
-    func update(with transportData: Data) {
+    /// - returns: the number of labels which were updated or deleted, `nil` if the payload is malformed
+    @discardableResult
+    func update(with transportData: Data) -> Int? {
         guard let labelResponse = try? jsonDecoder.decode(LabelPayload.self, from: transportData) else {
             Logging.eventProcessing.error("Can't apply label update due to malformed JSON")
-            return
+            return nil
         }
 
-        update(with: labelResponse)
+        return update(with: labelResponse)
     }
 
-    func update(with response: LabelPayload) {
-        updateLabels(with: response)
-        deleteLabels(with: response)
+    @discardableResult
+    func update(with response: LabelPayload) -> Int {
+        let existingLabels = managedObjectContext.fetchOrAssert(request: NSFetchRequest<Label>(entityName: Label.entityName()))
+        return updateLabels(with: response, existingLabels: existingLabels) + deleteLabels(with: response, existingLabels: existingLabels)
     }
 
-    fileprivate func updateLabels(with response: LabelPayload) {
-        for labelUpdate in response.labels {
-            var created = false
+    /// Applies the labels downloaded by a slow sync or refetch, unless they didn't change since the last time
+    fileprivate func updateIfChanged(with transportData: Data) {
+        let isUnchanged = !ZMUser.selfUser(in: managedObjectContext).needsToRefetchLabels
+            && fingerprints.isUnchanged(transportData, for: .labels)
+
+        var objectsWritten = 0
+
+        if !isUnchanged, let updatedLabels = update(with: transportData) {
+            fingerprints.update(transportData, for: .labels)
+            objectsWritten = updatedLabels
+        }
+
+        syncStatus.recordSlowSyncPayload(phase: .fetchingLabels, byteCount: transportData.count, objectsWritten: objectsWritten, isUnchanged: isUnchanged)
+    }
+
+    /// Updates the labels in place, so that only the attributes and conversations which changed are written
+    /// - returns: the number of labels which were inserted or changed
+    fileprivate func updateLabels(with response: LabelPayload, existingLabels: [Label]) -> Int {
+        let conversationIDs = Set(response.labels.flatMap(\.conversations))
+        let conversations = ZMConversation.fetchObjects(withRemoteIdentifiers: conversationIDs, in: managedObjectContext) as? Set<ZMConversation> ?? Set()
+        let conversationsByID = Dictionary(conversations.compactMap { conversation in conversation.remoteIdentifier.map { ($0, conversation) } }, uniquingKeysWith: { first, _ in first })
+
+        var labelsByID = Dictionary(existingLabels.compactMap { label in label.remoteIdentifier.map { ($0, label) } }, uniquingKeysWith: { first, _ in first })
+        var favoriteLabel = existingLabels.first { $0.kind == .favorite }
+        var changedLabels = Set<NSManagedObjectID>()
 
-            let label: Label?
+        for labelUpdate in response.labels {
+            let label: Label
             if labelUpdate.type == Label.Kind.favorite.rawValue {
-                label = Label.fetchFavoriteLabel(in: managedObjectContext)
+                label = favoriteLabel ?? Label.fetchFavoriteLabel(in: managedObjectContext)
+                favoriteLabel = label
+            } else if let existingLabel = labelsByID[labelUpdate.id] {
+                label = existingLabel
             } else {
-                label = Label.fetchOrCreate(remoteIdentifier: labelUpdate.id, create: true, in: managedObjectContext, created: &created)
+                label = Label.insertNewObject(in: managedObjectContext)
+                label.remoteIdentifier = labelUpdate.id
+                labelsByID[labelUpdate.id] = label
+            }
+
+            var isChanged = label.isInserted
+
+            let kind = Label.Kind(rawValue: labelUpdate.type) ?? .folder
+            if label.kind != kind {
+                label.kind = kind
+                isChanged = true
+            }
+
+            if label.name != labelUpdate.name {
+                label.name = labelUpdate.name
+                isChanged = true
+            }
+
+            let labelConversations = Set(labelUpdate.conversations.compactMap { conversationsByID[$0] })
+            let removedConversations = label.conversations.subtracting(labelConversations)
+            let addedConversations = labelConversations.subtracting(label.conversations)
+
+            if !removedConversations.isEmpty || !addedConversations.isEmpty {
+                let relation = label.mutableSetValue(forKey: #keyPath(Label.conversations))
+                relation.minus(removedConversations)
+                relation.union(addedConversations)
+                isChanged = true
             }
 
-            label?.kind = Label.Kind(rawValue: labelUpdate.type) ?? .folder
-            label?.name = labelUpdate.name
-            label?.conversations = ZMConversation.fetchObjects(withRemoteIdentifiers: Set(labelUpdate.conversations), in: managedObjectContext) as? Set<ZMConversation> ?? Set()
-            label?.modifiedKeys = nil
+            if label.modifiedKeys != nil {
+                label.modifiedKeys = nil
+            }
+
+            if isChanged {
+                changedLabels.insert(label.objectID)
+            }
         }
+
+        return changedLabels.count
     }
 
-    fileprivate func deleteLabels(with response: LabelPayload) {
-        let uuids: [NSData] = response.labels.map({ $0.id.uuidData as NSData })
-        let predicate = NSPredicate(format: "type == \(Label.Kind.folder.rawValue) AND NOT remoteIdentifier_data IN %@", uuids as CVarArg)
-        let fetchRequest = NSFetchRequest<Label>(entityName: Label.entityName())
-        fetchRequest.predicate = predicate
+    /// Deletes the folders which are not part of the response. The context is saved by the caller.
+    fileprivate func deleteLabels(with response: LabelPayload, existingLabels: [Label]) -> Int {
+        let remoteIdentifiers = Set(response.labels.map(\.id))
+        let deletedLabels = existingLabels.filter {
+            $0.kind == .folder && !$0.isDeleted && !remoteIdentifiers.contains($0.remoteIdentifier ?? UUID())
+        }
+
+        deletedLabels.forEach(managedObjectContext.delete)
 
-        let deletedLabels = managedObjectContext.fetchOrAssert(request: fetchRequest)
-        deletedLabels.forEach { managedObjectContext.delete($0) } // TODO jacob consider doing a batch delete
-        managedObjectContext.saveOrRollback()
+        return deletedLabels.count
     }
 
     // MARK: - ZMEventConsumer
@@ -123,6 +186,7 @@ public class LabelDownstreamRequestStrategy: AbstractRequestStrategy, ZMEventCon
                 continue
             }
 
+            fingerprints.invalidate(.labels)
             update(with: data)
         }
     }
@@ -139,10 +203,10 @@ public class LabelDownstreamRequestStrategy: AbstractRequestStrategy, ZMEventCon
         }
 
         if response.result == .success, let rawData = response.rawData {
-            update(with: rawData)
+            updateIfChanged(with: rawData)
         }
 
-        if syncStatus.currentSyncPhase == .fetchingLabels {
+        if syncStatus.isActive(phase: .fetchingLabels) {
             syncStatus.finishCurrentSyncPhase(phase: .fetchingLabels)
         }
 
@@ -22,8 +22,11 @@ public class LabelUpstreamRequestStrategy: AbstractRequestStrategy, ZMContextCha
 
     fileprivate let jsonEncoder = JSONEncoder()
     fileprivate var upstreamSync: ZMSingleRequestSync!
+    fileprivate let fingerprints: SlowSyncFingerprints
 
     override public init(withManagedObjectContext managedObjectContext: NSManagedObjectContext, applicationStatus: ApplicationStatus) {
+        self.fingerprints = SlowSyncFingerprints(keyValueStore: managedObjectContext)
+
         super.init(withManagedObjectContext: managedObjectContext, applicationStatus: applicationStatus)
 
         self.configuration = .allowsRequestsWhileOnline
@@ -79,6 +82,9 @@ public class LabelUpstreamRequestStrategy: AbstractRequestStrategy, ZMContextCha
             fatal("Couldn't encode label update: \(error)")
         }
 
+        // The labels differ from the ones last downloaded, the next slow sync must apply them again
+        fingerprints.invalidate(.labels)
+
         let request = ZMTransportRequest(path: "/properties/labels", method: .methodPUT, payload: transportPayload as? ZMTransportData, apiVersion: apiVersion.rawValue)
         request.add(ZMCompletionHandler(on: managedObjectContext, block: { [weak self] (response) in
             self?.didReceive(response, updatedKeys: updatedKeys)
@@ -34,7 +34,7 @@ public class LegalHoldRequestStrategy: AbstractRequestStrategy, ZMSingleRequestT
     }
 
     public override func nextRequestIfAllowed(for apiVersion: APIVersion) -> ZMTransportRequest? {
-        guard syncStatus.currentSyncPhase == .fetchingLegalHoldStatus else { return nil }
+        guard syncStatus.isActive(phase: .fetchingLegalHoldStatus) else { return nil }
 
         singleRequstSync.readyForNextRequestIfNotBusy()
 
@@ -77,55 +77,144 @@ fileprivate extension Member {
 
 }
 
-public final class PermissionsDownloadRequestStrategy: AbstractRequestStrategy, ZMContextChangeTrackerSource, ZMRequestGeneratorSource, ZMDownstreamTranscoder {
+/// Downloads the members of a team which need to be updated from the backend, e.g. after
+/// their permissions changed. Members of the same team are coalesced into one list request.
+public final class PermissionsDownloadRequestStrategy: AbstractRequestStrategy, ZMContextChangeTracker, ZMContextChangeTrackerSource {
 
-    fileprivate var sync: ZMDownstreamObjectSync!
+    /// Maximum number of members which are fetched with one list request
+    static let maxMembersPerRequest = 500
+
+    fileprivate var membersToDownload = Set<Member>()
+    fileprivate var membersInProgress = Set<Member>()
+    /// Members of a list request which failed permanently, they're fetched one by one
+    fileprivate var membersToDownloadIndividually = Set<Member>()
 
     public override init(withManagedObjectContext managedObjectContext: NSManagedObjectContext, applicationStatus: ApplicationStatus) {
         super.init(withManagedObjectContext: managedObjectContext, applicationStatus: applicationStatus)
         configuration = .allowsRequestsWhileOnline
-        sync = ZMDownstreamObjectSync(
-            transcoder: self,
-            entityName: Member.entityName(),
-            predicateForObjectsToDownload: Member.predicateForObjectsNeedingToBeUpdated,
-            filter: nil,
-            managedObjectContext: managedObjectContext
-        )
     }
 
     public override func nextRequestIfAllowed(for apiVersion: APIVersion) -> ZMTransportRequest? {
-        return sync.nextRequest(for: apiVersion)
-    }
+        membersToDownload = membersToDownload.filter(\.isReadyToBeDownloaded)
+        membersToDownloadIndividually = membersToDownloadIndividually.filter(\.isReadyToBeDownloaded)
+
+        let members: [Member]
+        if let member = membersToDownloadIndividually.popFirst() {
+            members = [member]
+        } else if let teamID = membersToDownload.first?.team?.remoteIdentifier {
+            members = Array(membersToDownload.filter { $0.team?.remoteIdentifier == teamID }.prefix(Self.maxMembersPerRequest))
+        } else {
+            return nil
+        }
 
-    public var contextChangeTrackers: [ZMContextChangeTracker] {
-        return [sync]
+        guard let teamID = members[0].team?.remoteIdentifier else { return nil }
+        let memberIDs = members.compactMap(\.remoteIdentifier)
+
+        let request: ZMTransportRequest
+        if memberIDs.count == 1 {
+            request = TeamDownloadRequestFactory.getSingleMemberRequest(for: memberIDs[0], in: teamID, apiVersion: apiVersion)
+        } else {
+            request = TeamDownloadRequestFactory.getMembersRequest(for: memberIDs, in: teamID, apiVersion: apiVersion)
+        }
+
+        membersToDownload.subtract(members)
+        membersInProgress.formUnion(members)
+
+        request.add(ZMCompletionHandler(on: managedObjectContext, block: { [weak self] response in
+            self?.didReceive(response, for: members)
+        }))
+
+        return request
     }
 
-    public var requestGenerators: [ZMRequestGenerator] {
-        return [sync]
+    private func didReceive(_ response: ZMTransportResponse, for members: [Member]) {
+        membersInProgress.subtract(members)
+
+        switch response.result {
+        case .success:
+            if members.count == 1 {
+                update(members[0], with: response)
+            } else {
+                update(members, with: response)
+            }
+        case .permanentError:
+            if members.count == 1 {
+                managedObjectContext.delete(members[0])
+            } else {
+                // The list request fails as a whole, retrying it would fail again. Fetching the members
+                // one by one finds out which of them can't be fetched.
+                membersToDownloadIndividually.formUnion(members.filter(\.isReadyToBeDownloaded))
+            }
+        default:
+            membersToDownload.formUnion(members.filter(\.isReadyToBeDownloaded))
+        }
+
+        if !membersToDownload.isEmpty || !membersToDownloadIndividually.isEmpty {
+            RequestAvailableNotification.notifyNewRequestsAvailable(nil)
+        }
     }
 
-    // MARK: - ZMDownstreamTranscoder
+    private func update(_ member: Member, with response: ZMTransportResponse) {
+        guard
+            let team = member.team,
+            let rawData = response.rawData,
+            let membershipPayload = MembershipPayload(rawData)
+        else {
+            return
+        }
 
-    public func request(forFetching object: ZMManagedObject!, downstreamSync: ZMObjectSync!, apiVersion: APIVersion) -> ZMTransportRequest! {
-        guard let member = object as? Member, downstreamSync as? ZMDownstreamObjectSync == sync else { fatal("Wrong object: \(object.safeForLoggingDescription)") }
-        guard let identifier = member.remoteIdentifier, let teamId = member.team?.remoteIdentifier else { fatal("No ids to sync: \(object.safeForLoggingDescription)") }
-        return TeamDownloadRequestFactory.getSingleMemberRequest(for: identifier, in: teamId, apiVersion: apiVersion)
+        membershipPayload.createOrUpdateMember(team: team, in: managedObjectContext)
     }
 
-    public func update(_ object: ZMManagedObject!, with response: ZMTransportResponse!, downstreamSync: ZMObjectSync!) {
+    private func update(_ members: [Member], with response: ZMTransportResponse) {
         guard
-            downstreamSync as? ZMDownstreamObjectSync == sync,
-            let team = (object as? Member)?.team,
+            let team = members.first?.team,
             let rawData = response.rawData,
-            let memberhipPayload = MembershipPayload(rawData)
-        else { return }
+            let membershipListPayload = MembershipListPayload(rawData)
+        else {
+            return
+        }
 
-        memberhipPayload.createOrUpdateMember(team: team, in: managedObjectContext)
+        membershipListPayload.members.forEach { $0.createOrUpdateMember(team: team, in: managedObjectContext) }
+
+        // Members missing from the response are no longer part of the team
+        let receivedUserIDs = Set(membershipListPayload.members.map(\.userID))
+        members
+            .filter { !$0.isDeleted && !receivedUserIDs.contains($0.remoteIdentifier ?? UUID()) }
+            .forEach(managedObjectContext.delete)
     }
 
-    public func delete(_ object: ZMManagedObject!, with response: ZMTransportResponse!, downstreamSync: ZMObjectSync!) {
-        guard downstreamSync as? ZMDownstreamObjectSync == sync, let member = object as? Member else { return }
-        managedObjectContext.delete(member)
+    // MARK: - ZMContextChangeTracker, ZMContextChangeTrackerSource
+
+    public var contextChangeTrackers: [ZMContextChangeTracker] {
+        return [self]
+    }
+
+    public func fetchRequestForTrackedObjects() -> NSFetchRequest<NSFetchRequestResult>? {
+        return Member.sortedFetchRequest(with: Member.predicateForObjectsNeedingToBeUpdated)
+    }
+
+    public func addTrackedObjects(_ objects: Set<NSManagedObject>) {
+        addMembersToDownload(objects)
     }
+
+    public func objectsDidChange(_ objects: Set<NSManagedObject>) {
+        addMembersToDownload(objects)
+    }
+
+    private func addMembersToDownload(_ objects: Set<NSManagedObject>) {
+        let members = objects.compactMap { $0 as? Member }.filter(\.isReadyToBeDownloaded)
+        guard !members.isEmpty else { return }
+
+        membersToDownload.formUnion(Set(members).subtracting(membersInProgress).subtracting(membersToDownloadIndividually))
+    }
+
+}
+
+fileprivate extension Member {
+
+    var isReadyToBeDownloaded: Bool {
+        return !isDeleted && needsToBeUpdatedFromBackend && remoteIdentifier != nil && team?.remoteIdentifier != nil
+    }
+
 }
@@ -0,0 +1,180 @@
+//
+// Wire
+// Copyright (C) 2022 Wire Swiss GmbH
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see http://www.gnu.org/licenses/.
+//
+
+import Foundation
+
+private let zmLog = ZMSLog(tag: "SearchUserAssetCache")
+
+/// Bounded memory and disk cache for profile image data of search users, keyed by asset key.
+///
+/// Asset keys are immutable, so cached data never needs to be revalidated. When the disk
+/// cache grows above its limit, the least recently used entries are removed.
+public final class SearchUserAssetCache {
+
+    private struct DiskEntry {
+        let size: Int
+        var lastAccess: Date
+    }
+
+    private let memoryCache = NSCache<NSString, NSData>()
+    private let directory: URL?
+    private let maxDiskSize: Int
+    private let isolationQueue = DispatchQueue(label: "SearchUserAssetCache")
+    /// Files on disk, keyed by file name
+    private var diskEntries: [String: DiskEntry]?
+    private var diskSize = 0
+
+    /// - parameter directory: where to persist data, `nil` keeps it in memory only
+    /// - parameter maxMemorySize: approximate number of bytes to keep in memory
+    /// - parameter maxDiskSize: number of bytes to keep on disk
+    public init(directory: URL?, maxMemorySize: Int = 5 * 1024 * 1024, maxDiskSize: Int = 20 * 1024 * 1024) {
+        self.directory = directory
+        self.maxDiskSize = maxDiskSize
+        memoryCache.totalCostLimit = maxMemorySize
+    }
+
+    /// Returns the data from memory or, blocking until it is read, from disk.
+    /// Don't call this on the main thread.
+    public func data(forAssetKey key: String) -> Data? {
+        if let data = memoryCache.object(forKey: key as NSString) {
+            return data as Data
+        }
+
+        return isolationQueue.sync {
+            let fileName = Self.fileName(forAssetKey: key)
+
+            guard let url = directory?.appendingPathComponent(fileName), loadDiskEntriesIfNeeded()[fileName] != nil else { return nil }
+
+            guard let data = try? Data(contentsOf: url) else {
+                removeDiskEntry(fileName: fileName)
+                return nil
+            }
+
+            diskEntries?[fileName]?.lastAccess = Date()
+            try? FileManager.default.setAttributes([.modificationDate: Date()], ofItemAtPath: url.path)
+            memoryCache.setObject(data as NSData, forKey: key as NSString, cost: data.count)
+
+            return data
+        }
+    }
+
+    public func store(_ data: Data, forAssetKey key: String) {
+        memoryCache.setObject(data as NSData, forKey: key as NSString, cost: data.count)
+
+        isolationQueue.async {
+            let fileName = Self.fileName(forAssetKey: key)
+
+            guard let url = self.directory?.appendingPathComponent(fileName) else { return }
+
+            _ = self.loadDiskEntriesIfNeeded()
+
+            do {
+                try FileManager.default.createDirectory(at: url.deletingLastPathComponent(), withIntermediateDirectories: true)
+                try data.write(to: url, options: [.atomic, .completeFileProtectionUntilFirstUserAuthentication])
+            } catch {
+                zmLog.error("Failed to store asset: \(error.localizedDescription)")
+                return
+            }
+
+            self.removeDiskEntry(fileName: fileName, deletingFile: false)
+            self.diskEntries?[fileName] = DiskEntry(size: data.count, lastAccess: Date())
+            self.diskSize += data.count
+            self.evictIfNeeded()
+        }
+    }
+
+    /// Removes the data from memory immediately and from disk asynchronously
+    public func removeAll() {
+        memoryCache.removeAllObjects()
+
+        isolationQueue.async {
+            if let directory = self.directory {
+                try? FileManager.default.removeItem(at: directory)
+            }
+            self.diskEntries = [:]
+            self.diskSize = 0
+        }
+    }
+
+    // MARK: - Disk
+
+    /// Location of the cache in the given account container
+    public static func directory(in accountContainer: URL) -> URL {
+        return accountContainer.appendingPathComponent("search-user-assets", isDirectory: true)
+    }
+
+    /// Asset keys may contain characters which aren't valid in file names
+    private static func fileName(forAssetKey key: String) -> String {
+        return key.base64EncodedSHADigest
+            .replacingOccurrences(of: "/", with: "_")
+            .replacingOccurrences(of: "+", with: "-")
+    }
+
+    /// Must be called on the isolation queue
+    private func loadDiskEntriesIfNeeded() -> [String: DiskEntry] {
+        if let diskEntries = diskEntries {
+            return diskEntries
+        }
+
+        var entries = [String: DiskEntry]()
+        diskSize = 0
+
+        if let directory = directory,
+           let urls = try? FileManager.default.contentsOfDirectory(at: directory, includingPropertiesForKeys: [.fileSizeKey, .contentModificationDateKey]) {
+            for url in urls {
+                guard
+                    let values = try? url.resourceValues(forKeys: [.fileSizeKey, .contentModificationDateKey]),
+                    let size = values.fileSize
+                else {
+                    continue
+                }
+
+                entries[url.lastPathComponent] = DiskEntry(size: size, lastAccess: values.contentModificationDate ?? .distantPast)
+                diskSize += size
+            }
+        }
+
+        diskEntries = entries
+        return entries
+    }
+
+    /// Must be called on the isolation queue
+    private func removeDiskEntry(fileName: String, deletingFile: Bool = true) {
+        guard let entry = diskEntries?.removeValue(forKey: fileName) else { return }
+
+        diskSize -= entry.size
+
+        if deletingFile, let url = directory?.appendingPathComponent(fileName) {
+            try? FileManager.default.removeItem(at: url)
+        }
+    }
+
+    /// Must be called on the isolation queue
+    private func evictIfNeeded() {
+        guard diskSize > maxDiskSize, let entries = diskEntries else { return }
+
+        for (fileName, _) in entries.sorted(by: { $0.value.lastAccess < $1.value.lastAccess }) {
+            removeDiskEntry(fileName: fileName)
+
+            if diskSize <= maxDiskSize {
+                break
+            }
+        }
+    }
+
+}
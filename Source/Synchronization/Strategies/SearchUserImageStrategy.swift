@@ -18,31 +18,153 @@
 
 private let userPath = "/users?ids="
 
+/// Asset requests waiting to be sent, in the order in which they were made.
+///
+/// Requests whose asset keys aren't known yet wait for the full profile
+/// to be fetched, they are moved to the ready queue once the keys are updated.
+struct PendingSearchUserAssetRequests {
+
+    private(set) var assetKeys: [UUID: SearchUserAssetKeys?] = [:]
+    private(set) var inProgress: Set<UUID> = Set()
+    private var readyQueue: [UUID] = []
+    private var readyQueueStart = 0
+    private var queued: Set<UUID> = Set()
+
+    var isEmpty: Bool {
+        return assetKeys.isEmpty
+    }
+
+    func contains(_ user: UUID) -> Bool {
+        return assetKeys.keys.contains(user)
+    }
+
+    /// Adds a request, returns false if a request for the user is already pending
+    @discardableResult
+    mutating func request(_ user: UUID, assetKeys keys: SearchUserAssetKeys?) -> Bool {
+        let isNew = !contains(user)
+        assetKeys[user] = keys
+        enqueueIfReady(user)
+        return isNew
+    }
+
+    /// Updates the keys of a pending request
+    mutating func update(_ keys: SearchUserAssetKeys, for user: UUID) {
+        guard contains(user) else { return }
+        assetKeys[user] = keys
+        enqueueIfReady(user)
+    }
+
+    /// Returns the oldest request which has asset keys and isn't in progress, and marks it as in progress
+    mutating func dequeue() -> (user: UUID, assetKeys: SearchUserAssetKeys)? {
+        while readyQueueStart < readyQueue.count {
+            let user = readyQueue[readyQueueStart]
+            readyQueueStart += 1
+            queued.remove(user)
+
+            guard !inProgress.contains(user), let keys = assetKeys[user].flatMap({ $0 }) else { continue }
+
+            inProgress.insert(user)
+            compactIfNeeded()
+            return (user, keys)
+        }
+
+        compactIfNeeded()
+        return nil
+    }
+
+    /// Marks the request as finished, it's kept for a later retry if `retry` is true
+    mutating func complete(_ user: UUID, retry: Bool) {
+        inProgress.remove(user)
+
+        if retry {
+            enqueueIfReady(user)
+        } else {
+            assetKeys.removeValue(forKey: user)
+        }
+    }
+
+    private mutating func enqueueIfReady(_ user: UUID) {
+        guard
+            !inProgress.contains(user),
+            !queued.contains(user),
+            assetKeys[user].flatMap({ $0 }) != nil
+        else {
+            return
+        }
+
+        queued.insert(user)
+        readyQueue.append(user)
+    }
+
+    private mutating func compactIfNeeded() {
+        guard readyQueueStart > 32, readyQueueStart * 2 > readyQueue.count else { return }
+        readyQueue.removeFirst(readyQueueStart)
+        readyQueueStart = 0
+    }
+
+}
+
 public class SearchUserImageStrategy: AbstractRequestStrategy {
 
+    /// Counters to observe how many requests are made for search users,
+    /// and how many asset requests are avoided by the cache
+    public struct Statistics: Equatable {
+        public internal(set) var profileRequestCount = 0
+        public internal(set) var assetRequestCount = 0
+        public internal(set) var assetCacheHitCount = 0
+        public internal(set) var deduplicatedRequestCount = 0
+
+        /// Fraction of preview assets served from the cache
+        public var assetCacheHitRate: Double {
+            let total = assetCacheHitCount + assetRequestCount
+            return total == 0 ? 0 : Double(assetCacheHitCount) / Double(total)
+        }
+    }
+
+    /// Maximum number of users to fetch in a single profile request
+    static let maxProfileBatchSize = 64
+
     fileprivate unowned var uiContext: NSManagedObjectContext
     fileprivate unowned var syncContext: NSManagedObjectContext
 
+    fileprivate let assetCache: SearchUserAssetCache
+    fileprivate let profileBatchingInterval: TimeInterval
+    fileprivate var firstPendingProfileRequestDate: Date?
+    fileprivate var isProfileBatchFlushScheduled = false
+
     fileprivate var requestedMissingFullProfiles: Set<UUID> = Set()
     fileprivate var requestedMissingFullProfilesInProgress: Set<UUID> = Set()
 
-    fileprivate var requestedPreviewAssets: [UUID: SearchUserAssetKeys?] = [:]
-    fileprivate var requestedCompleteAssets: [UUID: SearchUserAssetKeys?] = [:]
+    fileprivate var requestedPreviewAssets = PendingSearchUserAssetRequests()
+    fileprivate var requestedCompleteAssets = PendingSearchUserAssetRequests()
     fileprivate var requestedUserDomain: [UUID: String] = [:]
-    fileprivate var requestedPreviewAssetsInProgress: Set<UUID> = Set()
-    fileprivate var requestedCompleteAssetsInProgress: Set<UUID> = Set()
 
     fileprivate var observers: [Any] = []
 
+    /// Counters are updated from the UI and sync contexts, they are only accessed on this queue
+    fileprivate let statisticsQueue = DispatchQueue(label: "SearchUserImageStrategy.statistics")
+    fileprivate var unsafeStatistics = Statistics()
+
+    public var statistics: Statistics {
+        return statisticsQueue.sync { unsafeStatistics }
+    }
+
     @available (*, unavailable)
     public override init(withManagedObjectContext moc: NSManagedObjectContext, applicationStatus: ApplicationStatus) {
         fatalError()
     }
 
-    public init(applicationStatus: ApplicationStatus, managedObjectContext: NSManagedObjectContext) {
+    /// - parameter assetCache: cache for preview assets of the account, shared across search sessions
+    /// - parameter profileBatchingInterval: how long to wait for more profile requests before fetching them in one request
+    public init(applicationStatus: ApplicationStatus,
+                managedObjectContext: NSManagedObjectContext,
+                assetCache: SearchUserAssetCache,
+                profileBatchingInterval: TimeInterval = 0.05) {
 
         self.syncContext = managedObjectContext
         self.uiContext = managedObjectContext.zm_userInterface
+        self.assetCache = assetCache
+        self.profileBatchingInterval = profileBatchingInterval
 
         super.init(withManagedObjectContext: managedObjectContext, applicationStatus: applicationStatus)
 
@@ -63,20 +185,39 @@ public class SearchUserImageStrategy: AbstractRequestStrategy {
         )
     }
 
+    public func resetStatistics() {
+        statisticsQueue.sync { unsafeStatistics = Statistics() }
+    }
+
+    fileprivate func updateStatistics(_ block: (inout Statistics) -> Void) {
+        statisticsQueue.sync { block(&unsafeStatistics) }
+    }
+
+    /// Called on the main thread. The asset cache is looked up when the request
+    /// is dequeued on the sync context, as it might read from disk.
     public func requestAsset(with note: NotificationInContext) {
         guard let searchUser = note.object as? ZMSearchUser, let userId = searchUser.remoteIdentifier else { return }
 
         if !searchUser.hasDownloadedFullUserProfile {
-            requestedMissingFullProfiles.insert(userId)
+            if requestedMissingFullProfiles.insert(userId).inserted {
+                firstPendingProfileRequestDate = firstPendingProfileRequestDate ?? Date()
+            } else {
+                updateStatistics { $0.deduplicatedRequestCount += 1 }
+            }
         }
 
+        let isNewRequest: Bool
         switch note.name {
         case .searchUserDidRequestPreviewAsset:
-            requestedPreviewAssets[userId] = searchUser.assetKeys
+            isNewRequest = requestedPreviewAssets.request(userId, assetKeys: searchUser.assetKeys)
         case .searchUserDidRequestCompleteAsset:
-            requestedCompleteAssets[userId] = searchUser.assetKeys
+            isNewRequest = requestedCompleteAssets.request(userId, assetKeys: searchUser.assetKeys)
         default:
-            break
+            isNewRequest = true
+        }
+
+        if !isNewRequest {
+            updateStatistics { $0.deduplicatedRequestCount += 1 }
         }
 
         if let domain = searchUser.domain {
@@ -93,35 +234,34 @@ public class SearchUserImageStrategy: AbstractRequestStrategy {
     }
 
     func fetchAssetRequest(apiVersion: APIVersion) -> ZMTransportRequest? {
-        let previewAssetRequest = requestedPreviewAssets.first(where: {
-            !(self.requestedPreviewAssetsInProgress.contains($0.key) ||
-                $0.value == nil)
-        })
-
-        if let previewAssetRequest = previewAssetRequest,
-           let assetKeys = previewAssetRequest.value,
-           let request = request(for: assetKeys, size: .preview, user: previewAssetRequest.key, apiVersion: apiVersion) {
-            requestedPreviewAssetsInProgress.insert(previewAssetRequest.key)
-
-            request.add(ZMCompletionHandler(on: syncContext, block: { [weak self] (response) in
-                self?.processAsset(response: response, for: previewAssetRequest.key, size: .preview)
-            }))
-
+        if let request = nextAssetRequest(from: &requestedPreviewAssets, size: .preview, apiVersion: apiVersion) {
             return request
         }
 
-        let completeAssetRequest = requestedCompleteAssets.first(where: {
-            !(self.requestedCompleteAssetsInProgress.contains($0.key) ||
-                $0.value == nil)
-        })
+        return nextAssetRequest(from: &requestedCompleteAssets, size: .complete, apiVersion: apiVersion)
+    }
+
+    private func nextAssetRequest(from pendingRequests: inout PendingSearchUserAssetRequests,
+                                  size: ProfileImageSize,
+                                  apiVersion: APIVersion) -> ZMTransportRequest? {
+        while let (user, assetKeys) = pendingRequests.dequeue() {
+            if size == .preview, let previewKey = assetKeys.preview, let imageData = assetCache.data(forAssetKey: previewKey) {
+                // the keys became known after the asset was requested, e.g. from the full profile
+                updateStatistics { $0.assetCacheHitCount += 1 }
+                pendingRequests.complete(user, retry: false)
+                deliverImageData(imageData, size: size, for: user)
+                continue
+            }
+
+            guard let request = request(for: assetKeys, size: size, user: user, apiVersion: apiVersion) else {
+                pendingRequests.complete(user, retry: false)
+                continue
+            }
 
-        if let completeAssetRequest = completeAssetRequest,
-           let assetKeys = completeAssetRequest.value,
-           let request = request(for: assetKeys, size: .complete, user: completeAssetRequest.key, apiVersion: apiVersion) {
-            requestedCompleteAssetsInProgress.insert(completeAssetRequest.key)
+            updateStatistics { $0.assetRequestCount += 1 }
 
             request.add(ZMCompletionHandler(on: syncContext, block: { [weak self] (response) in
-                self?.processAsset(response: response, for: completeAssetRequest.key, size: .complete)
+                self?.processAsset(response: response, for: user, assetKeys: assetKeys, size: size)
             }))
 
             return request
@@ -157,42 +297,58 @@ public class SearchUserImageStrategy: AbstractRequestStrategy {
         return nil
     }
 
-    func processAsset(response: ZMTransportResponse, for user: UUID, size: ProfileImageSize) {
+    func processAsset(response: ZMTransportResponse, for user: UUID, assetKeys: SearchUserAssetKeys? = nil, size: ProfileImageSize) {
 
         let tryAgain = response.result != .permanentError && response.result != .success
 
         switch size {
         case .preview:
-            if !tryAgain {
-                requestedPreviewAssets.removeValue(forKey: user)
-            }
-            requestedPreviewAssetsInProgress.remove(user)
+            requestedPreviewAssets.complete(user, retry: tryAgain)
         case .complete:
-            if !tryAgain {
-                requestedCompleteAssets.removeValue(forKey: user)
-            }
-            requestedCompleteAssetsInProgress.remove(user)
+            requestedCompleteAssets.complete(user, retry: tryAgain)
+        }
+
+        let imageData = response.result == .success ? response.imageData ?? response.rawData : nil
+
+        if size == .preview, let imageData = imageData, let previewKey = assetKeys?.preview {
+            assetCache.store(imageData, forAssetKey: previewKey)
         }
 
         uiContext.performGroupedBlock {
             guard let searchUser = self.uiContext.zm_searchUserCache?.object(forKey: user as NSUUID) else { return }
 
-            if response.result == .success {
-                if let imageData = response.imageData ?? response.rawData {
-                    searchUser.updateImageData(for: size, imageData: imageData)
-                }
+            if let imageData = imageData {
+                searchUser.updateImageData(for: size, imageData: imageData)
             } else if response.result == .permanentError {
                 searchUser.reportImageDataHasBeenDeleted()
             }
         }
     }
 
+    private func deliverImageData(_ imageData: Data, size: ProfileImageSize, for user: UUID) {
+        uiContext.performGroupedBlock {
+            self.uiContext.zm_searchUserCache?.object(forKey: user as NSUUID)?.updateImageData(for: size, imageData: imageData)
+        }
+    }
+
     func fetchUserProfilesRequest(apiVersion: APIVersion) -> ZMTransportRequest? {
-        let missingFullProfiles = requestedMissingFullProfiles.subtracting(requestedMissingFullProfilesInProgress)
+        let pendingProfiles = requestedMissingFullProfiles.subtracting(requestedMissingFullProfilesInProgress)
+
+        guard pendingProfiles.count > 0 else {
+            firstPendingProfileRequestDate = nil
+            return nil
+        }
 
-        guard missingFullProfiles.count > 0 else { return nil }
+        guard isProfileBatchReady(pendingCount: pendingProfiles.count) else {
+            scheduleProfileBatchFlush()
+            return nil
+        }
+
+        let missingFullProfiles = Set(pendingProfiles.prefix(Self.maxProfileBatchSize))
 
         requestedMissingFullProfilesInProgress.formUnion(missingFullProfiles)
+        firstPendingProfileRequestDate = pendingProfiles.count > missingFullProfiles.count ? Date.distantPast : nil
+        updateStatistics { $0.profileRequestCount += 1 }
 
         return SearchUserImageStrategy.requestForFetchingFullProfile(for: missingFullProfiles, apiVersion: apiVersion, completionHandler: ZMCompletionHandler(on: managedObjectContext, block: { (response) in
 
@@ -222,15 +378,32 @@ public class SearchUserImageStrategy: AbstractRequestStrategy {
         }))
     }
 
-    func updateAssetKeys(_ assetKeys: SearchUserAssetKeys, for userId: UUID) {
-        syncContext.performGroupedBlock {
-            if self.requestedPreviewAssets.keys.contains(userId) {
-                self.requestedPreviewAssets[userId] = assetKeys
-            }
+    /// Profiles are fetched once the batching interval elapsed since the first
+    /// pending request, or as soon as there are enough users to fill a request
+    private func isProfileBatchReady(pendingCount: Int) -> Bool {
+        guard pendingCount < Self.maxProfileBatchSize, let firstPendingDate = firstPendingProfileRequestDate else {
+            return true
+        }
+
+        return -firstPendingDate.timeIntervalSinceNow >= profileBatchingInterval
+    }
 
-            if self.requestedCompleteAssets.keys.contains(userId) {
-                self.requestedCompleteAssets[userId] = assetKeys
+    private func scheduleProfileBatchFlush() {
+        guard !isProfileBatchFlushScheduled else { return }
+
+        isProfileBatchFlushScheduled = true
+        DispatchQueue.main.asyncAfter(deadline: .now() + profileBatchingInterval) { [weak self] in
+            self?.syncContext.performGroupedBlock {
+                self?.isProfileBatchFlushScheduled = false
+                RequestAvailableNotification.notifyNewRequestsAvailable(nil)
             }
+        }
+    }
+
+    func updateAssetKeys(_ assetKeys: SearchUserAssetKeys, for userId: UUID) {
+        syncContext.performGroupedBlock {
+            self.requestedPreviewAssets.update(assetKeys, for: userId)
+            self.requestedCompleteAssets.update(assetKeys, for: userId)
 
             RequestAvailableNotification.notifyNewRequestsAvailable(nil)
         }
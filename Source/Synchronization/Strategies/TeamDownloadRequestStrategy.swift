@@ -92,15 +92,28 @@ fileprivate extension Team {
 /// Responsible for downloading the team which the self user belongs to during the slow sync
 /// and for updating it when processing events or when manually requested.
 
-public final class TeamDownloadRequestStrategy: AbstractRequestStrategy, ZMContextChangeTrackerSource, ZMEventConsumer, ZMSingleRequestTranscoder, ZMDownstreamTranscoder {
+public final class TeamDownloadRequestStrategy: AbstractRequestStrategy, ZMContextChangeTrackerSource, BatchPrefetchingEventConsumer, ZMSingleRequestTranscoder, ZMDownstreamTranscoder {
 
     private (set) var downstreamSync: ZMDownstreamObjectSync!
     private (set) var slowSync: ZMSingleRequestSync!
 
     fileprivate unowned var syncStatus: SyncStatus
+    fileprivate let fingerprints: SlowSyncFingerprints
+
+    /// Users and teams of the team member events of the batch being processed
+    fileprivate var memberEventsPrefetch: MemberEventsPrefetch?
+
+    /// Counted since the strategy was created
+    struct MemberEventsStatistics: Equatable {
+        /// Number of fetch requests for the users of team member events
+        var userFetchCount = 0
+    }
+
+    private(set) var memberEventsStatistics = MemberEventsStatistics()
 
     public init(withManagedObjectContext managedObjectContext: NSManagedObjectContext, applicationStatus: ApplicationStatus, syncStatus: SyncStatus) {
         self.syncStatus = syncStatus
+        self.fingerprints = SlowSyncFingerprints(keyValueStore: managedObjectContext)
         super.init(withManagedObjectContext: managedObjectContext, applicationStatus: applicationStatus)
         configuration = [.allowsRequestsWhileOnline, .allowsRequestsDuringSlowSync]
         downstreamSync = ZMDownstreamObjectSync(
@@ -148,8 +161,12 @@ public final class TeamDownloadRequestStrategy: AbstractRequestStrategy, ZMConte
         case .teamMemberJoin: processAddedMember(with: event)
         case .teamMemberLeave: processRemovedMember(with: event)
         case .teamMemberUpdate: processUpdatedMember(with: event)
-        default: break
+        default: return
         }
+
+        // The members or roles were changed outside of the slow sync, the next one needs to apply them again
+        fingerprints.invalidate(.teamMembers)
+        fingerprints.invalidate(.teamRoles)
     }
 
     private func createTeam(with event: ZMUpdateEvent) {
@@ -171,19 +188,19 @@ public final class TeamDownloadRequestStrategy: AbstractRequestStrategy, ZMConte
     }
 
     private func processAddedMember(with event: ZMUpdateEvent) {
-        guard let identifier = event.teamId, let data = event.dataPayload else { return }
-        guard let team = Team.fetchOrCreate(with: identifier, create: false, in: managedObjectContext, created: nil) else { return }
-        guard let addedUserId = (data[TeamEventPayloadKey.user.rawValue] as? String).flatMap(UUID.init) else { return }
-        let user = ZMUser.fetchOrCreate(with: addedUserId, domain: nil, in: managedObjectContext)
+        guard let identifier = event.teamId else { return }
+        guard let team = team(with: identifier) else { return }
+        guard let addedUserId = event.teamMemberUserID else { return }
+        guard let user = user(with: addedUserId, createIfNeeded: true) else { return }
         user.needsToBeUpdatedFromBackend = true
         _ = Member.getOrCreateMember(for: user, in: team, context: managedObjectContext)
     }
 
     private func processRemovedMember(with event: ZMUpdateEvent) {
-        guard let identifier = event.teamId, let data = event.dataPayload else { return }
-        guard let team = Team.fetchOrCreate(with: identifier, create: false, in: managedObjectContext, created: nil) else { return }
-        guard let removedUserId = (data[TeamEventPayloadKey.user.rawValue] as? String).flatMap(UUID.init) else { return }
-        guard let user = ZMUser.fetch(with: removedUserId, in: managedObjectContext) else { return }
+        guard let identifier = event.teamId else { return }
+        guard let team = team(with: identifier) else { return }
+        guard let removedUserId = event.teamMemberUserID else { return }
+        guard let user = user(with: removedUserId, createIfNeeded: false) else { return }
         if let member = user.membership {
             if user.isSelfUser {
                 deleteAccount()
@@ -197,10 +214,64 @@ public final class TeamDownloadRequestStrategy: AbstractRequestStrategy, ZMConte
     }
 
     private func processUpdatedMember(with event: ZMUpdateEvent) {
-        guard nil != event.teamId, let data = event.dataPayload else { return }
-        guard let userId = (data[TeamEventPayloadKey.user.rawValue] as? String).flatMap(UUID.init) else { return }
-        guard let member = Member.fetch(with: userId, in: managedObjectContext) else { return }
-        member.needsToBeUpdatedFromBackend = true
+        guard nil != event.teamId else { return }
+        guard let userId = event.teamMemberUserID else { return }
+
+        let member: Member?
+        if memberEventsPrefetch?.userIDs.contains(userId) == true {
+            member = user(with: userId, createIfNeeded: false)?.membership
+        } else {
+            member = Member.fetch(with: userId, in: managedObjectContext)
+        }
+
+        member?.needsToBeUpdatedFromBackend = true
+    }
+
+    /// Looks up the team in the prefetched teams of the batch before fetching it
+    private func team(with identifier: UUID) -> Team? {
+        if let team = memberEventsPrefetch?.teams[identifier], !team.isDeleted {
+            return team
+        }
+
+        return Team.fetchOrCreate(with: identifier, create: false, in: managedObjectContext, created: nil)
+    }
+
+    /// Looks up the user in the prefetched users of the batch before fetching it. Users which the prefetch
+    /// didn't find may have been inserted since, so they are looked up in the pending inserts of the
+    /// context before creating them, which doesn't need another fetch.
+    private func user(with identifier: UUID, createIfNeeded: Bool) -> ZMUser? {
+        guard memberEventsPrefetch?.userIDs.contains(identifier) == true else {
+            memberEventsStatistics.userFetchCount += 1
+
+            if createIfNeeded {
+                return ZMUser.fetchOrCreate(with: identifier, domain: nil, in: managedObjectContext)
+            } else {
+                return ZMUser.fetch(with: identifier, in: managedObjectContext)
+            }
+        }
+
+        if let user = memberEventsPrefetch?.users[identifier] {
+            return user
+        }
+
+        var user = insertedUser(with: identifier)
+
+        if user == nil, createIfNeeded {
+            let insertedUser = ZMUser.insertNewObject(in: managedObjectContext)
+            insertedUser.remoteIdentifier = identifier
+            user = insertedUser
+        }
+
+        memberEventsPrefetch?.users[identifier] = user
+        return user
+    }
+
+    private func insertedUser(with identifier: UUID) -> ZMUser? {
+        for case let user as ZMUser in managedObjectContext.insertedObjects where user.remoteIdentifier == identifier {
+            return user
+        }
+
+        return nil
     }
 
     private func deleteTeamAndConversations(_ team: Team) {
@@ -213,6 +284,39 @@ public final class TeamDownloadRequestStrategy: AbstractRequestStrategy, ZMConte
         notification.post(in: managedObjectContext.notificationContext)
     }
 
+    // MARK: - BatchPrefetchingEventConsumer
+
+    func prefetchObjects(toProcessEvents events: [ZMUpdateEvent]) {
+        let memberEventTypes: [ZMUpdateEventType] = [.teamMemberJoin, .teamMemberLeave, .teamMemberUpdate]
+        let memberEvents = events.filter { memberEventTypes.contains($0.type) }
+        guard !memberEvents.isEmpty else { return }
+
+        let userIDs = Set(memberEvents.compactMap(\.teamMemberUserID))
+        let teamIDs = Set(memberEvents.compactMap(\.teamId))
+
+        let fetchRequest = NSFetchRequest<ZMUser>(entityName: ZMUser.entityName())
+        fetchRequest.predicate = NSPredicate(format: "%K IN %@", ZMUser.remoteIdentifierDataKey()!, userIDs.map { $0.uuidData as NSData })
+        fetchRequest.relationshipKeyPathsForPrefetching = ["membership"]
+
+        let users = managedObjectContext.fetchOrAssert(request: fetchRequest)
+        memberEventsStatistics.userFetchCount += 1
+
+        let usersByID = users.reduce(into: [UUID: ZMUser]()) { usersByID, user in
+            guard let remoteIdentifier = user.remoteIdentifier, usersByID[remoteIdentifier] == nil else { return }
+            usersByID[remoteIdentifier] = user
+        }
+
+        let teamsByID = teamIDs.reduce(into: [UUID: Team]()) { teamsByID, teamID in
+            teamsByID[teamID] = Team.fetchOrCreate(with: teamID, create: false, in: managedObjectContext, created: nil)
+        }
+
+        memberEventsPrefetch = MemberEventsPrefetch(userIDs: userIDs, users: usersByID, teams: teamsByID)
+    }
+
+    func didProcessEvents() {
+        memberEventsPrefetch = nil
+    }
+
     // MARK: - ZMSingleRequestTranscoder
 
     public func request(for sync: ZMSingleRequestSync, apiVersion: APIVersion) -> ZMTransportRequest? {
@@ -271,6 +375,20 @@ fileprivate extension ZMUpdateEvent {
     var dataPayload: [String: Any]? {
         return payload[TeamEventPayloadKey.data.rawValue] as? [String: Any]
     }
+
+    var teamMemberUserID: UUID? {
+        return (dataPayload?[TeamEventPayloadKey.user.rawValue] as? String).flatMap(UUID.init)
+    }
+}
+
+fileprivate struct MemberEventsPrefetch {
+
+    /// Users referenced by the member events, whether they were found or not
+    let userIDs: Set<UUID>
+
+    var users: [UUID: ZMUser]
+    let teams: [UUID: Team]
+
 }
 
 private  enum TeamEventPayloadKey: String {
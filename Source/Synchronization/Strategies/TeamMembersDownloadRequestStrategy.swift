@@ -24,12 +24,14 @@ public final class TeamMembersDownloadRequestStrategy: AbstractRequestStrategy,
 
     let syncStatus: SyncStatus
     var sync: ZMSingleRequestSync!
+    let fingerprints: SlowSyncFingerprints
 
     public init(withManagedObjectContext managedObjectContext: NSManagedObjectContext,
                 applicationStatus: ApplicationStatus,
                 syncStatus: SyncStatus) {
 
         self.syncStatus = syncStatus
+        self.fingerprints = SlowSyncFingerprints(keyValueStore: managedObjectContext)
 
         super.init(withManagedObjectContext: managedObjectContext,
                    applicationStatus: applicationStatus)
@@ -66,12 +68,19 @@ public final class TeamMembersDownloadRequestStrategy: AbstractRequestStrategy,
             return
         }
 
-        if !payload.hasMore {
+        let isUnchanged = !team.members.isEmpty && fingerprints.isUnchanged(rawData, for: .teamMembers)
+        var objectsWritten = 0
+
+        if !payload.hasMore && !isUnchanged {
             payload.members.forEach { (membershipPayload) in
                 membershipPayload.createOrUpdateMember(team: team, in: managedObjectContext)
             }
+
+            fingerprints.update(rawData, for: .teamMembers)
+            objectsWritten = payload.members.count
         }
 
+        syncStatus.recordSlowSyncPayload(phase: .fetchingTeamMembers, byteCount: rawData.count, objectsWritten: objectsWritten, isUnchanged: isUnchanged)
         completeSyncPhase()
     }
 
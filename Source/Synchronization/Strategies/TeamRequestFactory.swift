@@ -40,4 +40,10 @@ final public class TeamDownloadRequestFactory {
         return ZMTransportRequest(getFromPath: path, apiVersion: apiVersion.rawValue)
     }
 
+    public static func getMembersRequest(for identifiers: [UUID], in teamIdentifier: UUID, apiVersion: APIVersion) -> ZMTransportRequest {
+        let path = teamPath + "/" + teamIdentifier.transportString() + "/get-members-by-ids-using-post"
+        let payload = ["user_ids": identifiers.map { $0.transportString() }]
+        return ZMTransportRequest(path: path, method: .methodPOST, payload: payload as ZMTransportData, apiVersion: apiVersion.rawValue)
+    }
+
 }
@@ -22,8 +22,10 @@ fileprivate extension Team {
         NSPredicate(format: "%K == YES AND %K != NULL", #keyPath(Team.needsToDownloadRoles), Team.remoteIdentifierDataKey()!)
     }()
 
-    func updateRoles(with payload: [String: Any]) {
-        guard let rolesPayload = payload["conversation_roles"] as? [[String: Any]] else { return }
+    /// - returns: the number of roles which were inserted, updated or deleted
+    @discardableResult
+    func updateRoles(with payload: [String: Any]) -> Int {
+        guard let rolesPayload = payload["conversation_roles"] as? [[String: Any]] else { return 0 }
         let existingRoles = self.roles
 
         // Update or insert new roles
@@ -36,6 +38,8 @@ fileprivate extension Team {
         rolesToDelete.forEach {
             managedObjectContext?.delete($0)
         }
+
+        return newRoles.count + rolesToDelete.count
     }
 
 }
@@ -44,9 +48,11 @@ public final class TeamRolesDownloadRequestStrategy: AbstractRequestStrategy, ZM
 
     private (set) var downstreamSync: ZMDownstreamObjectSync!
     fileprivate unowned var syncStatus: SyncStatus
+    fileprivate let fingerprints: SlowSyncFingerprints
 
     public init(withManagedObjectContext managedObjectContext: NSManagedObjectContext, applicationStatus: ApplicationStatus, syncStatus: SyncStatus) {
         self.syncStatus = syncStatus
+        self.fingerprints = SlowSyncFingerprints(keyValueStore: managedObjectContext)
         super.init(withManagedObjectContext: managedObjectContext, applicationStatus: applicationStatus)
         downstreamSync = ZMDownstreamObjectSync(
             transcoder: self,
@@ -76,11 +82,11 @@ public final class TeamRolesDownloadRequestStrategy: AbstractRequestStrategy, ZM
     fileprivate let expectedSyncPhase = SyncPhase.fetchingTeamRoles
 
     fileprivate var isSyncing: Bool {
-        return syncStatus.currentSyncPhase == self.expectedSyncPhase
+        return syncStatus.isActive(phase: self.expectedSyncPhase)
     }
 
     private func completeSyncPhaseIfNoTeam() {
-        if self.syncStatus.currentSyncPhase == self.expectedSyncPhase && !self.downstreamSync.hasOutstandingItems {
+        if self.isSyncing && !self.downstreamSync.hasOutstandingItems {
             self.syncStatus.finishCurrentSyncPhase(phase: self.expectedSyncPhase)
         }
     }
@@ -98,9 +104,25 @@ public final class TeamRolesDownloadRequestStrategy: AbstractRequestStrategy, ZM
             let payload = response.payload?.asDictionary() as? [String: Any] else { return }
 
         team.needsToDownloadRoles = false
-        team.updateRoles(with: payload)
+
+        let rawData = response.rawData
+        var isUnchanged = false
+        var objectsWritten = 0
+
+        if let rawData = rawData, !team.roles.isEmpty {
+            isUnchanged = fingerprints.isUnchanged(rawData, for: .teamRoles)
+        }
+
+        if !isUnchanged {
+            objectsWritten = team.updateRoles(with: payload)
+
+            if let rawData = rawData {
+                fingerprints.update(rawData, for: .teamRoles)
+            }
+        }
 
         if self.isSyncing {
+            self.syncStatus.recordSlowSyncPayload(phase: self.expectedSyncPhase, byteCount: rawData?.count ?? 0, objectsWritten: objectsWritten, isUnchanged: isUnchanged)
             self.syncStatus.finishCurrentSyncPhase(phase: self.expectedSyncPhase)
         }
     }
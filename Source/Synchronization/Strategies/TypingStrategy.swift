@@ -42,8 +42,9 @@ public struct TypingEvent {
 
     static func typingEvent(with objectID: NSManagedObjectID,
                             isTyping: Bool,
-                            ifDifferentFrom other: TypingEvent?) -> TypingEvent? {
-        let newEvent = TypingEvent(date: Date(), objectID: objectID, isTyping: isTyping)
+                            ifDifferentFrom other: TypingEvent?,
+                            at date: Date = Date()) -> TypingEvent? {
+        let newEvent = TypingEvent(date: date, objectID: objectID, isTyping: isTyping)
         if let other = other, newEvent.isEqual(other: other) {
             return nil
         }
@@ -58,60 +59,169 @@ public struct TypingEvent {
 
 }
 
+/// Counts the typing state changes of the self user which were sent to the backend
+/// and the ones which were dropped because they were superseded or redundant.
+public struct TypingRequestStatistics: CustomStringConvertible {
+
+    public fileprivate(set) var sentRequests = 0
+    public fileprivate(set) var suppressedRequests = 0
+
+    public var description: String {
+        return "\(sentRequests) sent, \(suppressedRequests) suppressed"
+    }
+
+}
+
 class TypingEventQueue {
 
-    /// conversations with their current isTyping state
+    /// Minimum time between a request and a following started typing request in the same conversation,
+    /// so that typing which is rapidly started and stopped doesn't send a request for every change
+    static let minimumResendInterval: TimeInterval = 1
+
+    /// Time for which stopping is held back, so that typing which resumes right away doesn't send
+    /// a stop followed by a start, which would be held back by the `minimumResendInterval`
+    static let defaultStopGraceInterval: TimeInterval = 0.5
+
+    /// Maximum number of requests which are sent within `requestLimitInterval` for all conversations
+    static let requestLimit = 4
+    static let requestLimitInterval: TimeInterval = 2
+
+    /// conversations with their pending isTyping state
     var conversations: [NSManagedObjectID: Bool] = [:]
 
+    /// dates at which the pending stopped typing states were added
+    private var stopDates: [NSManagedObjectID: Date] = [:]
+
     /// conversations that started typing, but never ended
     var unbalancedConversations: Set<NSManagedObjectID> = Set()
 
-    /// last event that has been requested
-    var lastSentTypingEvent: TypingEvent?
+    /// last event that has been requested for each conversation
+    var lastSentTypingEvents: [NSManagedObjectID: TypingEvent] = [:]
+
+    /// The earliest date at which a pending event, which is held back by the throttling, can be sent
+    private(set) var nextEventDate: Date?
+
+    private(set) var statistics = TypingRequestStatistics()
+
+    /// Dates of the requests sent within the last `requestLimitInterval`
+    private var recentRequestDates: [Date] = []
+
+    let stopGraceInterval: TimeInterval
+
+    init(stopGraceInterval: TimeInterval = defaultStopGraceInterval) {
+        self.stopGraceInterval = stopGraceInterval
+    }
 
     /// Adds the conversation to the "queue"
-    /// If `isTyping` is true, it turns all other conversation events to endTyping events
-    func addItem(conversationID: NSManagedObjectID, isTyping: Bool) {
+    /// If `isTyping` is true, it turns the typing in all other conversations into endTyping events
+    func addItem(conversationID: NSManagedObjectID, isTyping: Bool, at date: Date = Date()) {
         if isTyping {
             // end all previous typings
-            conversations.forEach {
-                conversations[$0.key] = false
-            }
-            unbalancedConversations.forEach {
-                conversations[$0] = false
-            }
-            unbalancedConversations.insert(conversationID)
+            unbalancedConversations
+                .filter { $0 != conversationID }
+                .forEach { setPendingState(false, for: $0, at: date) }
+            unbalancedConversations = [conversationID]
         } else {
             unbalancedConversations.remove(conversationID)
         }
-        conversations[conversationID] = isTyping
+        setPendingState(isTyping, for: conversationID, at: date)
     }
 
-    /// Returns the next typing event that is different from the last sent typing event
-    func nextEvent() -> TypingEvent? {
-        var event: TypingEvent?
+    /// Replaces the pending state of the conversation, a state which wasn't sent yet is never sent
+    private func setPendingState(_ isTyping: Bool, for conversationID: NSManagedObjectID, at date: Date) {
+        if conversations.updateValue(isTyping, forKey: conversationID) != nil {
+            statistics.suppressedRequests += 1
+        }
 
-        while event == nil, let (convObjectID, isTyping) = conversations.popFirst() {
-            event = TypingEvent.typingEvent(with: convObjectID, isTyping: isTyping, ifDifferentFrom: lastSentTypingEvent)
+        if isTyping {
+            stopDates.removeValue(forKey: conversationID)
+        } else if stopDates[conversationID] == nil {
+            stopDates[conversationID] = date
         }
-        if let anEvent = event {
-            lastSentTypingEvent = anEvent
+    }
+
+    @discardableResult
+    private func removePendingState(for conversationID: NSManagedObjectID) -> Bool? {
+        stopDates.removeValue(forKey: conversationID)
+        return conversations.removeValue(forKey: conversationID)
+    }
+
+    /// Returns the next typing event that is different from the last sent typing event of its conversation.
+    /// Events which can't be sent yet because of the throttling stay in the queue until `nextEventDate`.
+    func nextEvent(at date: Date = Date()) -> TypingEvent? {
+        recentRequestDates.removeAll { date.timeIntervalSince($0) >= Self.requestLimitInterval }
+        nextEventDate = nil
+
+        for (conversationID, isTyping) in conversations {
+            let lastSentEvent = lastSentTypingEvents[conversationID]
+
+            guard let event = TypingEvent.typingEvent(with: conversationID, isTyping: isTyping, ifDifferentFrom: lastSentEvent, at: date) else {
+                removePendingState(for: conversationID)
+                statistics.suppressedRequests += 1
+                continue
+            }
+
+            // Stopping is only held back for a short time, so that nobody sees the self user typing for too long
+            if !isTyping, let stopDate = stopDates[conversationID] {
+                let sendDate = stopDate.addingTimeInterval(stopGraceInterval)
+                guard sendDate <= date else {
+                    holdEvents(until: sendDate)
+                    continue
+                }
+            }
+
+            if isTyping, let lastSentEvent = lastSentEvent {
+                let resendDate = lastSentEvent.date.addingTimeInterval(Self.minimumResendInterval)
+                guard resendDate <= date else {
+                    holdEvents(until: resendDate)
+                    continue
+                }
+            }
+
+            guard recentRequestDates.count < Self.requestLimit else {
+                holdEvents(until: recentRequestDates[0].addingTimeInterval(Self.requestLimitInterval))
+                return nil
+            }
+
+            removePendingState(for: conversationID)
+            lastSentTypingEvents[conversationID] = event
+            recentRequestDates.append(date)
+            statistics.sentRequests += 1
+
+            return event
         }
-        return event
+
+        return nil
+    }
+
+    private func holdEvents(until date: Date) {
+        nextEventDate = min(nextEventDate ?? date, date)
     }
 
     func clear(conversationID: NSManagedObjectID) {
-        conversations.removeValue(forKey: conversationID)
+        if removePendingState(for: conversationID) != nil {
+            statistics.suppressedRequests += 1
+        }
+        lastSentTypingEvents.removeValue(forKey: conversationID)
     }
 }
 
-public class TypingStrategy: AbstractRequestStrategy, TearDownCapable, ZMEventConsumer {
+public class TypingStrategy: AbstractRequestStrategy, TearDownCapable, ZMEventConsumer, ZMTimerClient {
 
     fileprivate var typing: Typing!
-    fileprivate let typingEventQueue = TypingEventQueue()
+    fileprivate let typingEventQueue: TypingEventQueue
     fileprivate var tornDown: Bool = false
     fileprivate var observers: [Any] = []
 
+    /// Fires when the typing events which were held back by the throttling can be sent
+    fileprivate var throttlingTimer: ZMTimer?
+    private(set) var throttlingTimerDate: Date?
+
+    /// Typing requests sent and suppressed since the strategy was created
+    public var statistics: TypingRequestStatistics {
+        return typingEventQueue.statistics
+    }
+
     @available (*, unavailable)
     override init(withManagedObjectContext moc: NSManagedObjectContext, applicationStatus: ApplicationStatus) {
         fatalError()
@@ -121,8 +231,14 @@ public class TypingStrategy: AbstractRequestStrategy, TearDownCapable, ZMEventCo
         self.init(applicationStatus: applicationStatus, syncContext: managedObjectContext, uiContext: managedObjectContext.zm_userInterface, typing: nil)
     }
 
-    init(applicationStatus: ApplicationStatus, syncContext: NSManagedObjectContext, uiContext: NSManagedObjectContext, typing: Typing?) {
+    /// - parameter stopGraceInterval: time for which stopped typing is held back
+    init(applicationStatus: ApplicationStatus,
+         syncContext: NSManagedObjectContext,
+         uiContext: NSManagedObjectContext,
+         typing: Typing?,
+         stopGraceInterval: TimeInterval = TypingEventQueue.defaultStopGraceInterval) {
         self.typing = typing ?? Typing(uiContext: uiContext, syncContext: syncContext)
+        self.typingEventQueue = TypingEventQueue(stopGraceInterval: stopGraceInterval)
         super.init(withManagedObjectContext: syncContext, applicationStatus: applicationStatus)
         self.configuration = [
             .allowsRequestsWhileInBackground,
@@ -177,7 +293,6 @@ public class TypingStrategy: AbstractRequestStrategy, TearDownCapable, ZMEventCo
         managedObjectContext.performGroupedBlock {
             if clearIsTyping {
                 self.typingEventQueue.clear(conversationID: conversation.objectID)
-                self.typingEventQueue.lastSentTypingEvent = nil
             } else {
                 self.typingEventQueue.addItem(conversationID: conversation.objectID, isTyping: isTyping)
                 RequestAvailableNotification.notifyNewRequestsAvailable(self)
@@ -186,7 +301,13 @@ public class TypingStrategy: AbstractRequestStrategy, TearDownCapable, ZMEventCo
     }
 
     public override func nextRequestIfAllowed(for apiVersion: APIVersion) -> ZMTransportRequest? {
-        guard let typingEvent = typingEventQueue.nextEvent(),
+        let typingEvent = typingEventQueue.nextEvent()
+
+        if let nextEventDate = typingEventQueue.nextEventDate {
+            scheduleThrottlingTimer(for: nextEventDate)
+        }
+
+        guard let typingEvent = typingEvent,
               let conversation = managedObjectContext.object(with: typingEvent.objectID) as? ZMConversation,
               let remoteIdentifier = conversation.remoteIdentifier
         else { return nil }
@@ -208,9 +329,36 @@ public class TypingStrategy: AbstractRequestStrategy, TearDownCapable, ZMEventCo
         return request
     }
 
+    /// Schedules the throttling timer, unless it already fires earlier
+    func scheduleThrottlingTimer(for date: Date) {
+        if let throttlingTimerDate = throttlingTimerDate, throttlingTimerDate <= date {
+            return
+        }
+
+        throttlingTimer?.cancel()
+        throttlingTimer = ZMTimer(target: self)
+        throttlingTimer?.fire(at: date)
+        throttlingTimerDate = date
+    }
+
+    // MARK: - ZMTimerClient
+
+    public func timerDidFire(_ timer: ZMTimer!) {
+        managedObjectContext.performGroupedBlock {
+            guard timer === self.throttlingTimer else { return }
+
+            self.throttlingTimer = nil
+            self.throttlingTimerDate = nil
+            RequestAvailableNotification.notifyNewRequestsAvailable(self)
+        }
+    }
+
     // MARK: - TearDownCapable
 
     public func tearDown() {
+        throttlingTimer?.cancel()
+        throttlingTimer = nil
+        throttlingTimerDate = nil
         typing.tearDown()
         typing = nil
         tornDown = true
@@ -43,6 +43,7 @@ public class StrategyDirectory: NSObject, StrategyDirectoryProtocol {
          flowManager: FlowManagerType,
          updateEventProcessor: UpdateEventProcessor,
          localNotificationDispatcher: LocalNotificationDispatcher,
+         searchUserAssetCache: SearchUserAssetCache,
          useLegacyPushNotifications: Bool) {
 
         self.strategies = Self.buildStrategies(contextProvider: contextProvider,
@@ -52,6 +53,7 @@ public class StrategyDirectory: NSObject, StrategyDirectoryProtocol {
                                                flowManager: flowManager,
                                                updateEventProcessor: updateEventProcessor,
                                                localNotificationDispatcher: localNotificationDispatcher,
+                                               searchUserAssetCache: searchUserAssetCache,
                                                useLegacyPushNotifications: useLegacyPushNotifications)
 
         self.requestStrategies = strategies.compactMap({ $0 as? RequestStrategy})
@@ -82,6 +84,7 @@ public class StrategyDirectory: NSObject, StrategyDirectoryProtocol {
                                 flowManager: FlowManagerType,
                                 updateEventProcessor: UpdateEventProcessor,
                                 localNotificationDispatcher: LocalNotificationDispatcher,
+                                searchUserAssetCache: SearchUserAssetCache,
                                 useLegacyPushNotifications: Bool) -> [Any] {
 
         let syncMOC = contextProvider.syncContext
@@ -173,7 +176,8 @@ public class StrategyDirectory: NSObject, StrategyDirectoryProtocol {
                 managedObjectContext: syncMOC),
             SearchUserImageStrategy(
                 applicationStatus: applicationStatusDirectory,
-                managedObjectContext: syncMOC),
+                managedObjectContext: syncMOC,
+                assetCache: searchUserAssetCache),
             ConnectionRequestStrategy(
                 withManagedObjectContext: syncMOC,
                 applicationStatus: applicationStatusDirectory,
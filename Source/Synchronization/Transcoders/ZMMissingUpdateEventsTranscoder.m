@@ -189,6 +189,10 @@ NSUInteger const ZMMissingUpdateEventsTranscoderListPageSize = 500;
     [self.eventProcessor storeUpdateEvents:parsedEvents ignoreBuffer:YES];
     [self.pushNotificationStatus didFetchEventIds:eventIds lastEventId:latestEventId finished:!self.listPaginator.hasMoreToFetch];
     
+    if (self.isSyncing) {
+        [self.syncStatus didFetchMissedEventsWithIDs:eventIds];
+    }
+    
     [tp warnIfLongerThanInterval];
     return latestEventId;
 }
@@ -259,6 +263,10 @@ NSUInteger const ZMMissingUpdateEventsTranscoderListPageSize = 500;
         // We only reset the paginator if it is neither in progress nor has more pages to fetch.
         if (self.listPaginator.status != ZMSingleRequestInProgress && !self.listPaginator.hasMoreToFetch) {
             [self.listPaginator resetFetching];
+            
+            if (self.isSyncing) {
+                [self.syncStatus didStartFetchingMissedEvents];
+            }
         }
 
         ZMTransportRequest *request = [self.listPaginator nextRequestForAPIVersion:apiVersion];
@@ -321,6 +329,11 @@ NSUInteger const ZMMissingUpdateEventsTranscoderListPageSize = 500;
         }
         else {
             self.lastUpdateEventID = latestEventId;
+            
+            // The events of the page are stored by now. Save the checkpoint right away, so that
+            // the stream is resumed after them when the fetch is restarted or the app relaunched,
+            // instead of fetching and storing the page again.
+            [self.managedObjectContext saveOrRollback];
         }
     }
     
@@ -20,6 +20,7 @@
 @import Foundation;
 
 @class ZMHotFixDirectory;
+@class ZMHotFixPatch;
 
 extern NSString * const ZMSkipHotfix;
 
@@ -33,6 +34,10 @@ extern NSString * const ZMSkipHotfix;
 /// It checks if there is a last version stored in the persistentStore and then applies patches (once) for older versions and saves the current version in the persistentStore
 - (void)applyPatches;
 
+/// Applies all chunks of the patch in one go, saving the progress after each chunk so that an interrupted patch
+/// resumes where it stopped. Must be called on the sync context.
+- (void)applyAllChunksOfPatch:(ZMHotFixPatch *)patch;
+
 
 @end
 
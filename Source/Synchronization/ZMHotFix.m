@@ -28,6 +28,12 @@
 
 static NSString* ZMLogTag ZM_UNUSED = @"HotFix";
 static NSString * const LastSavedVersionKey = @"lastSavedVersion";
+static NSString * const PatchInProgressVersionKey = @"hotFixPatchInProgressVersion";
+static NSString * const PatchInProgressOffsetKey = @"hotFixPatchInProgressOffset";
+
+/// After applying patches for this long, the remaining patches are applied in a later block,
+/// so that the other work scheduled on the sync context isn't blocked until all patches are applied
+static NSTimeInterval const MaximumPatchingDurationPerBlock = 0.25;
 NSString * const ZMSkipHotfix = @"ZMSkipHotfix";
 
 @interface ZMHotFix ()
@@ -90,14 +96,73 @@ NSString * const ZMSkipHotfix = @"ZMSkipHotfix";
     }
     
     ZMLogDebug(@"Applying HotFix with last saved version %@, current version %@.", lastSavedVersion.versionString, currentVersion.versionString);
+    [self applyPatches:[self patchesSinceVersion:lastSavedVersion] currentVersion:currentVersionString];
+}
+
+/// Applies the patches in blocks of at most `MaximumPatchingDurationPerBlock`. The progress is saved after each chunk
+/// of a chunked patch and before yielding, so that the patches are resumed where they stopped when the app is killed.
+- (void)applyPatches:(NSArray<ZMHotFixPatch *> *)patches currentVersion:(NSString *)currentVersionString
+{
     [self.syncMOC performGroupedBlock:^{
-        [self applyFixesSinceVersion:lastSavedVersion];///TODO: exception here
+        NSDate *startDate = [NSDate date];
+        NSArray<ZMHotFixPatch *> *remainingPatches = patches;
+
+        while (remainingPatches.count > 0) {
+            if (-[startDate timeIntervalSinceNow] > MaximumPatchingDurationPerBlock) {
+                ZMLogDebug(@"Yielding HotFix with %lu patches remaining", (unsigned long)remainingPatches.count);
+                [self.syncMOC saveOrRollback];
+                [self applyPatches:remainingPatches currentVersion:currentVersionString];
+                return;
+            }
+
+            ZMHotFixPatch *patch = remainingPatches.firstObject;
+            if ([self applyChunkOfPatch:patch]) {
+                [self saveNewVersion:patch.version];
+                remainingPatches = [remainingPatches subarrayWithRange:NSMakeRange(1, remainingPatches.count - 1)];
+            }
+
+            if (patch.chunkedCode != nil) {
+                [self.syncMOC saveOrRollback];
+            }
+        }
+
         [self saveNewVersion:currentVersionString];
         [self.syncMOC saveOrRollback];
         [ZMRequestAvailableNotification notifyNewRequestsAvailable:self];
     }];
 }
 
+- (void)applyAllChunksOfPatch:(ZMHotFixPatch *)patch
+{
+    while (![self applyChunkOfPatch:patch]) {
+        [self.syncMOC saveOrRollback];
+    }
+    [self.syncMOC saveOrRollback];
+}
+
+/// Applies the next chunk of the patch, or the whole patch if it isn't chunked.
+/// Returns YES if the patch is complete.
+- (BOOL)applyChunkOfPatch:(ZMHotFixPatch *)patch
+{
+    if (patch.chunkedCode == nil) {
+        patch.code(self.syncMOC);
+        return YES;
+    }
+
+    NSInteger offset = 0;
+    if ([[self.syncMOC persistentStoreMetadataForKey:PatchInProgressVersionKey] isEqual:patch.version]) {
+        offset = [[self.syncMOC persistentStoreMetadataForKey:PatchInProgressOffsetKey] integerValue];
+    }
+
+    NSInteger processedCount = patch.chunkedCode(self.syncMOC, offset, ZMHotFixPatchChunkSize);
+    BOOL isComplete = processedCount < ZMHotFixPatchChunkSize;
+
+    [self.syncMOC setPersistentStoreMetadata:isComplete ? nil : patch.version forKey:PatchInProgressVersionKey];
+    [self.syncMOC setPersistentStoreMetadata:isComplete ? nil : @(offset + processedCount) forKey:PatchInProgressOffsetKey];
+
+    return isComplete;
+}
+
 - (ZMVersion *)lastSavedVersion
 {
     NSString *versionString = [self.syncMOC persistentStoreMetadataForKey:LastSavedVersionKey];
@@ -113,16 +178,26 @@ NSString * const ZMSkipHotfix = @"ZMSkipHotfix";
     ZMLogDebug(@"Saved new HotFix version %@", version);
 }
 
-- (void)applyFixesSinceVersion:(ZMVersion *)lastSavedVersion
+/// The patches newer than the last saved version, oldest first
+- (NSArray<ZMHotFixPatch *> *)patchesSinceVersion:(ZMVersion *)lastSavedVersion
 {
+    NSMutableArray<ZMHotFixPatch *> *patches = [NSMutableArray array];
     for(ZMHotFixPatch *patch in self.hotFixDirectory.patches) {
         ZMVersion *version = [[ZMVersion alloc] initWithVersionString:patch.version];
         if ((lastSavedVersion == nil || [version compareWithVersion:lastSavedVersion] == NSOrderedDescending)
-            && patch.code)
+            && (patch.code != nil || patch.chunkedCode != nil))
         {
-            patch.code(self.syncMOC);
+            [patches addObject:patch];
         }
     }
+
+    [patches sortWithOptions:NSSortStable usingComparator:^NSComparisonResult(ZMHotFixPatch *patch1, ZMHotFixPatch *patch2) {
+        ZMVersion *version1 = [[ZMVersion alloc] initWithVersionString:patch1.version];
+        ZMVersion *version2 = [[ZMVersion alloc] initWithVersionString:patch2.version];
+        return [version1 compareWithVersion:version2];
+    }];
+
+    return patches;
 }
 
 @end
@@ -45,12 +45,19 @@ import Foundation
     /// not set the state to `.Done` in this case. We fetch all asset messages without an assetID and set set their uploaded state 
     /// to `.UploadingFailed`, in case this message represents an image we also expire it.
     public static func updateUploadedStateForNotUploadedFileMessages(_ context: NSManagedObjectContext) {
+        applyAllChunks(in: context, of: updateUploadedStateForNotUploadedFileMessages(_:offset:limit:), name: "updateUploadedStateForNotUploadedFileMessages")
+    }
+
+    /// Applies `updateUploadedStateForNotUploadedFileMessages` to at most `limit` messages, starting at `offset`.
+    /// - returns: the number of messages which were processed
+    public static func updateUploadedStateForNotUploadedFileMessages(_ context: NSManagedObjectContext, offset: Int, limit: Int) -> Int {
         let selfUser = ZMUser.selfUser(in: context)
         let predicate = NSPredicate(format: "sender == %@ AND assetId_data == NULL", selfUser)
 
-        let fetchRequest = ZMAssetClientMessage.sortedFetchRequest(with: predicate)
+        let fetchRequest = NSFetchRequest<NSFetchRequestResult>(entityName: ZMAssetClientMessage.entityName())
+        fetchRequest.predicate = predicate
 
-        guard let messages = context.fetchOrAssert(request: fetchRequest) as? [ZMAssetClientMessage] else { return }
+        let messages: [ZMAssetClientMessage] = fetchChunk(of: fetchRequest, sortedBy: "nonce_data", offset: offset, limit: limit, in: context)
 
         messages.forEach { message in
             message.updateTransferState(.uploadingFailed, synchronize: false)
@@ -60,61 +67,54 @@ import Foundation
         }
 
         context.enqueueDelayedSave()
+
+        return messages.count
     }
 
     public static func insertNewConversationSystemMessage(_ context: NSManagedObjectContext) {
-        let fetchRequest = ZMConversation.sortedFetchRequest()
+        applyAllChunks(in: context, of: insertNewConversationSystemMessage(_:offset:limit:), name: "insertNewConversationSystemMessage")
+    }
 
-        guard let conversations = context.fetchOrAssert(request: fetchRequest) as? [ZMConversation] else { return }
+    /// Applies `insertNewConversationSystemMessage` to at most `limit` group conversations, starting at `offset`.
+    /// - returns: the number of conversations which were processed
+    public static func insertNewConversationSystemMessage(_ context: NSManagedObjectContext, offset: Int, limit: Int) -> Int {
+        let conversations: [ZMConversation] = fetchChunk(of: groupConversationsFetchRequest(), sortedBy: ZMConversation.remoteIdentifierDataKey()!, offset: offset, limit: limit, in: context)
+        let systemMessages = newConversationSystemMessages(in: conversations, context: context)
 
         // Add .newConversation system message in all group conversations if not already present
-        conversations.filter { $0.conversationType == .group }.forEach { conversation in
-
-            let fetchRequest = NSFetchRequest<ZMMessage>(entityName: ZMMessage.entityName())
-            fetchRequest.predicate = NSPredicate(format: "%K == %@", ZMMessageConversationKey, conversation.objectID)
-            fetchRequest.sortDescriptors = ZMMessage.defaultSortDescriptors()
-            fetchRequest.fetchLimit = 1
-
-            let messages = context.fetchOrAssert(request: fetchRequest)
-
-            if let firstSystemMessage = messages.first as? ZMSystemMessage, firstSystemMessage.systemMessageType == .newConversation {
-                return // Skip if conversation already has a .newConversation system message
-            }
+        conversations
+            .filter { systemMessages[$0.objectID] == nil }
+            .forEach { $0.appendNewConversationSystemMessage(at: Date.distantPast, users: $0.localParticipants) }
 
-            conversation.appendNewConversationSystemMessage(at: Date.distantPast, users: conversation.localParticipants)
-        }
+        return conversations.count
     }
 
     public static func markAllNewConversationSystemMessagesAsRead(_ context: NSManagedObjectContext) {
+        applyAllChunks(in: context, of: markAllNewConversationSystemMessagesAsRead(_:offset:limit:), name: "markAllNewConversationSystemMessagesAsRead")
+    }
 
-        let fetchRequest = ZMConversation.sortedFetchRequest()
-
-        guard let conversations = context.fetchOrAssert(request: fetchRequest) as? [ZMConversation] else { return }
-
-        conversations.filter({ $0.conversationType == .group }).forEach { conversation in
+    /// Applies `markAllNewConversationSystemMessagesAsRead` to at most `limit` group conversations, starting at `offset`.
+    /// - returns: the number of conversations which were processed
+    public static func markAllNewConversationSystemMessagesAsRead(_ context: NSManagedObjectContext, offset: Int, limit: Int) -> Int {
+        let conversations: [ZMConversation] = fetchChunk(of: groupConversationsFetchRequest(), sortedBy: ZMConversation.remoteIdentifierDataKey()!, offset: offset, limit: limit, in: context)
+        let systemMessages = newConversationSystemMessages(in: conversations, context: context)
 
-            let fetchRequest = NSFetchRequest<ZMMessage>(entityName: ZMMessage.entityName())
-            fetchRequest.predicate = NSPredicate(format: "%K == %@", ZMMessageConversationKey, conversation.objectID)
-            fetchRequest.sortDescriptors = ZMMessage.defaultSortDescriptors()
-            fetchRequest.fetchLimit = 1
+        conversations.forEach { conversation in
+            // Mark the first .newConversation system message as read if it's not already read.
+            guard let serverTimestamp = systemMessages[conversation.objectID]?.serverTimestamp else { return }
 
-            let messages = context.fetchOrAssert(request: fetchRequest)
+            guard let lastReadServerTimeStamp = conversation.lastReadServerTimeStamp else {
+                // if lastReadServerTimeStamp is nil the conversation was never read
+                return conversation.lastReadServerTimeStamp = serverTimestamp
+            }
 
-            // Mark the first .newConversation system message as read if it's not already read.
-            if let firstSystemMessage = messages.first as? ZMSystemMessage, firstSystemMessage.systemMessageType == .newConversation,
-               let serverTimestamp = firstSystemMessage.serverTimestamp {
-
-                guard let lastReadServerTimeStamp = conversation.lastReadServerTimeStamp else {
-                    // if lastReadServerTimeStamp is nil the conversation was never read
-                    return conversation.lastReadServerTimeStamp = serverTimestamp
-                }
-
-                if serverTimestamp > lastReadServerTimeStamp {
-                    // conversation was read but not up until our system message
-                    conversation.lastReadServerTimeStamp = serverTimestamp
-                }
+            if serverTimestamp > lastReadServerTimeStamp {
+                // conversation was read but not up until our system message
+                conversation.lastReadServerTimeStamp = serverTimestamp
             }
         }
+
+        return conversations.count
     }
 
     public static func updateSystemMessages(_ context: NSManagedObjectContext) {
@@ -288,3 +288,61 @@ import Foundation
         context.saveOrRollback()
     }
 }
+
+// MARK: - Chunked patches
+
+extension ZMHotFixDirectory {
+
+    private static func groupConversationsFetchRequest() -> NSFetchRequest<NSFetchRequestResult> {
+        let fetchRequest = NSFetchRequest<NSFetchRequestResult>(entityName: ZMConversation.entityName())
+        fetchRequest.predicate = NSPredicate(format: "%K == %d", ZMConversationConversationTypeKey, ZMConversationType.group.rawValue)
+        return fetchRequest
+    }
+
+    /// Fetches the first .newConversation system message of each of the conversations with a single request
+    private static func newConversationSystemMessages(in conversations: [ZMConversation], context: NSManagedObjectContext) -> [NSManagedObjectID: ZMSystemMessage] {
+        guard !conversations.isEmpty else { return [:] }
+
+        let fetchRequest = NSFetchRequest<ZMSystemMessage>(entityName: ZMSystemMessage.entityName())
+        fetchRequest.predicate = NSPredicate(format: "%K IN %@ AND %K == %d",
+                                             ZMMessageConversationKey, conversations,
+                                             #keyPath(ZMSystemMessage.systemMessageType), ZMSystemMessageType.newConversation.rawValue)
+        fetchRequest.sortDescriptors = ZMMessage.defaultSortDescriptors()
+
+        var messagesByConversation = [NSManagedObjectID: ZMSystemMessage]()
+        for message in context.fetchOrAssert(request: fetchRequest) {
+            guard let conversationID = message.conversation?.objectID, messagesByConversation[conversationID] == nil else { continue }
+            messagesByConversation[conversationID] = message
+        }
+
+        return messagesByConversation
+    }
+
+    /// Fetches only the objects at `offset..<offset + limit` of the results sorted by `sortKey`. The sort key is
+    /// an identifier which the patches don't change, so that the objects don't move between the chunks when a
+    /// patch changes them, and a patch which is resumed after a relaunch finds its next objects at the same offset,
+    /// as long as it doesn't change which objects match the fetch request.
+    private static func fetchChunk<T: NSManagedObject>(of fetchRequest: NSFetchRequest<NSFetchRequestResult>,
+                                                       sortedBy sortKey: String,
+                                                       offset: Int,
+                                                       limit: Int,
+                                                       in context: NSManagedObjectContext) -> [T] {
+        fetchRequest.sortDescriptors = [NSSortDescriptor(key: sortKey, ascending: true)]
+        fetchRequest.fetchOffset = offset
+        fetchRequest.fetchLimit = limit
+
+        return context.fetchOrAssert(request: fetchRequest).compactMap { $0 as? T }
+    }
+
+    /// Applies the chunked patch at once with the runner of `ZMHotFix`, which saves after each chunk.
+    /// The name identifies the patch in the saved progress.
+    private static func applyAllChunks(in context: NSManagedObjectContext,
+                                       of patch: @escaping (NSManagedObjectContext, Int, Int) -> Int,
+                                       name: String) {
+        let chunkedPatch = ZMHotFixPatch(version: name) { moc, offset, limit in
+            patch(moc!, offset, limit)
+        }
+        ZMHotFix(syncMOC: context).applyAllChunks(of: chunkedPatch)
+    }
+
+}
@@ -21,15 +21,25 @@
 
 typedef void(^ZMHotFixPatchCode)(NSManagedObjectContext *moc);
 
+/// The code to apply the patch to at most `limit` objects, starting at `offset`. Returns the number of objects
+/// which were processed, the patch is complete once it processes less than `limit` objects.
+typedef NSInteger(^ZMHotFixChunkedPatchCode)(NSManagedObjectContext *moc, NSInteger offset, NSInteger limit);
+
+/// Number of objects a chunked patch processes before the progress is saved
+extern NSInteger const ZMHotFixPatchChunkSize;
+
 /// A patch to run on the data
 @interface ZMHotFixPatch : NSObject
 
 + (instancetype)patchWithVersion:(NSString *)version patchCode:(ZMHotFixPatchCode)code;
++ (instancetype)patchWithVersion:(NSString *)version chunkedPatchCode:(ZMHotFixChunkedPatchCode)code;
 
 /// Which version introduced this patch
 @property (nonatomic, readonly, copy) NSString *version;
-/// The code to apply the patch
+/// The code to apply the patch at once, nil if the patch is applied chunk by chunk
 @property (nonatomic, readonly, copy) ZMHotFixPatchCode code;
+/// The code to apply the patch chunk by chunk, nil if the patch is applied at once
+@property (nonatomic, readonly, copy) ZMHotFixChunkedPatchCode chunkedCode;
 
 @end
 
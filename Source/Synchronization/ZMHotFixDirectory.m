@@ -24,6 +24,8 @@
 
 static NSString* ZMLogTag ZM_UNUSED = @"HotFix";
 
+NSInteger const ZMHotFixPatchChunkSize = 100;
+
 @implementation ZMHotFixPatch
 
 + (instancetype)patchWithVersion:(NSString *)version patchCode:(ZMHotFixPatchCode)code
@@ -37,6 +39,17 @@ static NSString* ZMLogTag ZM_UNUSED = @"HotFix";
     return patch;
 }
 
++ (instancetype)patchWithVersion:(NSString *)version chunkedPatchCode:(ZMHotFixChunkedPatchCode)code
+{
+    ZMHotFixPatch *patch = [[ZMHotFixPatch alloc] init];
+    patch->_chunkedCode = ^NSInteger(NSManagedObjectContext *context, NSInteger offset, NSInteger limit) {
+        ZMLogDebug(@"Executing HotFix for version %@ from offset %ld", version, (long)offset);
+        return code(context, offset, limit);
+    };
+    patch->_version = [version copy];
+    return patch;
+}
+
 @end
 
 
@@ -66,13 +79,13 @@ static NSString* ZMLogTag ZM_UNUSED = @"HotFix";
                      }],
                     [ZMHotFixPatch
                      patchWithVersion:@"42.11"
-                     patchCode:^(NSManagedObjectContext *context){
-                         [ZMHotFixDirectory updateUploadedStateForNotUploadedFileMessages:context];
+                     chunkedPatchCode:^NSInteger(NSManagedObjectContext *context, NSInteger offset, NSInteger limit) {
+                         return [ZMHotFixDirectory updateUploadedStateForNotUploadedFileMessages:context offset:offset limit:limit];
                      }],
                     [ZMHotFixPatch
                      patchWithVersion:@"45.0.1"
-                     patchCode:^(NSManagedObjectContext *context) {
-                         [ZMHotFixDirectory insertNewConversationSystemMessage:context];
+                     chunkedPatchCode:^NSInteger(NSManagedObjectContext *context, NSInteger offset, NSInteger limit) {
+                         return [ZMHotFixDirectory insertNewConversationSystemMessage:context offset:offset limit:limit];
                      }],
                     [ZMHotFixPatch
                      patchWithVersion:@"45.1"
@@ -157,8 +170,8 @@ static NSString* ZMLogTag ZM_UNUSED = @"HotFix";
                     /// We need to mark all .newConversation system messages as read after we start to treat them as a readable message
                     [ZMHotFixPatch
                      patchWithVersion:@"230.0.0"
-                     patchCode:^(NSManagedObjectContext *context) {
-                         [ZMHotFixDirectory markAllNewConversationSystemMessagesAsRead:context];
+                     chunkedPatchCode:^NSInteger(NSManagedObjectContext *context, NSInteger offset, NSInteger limit) {
+                         return [ZMHotFixDirectory markAllNewConversationSystemMessagesAsRead:context offset:offset limit:limit];
                      }],
 
                     /// We need to refetch the managedBy flag of the user after the backend release.
@@ -0,0 +1,52 @@
+//
+// Wire
+// Copyright (C) 2022 Wire Swiss GmbH
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see http://www.gnu.org/licenses/.
+//
+
+import Foundation
+
+/// Counts the events fetched from the notification stream during a quick sync,
+/// including the ones which were fetched more than once because the fetch was restarted.
+@objcMembers public final class QuickSyncStatistics: NSObject {
+
+    /// Number of times the notification stream was fetched, restarts included
+    public private(set) var numberOfFetches = 0
+
+    /// Number of events received, duplicates included
+    public private(set) var numberOfFetchedEvents = 0
+
+    /// Number of events which were already received earlier in the quick sync
+    public private(set) var numberOfDuplicateEvents = 0
+
+    private var fetchedEventIDs = Set<UUID>()
+
+    func recordFetch() {
+        numberOfFetches += 1
+    }
+
+    func recordFetchedEvents(withIDs eventIDs: [UUID]) {
+        numberOfFetchedEvents += eventIDs.count
+
+        for eventID in eventIDs where !fetchedEventIDs.insert(eventID).inserted {
+            numberOfDuplicateEvents += 1
+        }
+    }
+
+    public override var description: String {
+        return "\(numberOfFetches) fetch(es), \(numberOfFetchedEvents) event(s), \(numberOfDuplicateEvents) duplicate(s)"
+    }
+
+}
@@ -29,8 +29,8 @@ class AddressBookSearch {
     /// Address book
     fileprivate let addressBook: AddressBookAccessor?
 
-    init(addressBook: AddressBookAccessor? = nil) {
-        self.addressBook = addressBook ?? AddressBook.factory()
+    init(addressBook: AddressBookAccessor? = nil, normalizationCache: PhoneNumberNormalizationCache? = nil) {
+        self.addressBook = addressBook ?? AddressBook.factory(normalizationCache: normalizationCache)
     }
 }
 
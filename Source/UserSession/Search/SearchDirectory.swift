@@ -23,6 +23,7 @@ import Foundation
     let searchContext: NSManagedObjectContext
     let contextProvider: ContextProvider
     let transportSession: TransportSessionType
+    let phoneNumberNormalizationCache: PhoneNumberNormalizationCache?
     var isTornDown = false
 
     deinit {
@@ -30,13 +31,20 @@ import Foundation
     }
 
     public convenience init(userSession: ZMUserSession) {
-        self.init(searchContext: userSession.searchManagedObjectContext, contextProvider: userSession, transportSession: userSession.transportSession)
+        self.init(searchContext: userSession.searchManagedObjectContext,
+                  contextProvider: userSession,
+                  transportSession: userSession.transportSession,
+                  phoneNumberNormalizationCache: userSession.phoneNumberNormalizationCache)
     }
 
-    init(searchContext: NSManagedObjectContext, contextProvider: ContextProvider, transportSession: TransportSessionType) {
+    init(searchContext: NSManagedObjectContext,
+         contextProvider: ContextProvider,
+         transportSession: TransportSessionType,
+         phoneNumberNormalizationCache: PhoneNumberNormalizationCache? = nil) {
         self.searchContext = searchContext
         self.contextProvider = contextProvider
         self.transportSession = transportSession
+        self.phoneNumberNormalizationCache = phoneNumberNormalizationCache
     }
 
     /// Perform a search request.
@@ -44,6 +52,7 @@ import Foundation
     /// Returns a SearchTask which should be retained until the results arrive.
     public func perform(_ request: SearchRequest) -> SearchTask {
         let task = SearchTask(task: .search(searchRequest: request), searchContext: searchContext, contextProvider: contextProvider, transportSession: transportSession)
+        task.phoneNumberNormalizationCache = phoneNumberNormalizationCache
 
         task.onResult { [weak self] (result, _) in
             self?.observeSearchUsers(result)
@@ -25,8 +25,17 @@ var debug_searchResultAddressBookOverride: AddressBookAccessor?
 extension SearchResult {
 
     /// Creates a new search result with the same results and additional
-    /// results obtained by searching through the address book with the same query
+    /// results obtained by searching through the address book with the same query.
+    /// When the context provider is a user session, its phone number normalization cache is used.
     public func extendWithContactsFromAddressBook(_ query: String, contextProvider: ContextProvider) -> SearchResult {
+        let normalizationCache = (contextProvider as? ZMUserSession)?.phoneNumberNormalizationCache
+        return extendWithContactsFromAddressBook(query, contextProvider: contextProvider, normalizationCache: normalizationCache)
+    }
+
+    /// - parameter normalizationCache: cache for normalized phone numbers of the account
+    func extendWithContactsFromAddressBook(_ query: String,
+                                           contextProvider: ContextProvider,
+                                           normalizationCache: PhoneNumberNormalizationCache?) -> SearchResult {
         /*
          When I have a search result obtained (either with a local search or from the BE) by matching on Wire
          users display names or handle, I also want to check if I have any address book contact in my local
@@ -34,7 +43,7 @@ extension SearchResult {
          with the users that I already found from the Wire search. The following code makes sure that such overlaps
          are not displayed twice (once for the Wire user, once for the address book contact).
          */
-        let addressBook = AddressBookSearch(addressBook: debug_searchResultAddressBookOverride)
+        let addressBook = AddressBookSearch(addressBook: debug_searchResultAddressBookOverride, normalizationCache: normalizationCache)
 
         // I don't need to find the address book contacts of users that I already found
         let identifiersOfAlreadyFoundUsers = contacts.compactMap { $0.user?.addressBookEntry?.localIdentifier } + self.directory.compactMap { $0.user?.addressBookEntry?.localIdentifier }
@@ -29,6 +29,13 @@ public struct SearchResult {
 
 extension SearchResult {
 
+    static let empty = SearchResult(contacts: [],
+                                    teamMembers: [],
+                                    addressBook: [],
+                                    directory: [],
+                                    conversations: [],
+                                    services: [])
+
     public init?(payload: [AnyHashable: Any], query: SearchRequest.Query, searchOptions: SearchOptions, contextProvider: ContextProvider) {
         guard let documents = payload["documents"] as? [[String: Any]] else {
             return nil
@@ -126,7 +133,7 @@ extension SearchResult {
 
     func union(withLocalResult result: SearchResult) -> SearchResult {
         return SearchResult(contacts: result.contacts,
-                            teamMembers: result.teamMembers,
+                            teamMembers: result.teamMembers.mergingUnique(teamMembers),
                             addressBook: result.addressBook,
                             directory: directory,
                             conversations: result.conversations,
@@ -144,11 +151,36 @@ extension SearchResult {
 
     func union(withDirectoryResult result: SearchResult) -> SearchResult {
         return SearchResult(contacts: contacts,
-                            teamMembers: Array(Set(teamMembers).union(result.teamMembers)),
+                            teamMembers: teamMembers.mergingUnique(result.teamMembers),
                             addressBook: addressBook,
                             directory: result.directory,
                             conversations: conversations,
                             services: services)
     }
 
+    /// Returns the result with every user listed only once per section. Directory users who are
+    /// already contacts or team members are dropped; the other sections may still overlap.
+    func deduplicated() -> SearchResult {
+        let uniqueContacts = contacts.mergingUnique([])
+        let uniqueTeamMembers = teamMembers.mergingUnique([])
+
+        return SearchResult(contacts: uniqueContacts,
+                            teamMembers: uniqueTeamMembers,
+                            addressBook: addressBook.mergingUnique([]),
+                            directory: directory.mergingUnique([]).excluding(uniqueContacts, uniqueTeamMembers),
+                            conversations: conversations,
+                            services: services)
+    }
+
+    /// Returns the result with team members and directory users sorted by relevance
+    /// to the query. Users of equal relevance keep the order in which they were found.
+    func ranked(by ranker: SearchResultRanker) -> SearchResult {
+        return SearchResult(contacts: contacts,
+                            teamMembers: ranker.rank(teamMembers),
+                            addressBook: addressBook,
+                            directory: ranker.rank(directory),
+                            conversations: conversations,
+                            services: services)
+    }
+
 }
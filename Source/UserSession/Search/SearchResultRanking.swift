@@ -0,0 +1,219 @@
+//
+// Wire
+// Copyright (C) 2022 Wire Swiss GmbH
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see http://www.gnu.org/licenses/.
+//
+
+import Foundation
+
+/// Scores search users against a query so that results coming from
+/// different sources (local, directory, address book) can be merged
+/// into a single relevance order.
+struct SearchResultRanker {
+
+    enum MatchQuality: Int, Comparable {
+        case none = 0
+        case fuzzy
+        case nameToken
+        case namePrefix
+        case handlePrefix
+        case exactHandle
+
+        static func < (lhs: MatchQuality, rhs: MatchQuality) -> Bool {
+            return lhs.rawValue < rhs.rawValue
+        }
+    }
+
+    /// Interactions older than this don't contribute to the score.
+    static let recencyWindow: TimeInterval = 30 * 24 * 60 * 60
+
+    private static let matchWeight = 100
+    private static let teamMemberBonus = 20
+    private static let maxRecencyBonus = 50
+
+    let query: String
+    let now: Date
+
+    init(query: String, now: Date = Date()) {
+        self.query = query.strippingLeadingAtSign().lowercased()
+        self.now = now
+    }
+
+    func score(_ user: ZMSearchUser) -> Int {
+        var score = matchQuality(for: user).rawValue * Self.matchWeight
+
+        if user.isTeamMember {
+            score += Self.teamMemberBonus
+        }
+
+        if let lastInteraction = user.user?.oneToOneConversation?.lastModifiedDate {
+            let age = max(0, now.timeIntervalSince(lastInteraction))
+
+            if age < Self.recencyWindow {
+                score += Int(Double(Self.maxRecencyBonus) * (1 - age / Self.recencyWindow))
+            }
+        }
+
+        return score
+    }
+
+    func matchQuality(for user: ZMSearchUser) -> MatchQuality {
+        guard !query.isEmpty else { return .none }
+
+        if let handle = user.handle?.lowercased() {
+            if handle == query {
+                return .exactHandle
+            } else if handle.hasPrefix(query) {
+                return .handlePrefix
+            }
+        }
+
+        guard let name = user.name.flatMap({ $0.normalizedForSearch() as String? })?.lowercased() else {
+            return .none
+        }
+
+        if name.hasPrefix(query) {
+            return .namePrefix
+        } else if name.split(separator: " ").contains(where: { $0.hasPrefix(query) }) {
+            return .nameToken
+        } else if name.containsSubsequence(query) {
+            return .fuzzy
+        }
+
+        return .none
+    }
+
+    /// Sorts users by descending score. Users with equal scores keep their
+    /// relative order, so the backend or fetch request order acts as tie breaker.
+    func rank(_ users: [ZMSearchUser]) -> [ZMSearchUser] {
+        guard !query.isEmpty, users.count > 1 else { return users }
+
+        return users.enumerated()
+            .map { (offset: $0.offset, score: score($0.element), user: $0.element) }
+            .sorted { $0.score == $1.score ? $0.offset < $1.offset : $0.score > $1.score }
+            .map(\.user)
+    }
+
+}
+
+// MARK: - Deduplication
+
+/// Identifies a search user across result sources.
+enum SearchUserKey: Hashable {
+    case remote(UUID)
+    case local(ObjectIdentifier)
+
+    init(_ user: ZMSearchUser) {
+        if let remoteIdentifier = user.remoteIdentifier {
+            self = .remote(remoteIdentifier)
+        } else {
+            self = .local(ObjectIdentifier(user))
+        }
+    }
+}
+
+extension Array where Element == ZMSearchUser {
+
+    /// Appends the users of `other` which are not already present, keeping the
+    /// order of both arrays.
+    func mergingUnique(_ other: [ZMSearchUser]) -> [ZMSearchUser] {
+        var seen = Set<SearchUserKey>()
+        seen.reserveCapacity(count + other.count)
+
+        return (self + other).filter { seen.insert(SearchUserKey($0)).inserted }
+    }
+
+    /// Removes the users which are present in any of the `others` arrays.
+    func excluding(_ others: [ZMSearchUser]...) -> [ZMSearchUser] {
+        let excluded = Set(others.joined().map(SearchUserKey.init))
+
+        guard !excluded.isEmpty else { return self }
+
+        return filter { !excluded.contains(SearchUserKey($0)) }
+    }
+
+}
+
+// MARK: - Incremental changes
+
+/// Describes how a search result changed since it was last delivered to a result handler.
+public struct SearchResultChangeSet {
+
+    public struct SectionChange: Equatable {
+        /// Indexes of removed items, relative to the previous result
+        public let deletedIndexes: IndexSet
+        /// Indexes of added items, relative to the new result
+        public let insertedIndexes: IndexSet
+
+        public var isEmpty: Bool {
+            return deletedIndexes.isEmpty && insertedIndexes.isEmpty
+        }
+
+        init<Key: Hashable>(old: [Key], new: [Key]) {
+            let oldKeys = Set(old)
+            let newKeys = Set(new)
+
+            deletedIndexes = IndexSet(old.indices.filter { !newKeys.contains(old[$0]) })
+            insertedIndexes = IndexSet(new.indices.filter { !oldKeys.contains(new[$0]) })
+        }
+    }
+
+    public let contacts: SectionChange
+    public let teamMembers: SectionChange
+    public let addressBook: SectionChange
+    public let directory: SectionChange
+    public let conversations: SectionChange
+    public let services: SectionChange
+
+    public var isEmpty: Bool {
+        return [contacts, teamMembers, addressBook, directory, conversations, services].allSatisfy(\.isEmpty)
+    }
+
+    init(from old: SearchResult, to new: SearchResult) {
+        func keys(_ users: [ZMSearchUser]) -> [SearchUserKey] {
+            return users.map(SearchUserKey.init)
+        }
+
+        contacts = SectionChange(old: keys(old.contacts), new: keys(new.contacts))
+        teamMembers = SectionChange(old: keys(old.teamMembers), new: keys(new.teamMembers))
+        addressBook = SectionChange(old: keys(old.addressBook), new: keys(new.addressBook))
+        directory = SectionChange(old: keys(old.directory), new: keys(new.directory))
+        conversations = SectionChange(old: old.conversations.map(\.objectID), new: new.conversations.map(\.objectID))
+        services = SectionChange(old: old.services.map { ObjectIdentifier($0 as AnyObject) }, new: new.services.map { ObjectIdentifier($0 as AnyObject) })
+    }
+
+}
+
+// MARK: - Helpers
+
+private extension String {
+
+    /// Returns true if all characters of `other` appear in order in the receiver.
+    func containsSubsequence(_ other: String) -> Bool {
+        var remaining = other.makeIterator()
+        var next = remaining.next()
+
+        for character in self where character == next {
+            next = remaining.next()
+
+            if next == nil {
+                return true
+            }
+        }
+
+        return next == nil
+    }
+
+}
@@ -27,38 +27,49 @@ public class SearchTask {
     }
 
     public typealias ResultHandler = (_ result: SearchResult, _ isCompleted: Bool) -> Void
+    public typealias ResultChangeHandler = (_ result: SearchResult, _ changes: SearchResultChangeSet, _ isCompleted: Bool) -> Void
 
     fileprivate let transportSession: TransportSessionType
     fileprivate let searchContext: NSManagedObjectContext
     fileprivate let contextProvider: ContextProvider
+    /// Cache for normalized phone numbers used when searching the address book
+    var phoneNumberNormalizationCache: PhoneNumberNormalizationCache?
     fileprivate let task: Task
     fileprivate var userLookupTaskIdentifier: ZMTaskIdentifier?
     fileprivate var directoryTaskIdentifier: ZMTaskIdentifier?
     fileprivate var teamMembershipTaskIdentifier: ZMTaskIdentifier?
     fileprivate var handleTaskIdentifier: ZMTaskIdentifier?
     fileprivate var servicesTaskIdentifier: ZMTaskIdentifier?
-    fileprivate var resultHandlers: [ResultHandler] = []
-    fileprivate var result: SearchResult = SearchResult(contacts: [],
-                                                        teamMembers: [],
-                                                        addressBook: [],
-                                                        directory: [],
-                                                        conversations: [],
-                                                        services: [])
+    fileprivate var resultHandlers: [(ranked: Bool, handler: ResultHandler)] = []
+    fileprivate var resultChangeHandlers: [(ranked: Bool, handler: ResultChangeHandler)] = []
+    fileprivate var result: SearchResult = .empty
+    fileprivate var deliveredResults: [Bool: SearchResult] = [:]
 
     fileprivate var tasksRemaining = 0 {
         didSet {
             // only trigger handles if decrement to 0
             if oldValue > tasksRemaining {
                 let isCompleted = tasksRemaining == 0
-                resultHandlers.forEach { $0(result, isCompleted) }
+                let uniqueResult = result.deduplicated()
+                let rankedResult = ranker.map(uniqueResult.ranked(by:)) ?? uniqueResult
+
+                resultHandlers.forEach { $0.handler($0.ranked ? rankedResult : uniqueResult, isCompleted) }
+                notifyResultChangeHandlers(ranked: false, with: uniqueResult, isCompleted: isCompleted)
+                notifyResultChangeHandlers(ranked: true, with: rankedResult, isCompleted: isCompleted)
 
                 if isCompleted {
                     resultHandlers.removeAll()
+                    resultChangeHandlers.removeAll()
                 }
             }
         }
     }
 
+    fileprivate var ranker: SearchResultRanker? {
+        guard case .search(let request) = task else { return nil }
+        return SearchResultRanker(query: request.normalizedQuery)
+    }
+
     convenience init(request: SearchRequest,
                      searchContext: NSManagedObjectContext,
                      contextProvider: ContextProvider,
@@ -80,14 +91,23 @@ public class SearchTask {
         self.contextProvider = contextProvider
     }
 
-    /// Add a result handler
-    public func onResult(_ resultHandler: @escaping ResultHandler) {
-        resultHandlers.append(resultHandler)
+    /// Add a result handler. When `ranked` is true, team members and directory users
+    /// are sorted by relevance to the query instead of the order in which they were found.
+    public func onResult(ranked: Bool = false, _ resultHandler: @escaping ResultHandler) {
+        resultHandlers.append((ranked, resultHandler))
+    }
+
+    /// Add a handler which is called with the changes since the last delivered result.
+    /// Intermediate results which don't change anything are not delivered, the completed
+    /// result is always delivered.
+    public func onResultChange(ranked: Bool = false, _ resultChangeHandler: @escaping ResultChangeHandler) {
+        resultChangeHandlers.append((ranked, resultChangeHandler))
     }
 
     /// Cancel a previously started task
     public func cancel() {
         resultHandlers.removeAll()
+        resultChangeHandlers.removeAll()
 
         teamMembershipTaskIdentifier.flatMap(transportSession.cancelTask)
         userLookupTaskIdentifier.flatMap(transportSession.cancelTask)
@@ -112,6 +132,23 @@ public class SearchTask {
     }
 }
 
+extension SearchTask {
+
+    fileprivate func notifyResultChangeHandlers(ranked: Bool, with newResult: SearchResult, isCompleted: Bool) {
+        let handlers = resultChangeHandlers.filter { $0.ranked == ranked }
+
+        guard !handlers.isEmpty else { return }
+
+        let changes = SearchResultChangeSet(from: deliveredResults[ranked] ?? .empty, to: newResult)
+
+        guard !changes.isEmpty || isCompleted else { return }
+
+        deliveredResults[ranked] = newResult
+        handlers.forEach { $0.handler(newResult, changes, isCompleted) }
+    }
+
+}
+
 extension SearchTask {
 
     /// look up a user ID from contacts and teamMmebers locally. 
@@ -184,7 +221,9 @@ extension SearchTask {
                 self.result = self.result.union(withLocalResult: result.copy(on: self.contextProvider.viewContext))
 
                 if request.searchOptions.contains(.addressBook) {
-                    self.result = self.result.extendWithContactsFromAddressBook(request.normalizedQuery, contextProvider: self.contextProvider)
+                    self.result = self.result.extendWithContactsFromAddressBook(request.normalizedQuery,
+                                                                                contextProvider: self.contextProvider,
+                                                                                normalizationCache: self.phoneNumberNormalizationCache)
                 }
 
                 self.tasksRemaining -= 1
@@ -0,0 +1,104 @@
+//
+// Wire
+// Copyright (C) 2022 Wire Swiss GmbH
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see http://www.gnu.org/licenses/.
+//
+
+import Foundation
+
+/// Records when each phase of a slow sync started and ended, to analyse
+/// which phases run concurrently and which ones hold up the sync, and how
+/// much data each phase downloaded and wrote to the database.
+public struct SyncPhaseTimeline: CustomStringConvertible {
+
+    public struct Entry {
+        public let phase: SyncPhase
+        public let startDate: Date
+        public fileprivate(set) var endDate: Date?
+
+        /// Size of the payloads received during the phase
+        public fileprivate(set) var bytesReceived = 0
+
+        /// Number of objects inserted, updated or deleted from the payloads
+        public fileprivate(set) var objectsWritten = 0
+
+        /// Number of payloads which were skipped because they didn't change since the last slow sync
+        public fileprivate(set) var unchangedPayloads = 0
+
+        public var duration: TimeInterval? {
+            return endDate?.timeIntervalSince(startDate)
+        }
+    }
+
+    /// The phases in the order they started
+    public private(set) var entries = [Entry]()
+
+    mutating func start(_ phase: SyncPhase, at date: Date = Date()) {
+        guard !entries.contains(where: { $0.phase == phase }) else { return }
+        entries.append(Entry(phase: phase, startDate: date))
+    }
+
+    mutating func end(_ phase: SyncPhase, at date: Date = Date()) {
+        guard let index = entries.firstIndex(where: { $0.phase == phase && $0.endDate == nil }) else { return }
+        entries[index].endDate = date
+    }
+
+    /// Records a payload received by a phase which already started
+    mutating func recordPayload(of phase: SyncPhase, byteCount: Int, objectsWritten: Int, isUnchanged: Bool = false) {
+        guard let index = entries.firstIndex(where: { $0.phase == phase }) else { return }
+        entries[index].bytesReceived += byteCount
+        entries[index].objectsWritten += objectsWritten
+        entries[index].unchangedPayloads += isUnchanged ? 1 : 0
+    }
+
+    public func entry(for phase: SyncPhase) -> Entry? {
+        return entries.first { $0.phase == phase }
+    }
+
+    /// Time from the start of the first phase to the end of the last one
+    public var duration: TimeInterval? {
+        guard
+            let start = entries.first?.startDate,
+            let end = entries.compactMap(\.endDate).max()
+        else {
+            return nil
+        }
+
+        return end.timeIntervalSince(start)
+    }
+
+    public var bytesReceived: Int {
+        return entries.reduce(0) { $0 + $1.bytesReceived }
+    }
+
+    public var objectsWritten: Int {
+        return entries.reduce(0) { $0 + $1.objectsWritten }
+    }
+
+    public var description: String {
+        guard let start = entries.first?.startDate else { return "[]" }
+
+        let phases = entries.map { entry -> String in
+            let offset = Int(entry.startDate.timeIntervalSince(start) * 1000)
+            let duration = entry.duration.map { "\(Int($0 * 1000))ms" } ?? "unfinished"
+            let payload = entry.bytesReceived == 0 ? "" : " \(entry.bytesReceived)B \(entry.objectsWritten) objects"
+            let unchanged = entry.unchangedPayloads == 0 ? "" : " (unchanged)"
+            return "\(entry.phase) +\(offset)ms \(duration)\(payload)\(unchanged)"
+        }
+
+        return "[\(phases.joined(separator: ", "))]"
+    }
+
+}
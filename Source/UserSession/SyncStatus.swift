@@ -34,10 +34,23 @@ extension Notification.Name {
             if currentSyncPhase != oldValue {
                 zmLog.debug("did change sync phase: \(currentSyncPhase)")
                 notifySyncPhaseDidStart()
+                startActiveSyncPhases()
             }
         }
     }
 
+    /// Slow sync phases which finished ahead of the current phase
+    fileprivate var finishedSyncPhases = Set<SyncPhase>()
+
+    /// Start and end of the phases of the ongoing or last slow sync
+    public fileprivate(set) var slowSyncTimeline = SyncPhaseTimeline()
+
+    /// Events fetched from the notification stream during the ongoing quick sync
+    public fileprivate(set) var quickSyncStatistics = QuickSyncStatistics()
+
+    /// Events fetched from the notification stream during the last completed quick sync
+    public fileprivate(set) var lastQuickSyncStatistics: QuickSyncStatistics?
+
     fileprivate var lastUpdateEventID: UUID?
     fileprivate unowned var managedObjectContext: NSManagedObjectContext
     fileprivate unowned var syncStateDelegate: ZMSyncStateDelegate
@@ -109,7 +122,9 @@ extension Notification.Name {
         // Refetch user settings.
         ZMUser.selfUser(in: managedObjectContext).needsPropertiesUpdate = true
         // Set the status.
+        resetSlowSyncProgress()
         currentSyncPhase = SyncPhase.fetchingLastUpdateEventID.nextPhase
+        startActiveSyncPhases()
         syncStateDelegate.didStartSlowSync()
     }
 
@@ -124,17 +139,51 @@ extension Notification.Name {
 // MARK: Slow Sync
 extension SyncStatus {
 
+    /// Whether the requests of the phase can be sent. During slow sync, some phases can
+    /// run ahead of the current phase once the phases they depend on have finished.
+    public func isActive(phase: SyncPhase) -> Bool {
+        if phase == currentSyncPhase {
+            return true
+        }
+
+        guard
+            isSlowSyncing,
+            !finishedSyncPhases.contains(phase),
+            let prerequisites = phase.prerequisites
+        else {
+            return false
+        }
+
+        return prerequisites.allSatisfy(isFinished)
+    }
+
     public func finishCurrentSyncPhase(phase: SyncPhase) {
-        precondition(phase == currentSyncPhase, "Finished syncPhase does not match currentPhase")
+        precondition(isActive(phase: phase), "Finished syncPhase is not active")
 
         zmLog.debug("finished sync phase: \(phase)")
-
-        if phase.isLastSlowSyncPhase {
-            persistLastUpdateEventID()
-            syncStateDelegate.didFinishSlowSync()
+        slowSyncTimeline.end(phase)
+
+        guard phase == currentSyncPhase else {
+            // The phase ran ahead of the current phase, it will be skipped once the current phase reaches it
+            finishedSyncPhases.insert(phase)
+            startActiveSyncPhases()
+            RequestAvailableNotification.notifyNewRequestsAvailable(self)
+            return
         }
 
-        currentSyncPhase = phase.nextPhase
+        var nextPhase = phase
+
+        repeat {
+            if nextPhase.isLastSlowSyncPhase {
+                persistLastUpdateEventID()
+                zmLog.info("slow sync timeline: \(slowSyncTimeline)")
+                syncStateDelegate.didFinishSlowSync()
+            }
+
+            nextPhase = nextPhase.nextPhase
+        } while finishedSyncPhases.remove(nextPhase) != nil
+
+        currentSyncPhase = nextPhase
 
         if currentSyncPhase == .done {
             if needsToRestartQuickSync && pushChannelIsOpen {
@@ -147,6 +196,9 @@ extension SyncStatus {
             }
 
             zmLog.debug("sync complete")
+            zmLog.info("quick sync fetched \(quickSyncStatistics)")
+            lastQuickSyncStatistics = quickSyncStatistics
+            quickSyncStatistics = QuickSyncStatistics()
             syncStateDelegate.didFinishQuickSync()
             isForceQuickSync = false
         }
@@ -154,17 +206,52 @@ extension SyncStatus {
     }
 
     public func failCurrentSyncPhase(phase: SyncPhase) {
-        precondition(phase == currentSyncPhase, "Failed syncPhase does not match currentPhase")
+        precondition(isActive(phase: phase), "Failed syncPhase is not active")
 
         zmLog.debug("failed sync phase: \(phase)")
 
         if currentSyncPhase == .fetchingMissedEvents {
             managedObjectContext.zm_lastNotificationID = nil
+            quickSyncStatistics = QuickSyncStatistics()
+            resetSlowSyncProgress()
             currentSyncPhase = .fetchingLastUpdateEventID
             needsToRestartQuickSync = false
         }
     }
 
+    /// Records the size of a payload received by an active slow sync phase and how many objects it wrote
+    public func recordSlowSyncPayload(phase: SyncPhase, byteCount: Int, objectsWritten: Int, isUnchanged: Bool = false) {
+        guard isSlowSyncing else { return }
+
+        slowSyncTimeline.recordPayload(of: phase, byteCount: byteCount, objectsWritten: objectsWritten, isUnchanged: isUnchanged)
+    }
+
+    /// Must be called before the current phase is set back to the start of a slow sync
+    fileprivate func resetSlowSyncProgress() {
+        finishedSyncPhases.removeAll()
+        slowSyncTimeline = SyncPhaseTimeline()
+    }
+
+    fileprivate func isFinished(_ phase: SyncPhase) -> Bool {
+        guard
+            let index = SyncPhase.slowSyncPhases.firstIndex(of: phase),
+            let currentIndex = SyncPhase.slowSyncPhases.firstIndex(of: currentSyncPhase)
+        else {
+            return false
+        }
+
+        return index < currentIndex || finishedSyncPhases.contains(phase)
+    }
+
+    /// Records the start of the phases which became active
+    fileprivate func startActiveSyncPhases() {
+        guard isSlowSyncing else { return }
+
+        for phase in SyncPhase.slowSyncPhases where isActive(phase: phase) {
+            slowSyncTimeline.start(phase)
+        }
+    }
+
     var hasPersistedLastEventID: Bool {
         return managedObjectContext.zm_lastNotificationID != nil
     }
@@ -188,6 +275,16 @@ extension SyncStatus {
         isFetchingNotificationStream = true
     }
 
+    /// Records that the notification stream is fetched again from the last stored event
+    public func didStartFetchingMissedEvents() {
+        quickSyncStatistics.recordFetch()
+    }
+
+    /// Records the events of a page of the notification stream
+    public func didFetchMissedEvents(withIDs eventIDs: [UUID]) {
+        quickSyncStatistics.recordFetchedEvents(withIDs: eventIDs)
+    }
+
     public func failedFetchingNotificationStream() {
         if currentSyncPhase == .fetchingMissedEvents {
             failCurrentSyncPhase(phase: .fetchingMissedEvents)
@@ -205,6 +302,10 @@ extension SyncStatus {
             // established before we initiated the notification stream fetch.
             // If the push channel disconnected in between we'll fetch the stream again
             finishCurrentSyncPhase(phase: .fetchingMissedEvents)
+        } else if currentSyncPhase == .fetchingMissedEvents && pushChannelIsOpen {
+            // The stream is fetched again from the last stored event, which already covers
+            // the events a restart would fetch once this phase finishes
+            needsToRestartQuickSync = false
         }
 
         isFetchingNotificationStream = false
@@ -237,3 +338,35 @@ extension SyncStatus {
     }
 
 }
+
+// MARK: Phase Dependencies
+extension SyncPhase {
+
+    /// The slow sync phases, in the order they are run in
+    static let slowSyncPhases: [SyncPhase] = {
+        var phases = [SyncPhase]()
+        var phase = SyncPhase.fetchingLastUpdateEventID
+
+        while phase.isSyncing && phase != .fetchingMissedEvents {
+            phases.append(phase)
+            phase = phase.nextPhase
+        }
+
+        return phases
+    }()
+
+    /// The phases which need to finish before this phase can run ahead of the current phase.
+    /// Phases without prerequisites only run when they are the current phase.
+    var prerequisites: [SyncPhase]? {
+        switch self {
+        case .fetchingTeamRoles, .fetchingLegalHoldStatus:
+            return [.fetchingTeams]
+        case .fetchingLabels:
+            // Labels reference conversations
+            return [.fetchingConversations]
+        default:
+            return nil
+        }
+    }
+
+}
@@ -32,6 +32,8 @@ static NSTimeInterval UnsuccessfulDownloadRetryInterval = 30 * 60; // 30 minutes
 
 static NSString * const MinVersionKey = @"min_version";
 static NSString * const ExcludeVersionsKey = @"exclude";
+static NSString * const EntityTagKey = @"blacklist_etag";
+static NSString * const LastModifiedKey = @"blacklist_last_modified";
 
 
 @interface ZMBlacklistDownloader ()
@@ -55,6 +57,15 @@ static NSString * const ExcludeVersionsKey = @"exclude";
 /// Current cached excluded version
 @property (nonatomic) NSArray *excludedVersions;
 
+/// `ETag` of the response the cached versions are from
+@property (nonatomic) NSString *entityTag;
+
+/// `Last-Modified` date of the response the cached versions are from
+@property (nonatomic) NSString *lastModified;
+
+/// Whether a blacklist was downloaded before
+@property (nonatomic, readonly) BOOL hasCachedBlacklist;
+
 /// Isolation queue
 @property (nonatomic) dispatch_queue_t queue;
 
@@ -102,6 +113,12 @@ static NSString * const ExcludeVersionsKey = @"exclude";
  Version string is just a build version number.
  All version that are lower than `min_version` or that are listed in `exclude` are not legal.
 
+ Caching:
+ The last downloaded blacklist is stored in the user defaults and reported as soon as the
+ downloader is created, so that the app doesn't need to wait for the download on launch.
+ The cached blacklist is then revalidated with a conditional request, and only reported
+ again if the backend returns a new one.
+
  Use of timers:
  A timer is used to download at periodic intervals. The interval depends on whether the last
  download was a success or a failure. The timer is stopped when moving to the background
@@ -177,6 +194,8 @@ static NSString * const ExcludeVersionsKey = @"exclude";
         if ([minVersion isKindOfClass:[NSString class]]) {
             self.minVersion = minVersion;
         }
+        self.entityTag = [self.userDefaults stringForKey:EntityTagKey];
+        self.lastModified = [self.userDefaults stringForKey:LastModifiedKey];
         self.completionHandler = completionHandler;
         self.dateOfLastSuccessfulDownload = nil;
         self.dateOfLastUnsuccessfulDownload = nil;
@@ -184,7 +203,10 @@ static NSString * const ExcludeVersionsKey = @"exclude";
         
         [application registerObserverForDidBecomeActive:self selector:@selector(didBecomeActive:)];
         [application registerObserverForWillResignActive:self selector:@selector(willResignActive:)];
-        
+
+        if (self.hasCachedBlacklist) {
+            [self notifyMinVersion:self.minVersion exclude:self.excludedVersions];
+        }
         [self startTimerIfNeeded];
     }
     return self;
@@ -368,6 +390,19 @@ static NSString * const ExcludeVersionsKey = @"exclude";
     }
 }
 
+- (void)storeEntityTag:(NSString *)entityTag lastModified:(NSString *)lastModified
+{
+    self.entityTag = entityTag;
+    self.lastModified = lastModified;
+    [self.userDefaults setObject:entityTag forKey:EntityTagKey];
+    [self.userDefaults setObject:lastModified forKey:LastModifiedKey];
+}
+
+- (BOOL)hasCachedBlacklist
+{
+    return self.minVersion != nil && self.excludedVersions != nil;
+}
+
 - (void)didReceiveResponseForBlacklistWithData:(NSData *)data response:(NSURLResponse * __unused)response error:(NSError *)error {
     
     if (self.tornDown) {
@@ -378,6 +413,10 @@ static NSString * const ExcludeVersionsKey = @"exclude";
     if (error != nil) {
         ZMLogError(@"Failed to download black list: %@", error);
     }
+    else if (httpResponse.statusCode == 304 && self.hasCachedBlacklist) {
+        ZMLogInfo(@"Blacklist didn't change");
+        isSuccess = YES;
+    }
     else if (data == nil) {
         ZMLogError(@"Black list data is nil");
     }
@@ -394,6 +433,8 @@ static NSString * const ExcludeVersionsKey = @"exclude";
 
                 [self didDownloadBlacklistWithMinVersion:blacklist.minVersion
                                                  exclude:blacklist.excludedVersions];
+                [self storeEntityTag:[httpResponse valueForHTTPHeaderField:@"ETag"]
+                        lastModified:[httpResponse valueForHTTPHeaderField:@"Last-Modified"]];
                 isSuccess = YES;
             }
         }
@@ -415,17 +456,21 @@ static NSString * const ExcludeVersionsKey = @"exclude";
     if(self.minVersion != minVersion || ![self.minVersion isEqualToString:minVersion]
        || self.excludedVersions != exclude || ![self.excludedVersions isEqualToArray:exclude]) {
         [self storeMinVersion:minVersion excludedVersions:exclude];
-        
-        if (self.completionHandler) {
-            void(^completionHandler)(NSString *, NSArray *) = self.completionHandler;
-            [self.workingGroup enter];
-            ZM_WEAK(self);
-            dispatch_async(dispatch_get_main_queue(), ^ void () {
-                ZM_STRONG(self);
-                completionHandler(minVersion, exclude);
-                [self.workingGroup leave];
-            });
-        }
+        [self notifyMinVersion:minVersion exclude:exclude];
+    }
+}
+
+- (void)notifyMinVersion:(NSString *)minVersion exclude:(NSArray *)exclude
+{
+    if (self.completionHandler) {
+        void(^completionHandler)(NSString *, NSArray *) = self.completionHandler;
+        [self.workingGroup enter];
+        ZM_WEAK(self);
+        dispatch_async(dispatch_get_main_queue(), ^ void () {
+            ZM_STRONG(self);
+            completionHandler(minVersion, exclude);
+            [self.workingGroup leave];
+        });
     }
 }
 
@@ -437,12 +482,15 @@ static NSString * const ExcludeVersionsKey = @"exclude";
     NSURL *backendURL = [self.environment.blackListURL URLByAppendingPathComponent:@"ios"];
     NSURLRequest *urlRequest = [[NSURLRequest alloc] initWithURL:backendURL];
     ZMLogInfo(@"Blacklist URL: %@", backendURL.absoluteString);
-    
-    //If we have something cached - pass it back
-    if (self.minVersion != nil && self.excludedVersions != nil) {
-        [self didDownloadBlacklistWithMinVersion:self.minVersion exclude:self.excludedVersions];
+
+    // The cached blacklist was reported on creation, only download it again if it changed
+    if (self.hasCachedBlacklist && (self.entityTag != nil || self.lastModified != nil)) {
+        NSMutableURLRequest *conditionalRequest = [urlRequest mutableCopy];
+        [conditionalRequest setValue:self.entityTag forHTTPHeaderField:@"If-None-Match"];
+        [conditionalRequest setValue:self.lastModified forHTTPHeaderField:@"If-Modified-Since"];
+        urlRequest = conditionalRequest;
     }
-    // But also redownload because it might change
+
     ZM_WEAK(self);
     [self.workingGroup enter];
     self.dataTask = [self.urlSession dataTaskWithRequest:urlRequest completionHandler:^(NSData *data, NSURLResponse * __unused response, NSError *error) {
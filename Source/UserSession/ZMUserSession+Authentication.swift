@@ -70,6 +70,9 @@ extension ZMUserSession {
 
         if deleteCookie {
             deleteUserKeychainItems()
+            phoneNumberNormalizationCache.delete()
+            addressBookUploadDigestStore.reset()
+            searchUserAssetCache.removeAll()
         }
 
         let uiMOC = managedObjectContext
@@ -96,6 +96,12 @@ public class ZMUserSession: NSObject {
 
     public lazy var featureService = FeatureService(context: syncContext)
 
+    lazy var phoneNumberNormalizationCache = PhoneNumberNormalizationCache(fileURL: PhoneNumberNormalizationCache.fileURL(in: coreDataStack.accountContainer))
+
+    lazy var addressBookUploadDigestStore = AddressBookUploadDigestStore(fileURL: AddressBookUploadDigestStore.fileURL(in: coreDataStack.accountContainer))
+
+    lazy var searchUserAssetCache = SearchUserAssetCache(directory: SearchUserAssetCache.directory(in: coreDataStack.accountContainer))
+
     public var appLockController: AppLockType
 
     public var fileSharingFeature: Feature.FileSharing {
@@ -267,7 +273,7 @@ public class ZMUserSession: NSObject {
         configureCaches()
 
         syncManagedObjectContext.performGroupedBlockAndWait {
-            self.localNotificationDispatcher = LocalNotificationDispatcher(in: coreDataStack.syncContext)
+            self.localNotificationDispatcher = LocalNotificationDispatcher(in: coreDataStack.syncContext, accountContainer: coreDataStack.accountContainer)
             self.configureTransportSession()
             self.applicationStatusDirectory = self.createApplicationStatusDirectory()
             self.updateEventProcessor = eventProcessor ?? self.createUpdateEventProcessor()
@@ -329,6 +335,7 @@ public class ZMUserSession: NSObject {
                                  flowManager: flowManager,
                                  updateEventProcessor: updateEventProcessor!,
                                  localNotificationDispatcher: localNotificationDispatcher!,
+                                 searchUserAssetCache: searchUserAssetCache,
                                  useLegacyPushNotifications: useLegacyPushNotifications)
     }
 
@@ -0,0 +1,250 @@
+//
+// Wire
+// Copyright (C) 2022 Wire Swiss GmbH
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see http://www.gnu.org/licenses/.
+//
+
+import Foundation
+import XCTest
+@testable import WireSyncEngine
+
+class CallEventBufferTests: XCTestCase {
+
+    private let conversationId = AVSIdentifier(identifier: UUID(), domain: "wire.com")
+    private let userId = AVSIdentifier(identifier: UUID(), domain: "wire.com")
+
+    func testThatItForwardsEventsInOrder() {
+        // Given
+        var sut = CallEventBuffer()
+        let events = [callEvent(type: "SETUP", sessionId: "1"), callEvent(type: "PROPSYNC", sessionId: "1")]
+
+        // When
+        events.forEach { sut.append($0, completionHandler: {}) }
+        let forwarded = sut.flush()
+
+        // Then
+        XCTAssertEqual(forwarded.map(\.event.data), events.map(\.data))
+        XCTAssertEqual(sut.count, 0)
+    }
+
+    func testThatItForwardsEventsItCannotInterpret() {
+        // Given
+        var sut = CallEventBuffer()
+        let event = callEvent(data: Data([0xFF, 0xD8]), age: 3600)
+
+        // When
+        sut.append(event, completionHandler: {})
+
+        // Then
+        XCTAssertEqual(sut.flush().count, 1)
+    }
+
+    func testThatItDropsDuplicateEvents() {
+        // Given
+        var sut = CallEventBuffer()
+        let event = callEvent(type: "SETUP", sessionId: "1")
+        var completionCount = 0
+
+        // When
+        sut.append(event, completionHandler: { completionCount += 1 })
+        sut.append(event, completionHandler: { completionCount += 1 })
+
+        // Then
+        XCTAssertEqual(completionCount, 1)
+        XCTAssertEqual(sut.flush().count, 1)
+        XCTAssertEqual(sut.statistics.deduplicatedCount, 1)
+    }
+
+    func testThatItDropsStaleEventsButKeepsTheCallStart() {
+        // Given
+        var sut = CallEventBuffer()
+        let setup = callEvent(type: "SETUP", sessionId: "1", age: 3600)
+        let propsync = callEvent(type: "PROPSYNC", sessionId: "1", age: 3590)
+        var completionCount = 0
+
+        // When
+        sut.append(setup, completionHandler: { completionCount += 1 })
+        sut.append(propsync, completionHandler: { completionCount += 1 })
+        let forwarded = sut.flush()
+
+        // Then
+        XCTAssertEqual(forwarded.map(\.event.data), [setup.data])
+        XCTAssertEqual(completionCount, 1)
+        XCTAssertEqual(sut.statistics.prunedCount, 1)
+        XCTAssertEqual(sut.statistics.forwardedCount, 1)
+    }
+
+    func testThatItForwardsTheEndOfAStaleCallStart() {
+        // Given
+        var sut = CallEventBuffer()
+        let setup = callEvent(type: "SETUP", sessionId: "1", age: 3600)
+        let propsync = callEvent(type: "PROPSYNC", sessionId: "1", age: 3595)
+        let cancel = callEvent(type: "CANCEL", sessionId: "1", age: 3590)
+
+        // When
+        [setup, propsync, cancel].forEach { sut.append($0, completionHandler: {}) }
+        let forwarded = sut.flush()
+
+        // Then
+        XCTAssertEqual(forwarded.map(\.event.data), [setup, cancel].map(\.data))
+        XCTAssertEqual(sut.statistics.prunedCount, 1)
+    }
+
+    func testThatItCollapsesRepeatedCallStartsOfASession() {
+        // Given
+        var sut = CallEventBuffer()
+        let setup = callEvent(type: "SETUP", sessionId: "1")
+        let repeatedSetup = callEvent(type: "SETUP", sessionId: "1")
+        let otherSession = callEvent(type: "SETUP", sessionId: "2")
+
+        // When
+        [setup, repeatedSetup, otherSession].forEach { sut.append($0, completionHandler: {}) }
+        let forwarded = sut.flush()
+
+        // Then
+        XCTAssertEqual(forwarded.map(\.event.data), [setup, otherSession].map(\.data))
+    }
+
+    func testThatItJudgesStalenessByTheTimestampsPassedToAVS() {
+        // Given
+        var sut = CallEventBuffer()
+        let now = Date()
+        let event = CallEvent(data: callEvent(type: "PROPSYNC", sessionId: "1").data,
+                              currentTimestamp: now.addingTimeInterval(-3600),
+                              serverTimestamp: now.addingTimeInterval(-3610),
+                              conversationId: conversationId,
+                              userId: userId,
+                              clientId: "client")
+
+        // When
+        sut.append(event, completionHandler: {})
+
+        // Then
+        XCTAssertEqual(sut.flush().count, 1)
+    }
+
+    func testThatItDropsEventsSupersededByTheEndOfTheSession() {
+        // Given
+        var sut = CallEventBuffer()
+        let setup = callEvent(type: "SETUP", sessionId: "1")
+        let propsync = callEvent(type: "PROPSYNC", sessionId: "1")
+        let otherSession = callEvent(type: "PROPSYNC", sessionId: "2")
+        let cancel = callEvent(type: "CANCEL", sessionId: "1")
+
+        // When
+        [setup, propsync, otherSession, cancel].forEach { sut.append($0, completionHandler: {}) }
+        let forwarded = sut.flush()
+
+        // Then
+        XCTAssertEqual(forwarded.map(\.event.data), [setup, otherSession, cancel].map(\.data))
+    }
+
+    func testThatItDropsTheOldestEventsWhenFull() {
+        // Given
+        var sut = CallEventBuffer(maxCount: 2)
+        let setup = callEvent(type: "SETUP", sessionId: "1")
+        let propsync1 = callEvent(type: "PROPSYNC", sessionId: "1")
+        let propsync2 = callEvent(type: "PROPSYNC", sessionId: "2")
+        var completionCount = 0
+
+        // When
+        [setup, propsync1, propsync2].forEach { sut.append($0, completionHandler: { completionCount += 1 }) }
+
+        // Then
+        XCTAssertEqual(completionCount, 1)
+        XCTAssertEqual(sut.statistics.overflowCount, 1)
+        XCTAssertEqual(sut.flush().map(\.event.data), [setup, propsync2].map(\.data))
+    }
+
+    func testThatItDropsEventsWithTheSameContentAsDuplicates() {
+        // Given
+        var sut = CallEventBuffer()
+        let event = callEvent(type: "SETUP", sessionId: "1")
+        let copy = CallEvent(data: event.data,
+                             currentTimestamp: event.currentTimestamp.addingTimeInterval(1),
+                             serverTimestamp: event.serverTimestamp,
+                             conversationId: event.conversationId,
+                             userId: event.userId,
+                             clientId: event.clientId)
+        let otherClient = CallEvent(data: event.data,
+                                    currentTimestamp: event.currentTimestamp,
+                                    serverTimestamp: event.serverTimestamp,
+                                    conversationId: event.conversationId,
+                                    userId: event.userId,
+                                    clientId: "other")
+
+        // When
+        [event, copy, otherClient].forEach { sut.append($0, completionHandler: {}) }
+
+        // Then
+        XCTAssertEqual(sut.statistics.deduplicatedCount, 1)
+        XCTAssertEqual(sut.flush().count, 2)
+    }
+
+    func testThatItResetsTheStatistics() {
+        // Given
+        var sut = CallEventBuffer()
+        let event = callEvent(type: "SETUP", sessionId: "1")
+        sut.append(event, completionHandler: {})
+        sut.append(event, completionHandler: {})
+        _ = sut.flush()
+
+        // When
+        sut.resetStatistics()
+
+        // Then
+        XCTAssertEqual(sut.statistics, CallEventBuffer.Statistics())
+    }
+
+    func testPerformanceOfFlushingALargeBuffer() {
+        // Given
+        let events = (0..<500).map { index in
+            callEvent(type: index % 10 == 0 ? "SETUP" : "PROPSYNC", sessionId: "\(index / 10)", age: TimeInterval(index))
+        }
+
+        // Then
+        measure {
+            var sut = CallEventBuffer()
+            events.forEach { sut.append($0, completionHandler: {}) }
+            _ = sut.flush()
+        }
+    }
+
+    // MARK: - Helpers
+
+    private func callEvent(type: String, sessionId: String, age: TimeInterval = 0) -> CallEvent {
+        let message: [String: Any] = [
+            "version": "3.0",
+            "type": type,
+            "sessid": sessionId,
+            "resp": false,
+            "nonce": UUID().transportString()
+        ]
+
+        return callEvent(data: try! JSONSerialization.data(withJSONObject: message), age: age)
+    }
+
+    private func callEvent(data: Data, age: TimeInterval) -> CallEvent {
+        let now = Date()
+
+        return CallEvent(data: data,
+                         currentTimestamp: now,
+                         serverTimestamp: now.addingTimeInterval(-age),
+                         conversationId: conversationId,
+                         userId: userId,
+                         clientId: "client")
+    }
+
+}
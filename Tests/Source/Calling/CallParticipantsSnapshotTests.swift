@@ -227,6 +227,122 @@ class CallParticipantsSnapshotTests: MessagingTest {
         XCTAssertEqual(sut.members.array, [updatedMember1, member2])
     }
 
+    // MARK: - Change Sets
+
+    func testThat_ItComputesInsertedDeletedUpdatedAndMovedParticipants() {
+        // Given
+        let alice = createUser()
+        let bob = createUser()
+        let aliceParticipant = participant(alice, clientId: "a", state: .connecting)
+        let bobParticipant = participant(bob, clientId: "b", state: .connecting)
+        let bobDesktopParticipant = participant(bob, clientId: "c", state: .connecting)
+        let newParticipant = participant(createUser(), clientId: "d", state: .connecting)
+        let updatedAliceParticipant = participant(alice, clientId: "a", state: .unconnectedButMayConnect)
+
+        // When
+        let changes = CallParticipantsChangeSet(from: [aliceParticipant, bobParticipant, bobDesktopParticipant],
+                                                to: [newParticipant, bobDesktopParticipant, updatedAliceParticipant])
+
+        // Then
+        XCTAssertEqual(changes.deletedIndexes, IndexSet(integer: 1))
+        XCTAssertEqual(changes.insertedIndexes, IndexSet(integer: 0))
+        XCTAssertEqual(changes.updatedIndexes, IndexSet(integer: 2))
+        XCTAssertEqual(changes.movedIndexes, [.init(from: 2, to: 1)])
+    }
+
+    func testThat_ItMovesAsFewParticipantsAsPossible() {
+        // Given
+        let participants = (0..<5).map { participant(createUser(), clientId: "\($0)", state: .connecting) }
+
+        // When
+        let changes = CallParticipantsChangeSet(from: participants,
+                                                to: [participants[4]] + participants[0..<4])
+
+        // Then
+        XCTAssertEqual(changes.movedIndexes, [.init(from: 4, to: 0)])
+        XCTAssertTrue(changes.insertedIndexes.isEmpty)
+        XCTAssertTrue(changes.deletedIndexes.isEmpty)
+    }
+
+    func testThat_ItDoesNotReportMovedParticipantsAsUpdated() {
+        // Given
+        let alice = createUser()
+        let bob = createUser()
+        let aliceParticipant = participant(alice, clientId: "a", state: .connecting)
+        let bobParticipant = participant(bob, clientId: "b", state: .connecting)
+        let updatedBobParticipant = participant(bob, clientId: "b", state: .unconnectedButMayConnect)
+
+        // When
+        let changes = CallParticipantsChangeSet(from: [aliceParticipant, bobParticipant],
+                                                to: [updatedBobParticipant, aliceParticipant])
+
+        // Then
+        XCTAssertEqual(changes.movedIndexes.count, 1)
+        XCTAssertTrue(changes.updatedIndexes.isEmpty)
+    }
+
+    func testThat_ItPostsChanges_WhenParticipantsChange() {
+        // Given
+        let alice = createUser()
+        let client = AVSClient(userId: alice.avsIdentifier, clientId: "iphone")
+        let sut = createSut(members: [])
+        let observer = MockCallParticipantChangeObserver()
+        let token = WireCallCenterV3.addCallParticipantChangeObserver(observer: observer, for: conversation(), context: uiMOC)
+
+        // When
+        sut.callParticipantsChanged(participants: [AVSCallMember(client: client)])
+        sut.callParticipantsChanged(participants: [AVSCallMember(client: client, audioState: .established)])
+        XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // Then
+        withExtendedLifetime(token) {
+            XCTAssertEqual(observer.changes.map(\.insertedIndexes), [IndexSet(integer: 0), IndexSet()])
+            XCTAssertEqual(observer.changes.map(\.updatedIndexes), [IndexSet(), IndexSet(integer: 0)])
+        }
+    }
+
+    func testThat_ItDoesNotPostChanges_WhenOnlyNetworkQualityChanges() {
+        // Given
+        let alice = createUser()
+        let client = AVSClient(userId: alice.avsIdentifier, clientId: "iphone")
+        let sut = createSut(members: [])
+        sut.callParticipantsChanged(participants: [AVSCallMember(client: client)])
+        let observer = MockCallParticipantChangeObserver()
+        let token = WireCallCenterV3.addCallParticipantChangeObserver(observer: observer, for: conversation(), context: uiMOC)
+
+        // When
+        sut.callParticipantNetworkQualityChanged(client: client, networkQuality: .poor)
+        sut.callParticipantsChanged(participants: [AVSCallMember(client: client, networkQuality: .poor)])
+        XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // Then
+        withExtendedLifetime(token) {
+            XCTAssertTrue(observer.changes.isEmpty)
+            XCTAssertEqual(sut.networkQuality, .poor)
+        }
+    }
+
+    // MARK: - Performance
+
+    func testPerformance_ParticipantChurn_With250Members() {
+        // Given
+        let clients = (0..<250).map { _ in AVSClient(userId: createUser().avsIdentifier, clientId: "iphone") }
+        let members = clients.map { AVSCallMember(client: $0, audioState: .established) }
+        let sut = createSut(members: [])
+        sut.callParticipantsChanged(participants: members)
+
+        // When, then
+        measure {
+            for round in 0..<50 {
+                var updated = members
+                updated[round] = AVSCallMember(client: clients[round], audioState: .networkProblem)
+                updated.remove(at: 100 + round)
+                sut.callParticipantsChanged(participants: updated)
+                sut.callParticipantNetworkQualityChanged(client: clients[200], networkQuality: round % 2 == 0 ? .poor : .normal)
+            }
+        }
+    }
+
     // MARK: - Call Degradation
 
     func testThat_ItDegradesCallSecurity_WithCorrectUser_WhenUserBecomesUnverified() {
@@ -269,6 +385,23 @@ class CallParticipantsSnapshotTests: MessagingTest {
         )
     }
 
+    private func createUser() -> ZMUser {
+        let user = ZMUser.insertNewObject(in: uiMOC)
+        user.remoteIdentifier = UUID()
+        return user
+    }
+
+    private func conversation() -> ZMConversation {
+        let conversation = ZMConversation.insertNewObject(in: uiMOC)
+        conversation.remoteIdentifier = conversationId.identifier
+        conversation.domain = conversationId.domain
+        return conversation
+    }
+
+    private func participant(_ user: ZMUser, clientId: String, state: CallParticipantState) -> CallParticipant {
+        return CallParticipant(user: user, clientId: clientId, state: state, activeSpeakerState: .inactive)
+    }
+
     private func setupUsersAndClients() {
         performPretendingUiMocIsSyncMoc {
             self.selfUser = ZMUser.selfUser(in: self.uiMOC)
@@ -343,3 +476,13 @@ private extension AVSCallMember {
     }
 
 }
+
+private class MockCallParticipantChangeObserver: WireCallCenterCallParticipantChangeObserver {
+
+    var changes = [CallParticipantsChangeSet]()
+
+    func callParticipantsDidChange(conversation: ZMConversation, participants: [CallParticipant], changes: CallParticipantsChangeSet) {
+        self.changes.append(changes)
+    }
+
+}
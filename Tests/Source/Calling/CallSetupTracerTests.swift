@@ -0,0 +1,208 @@
+//
+// Wire
+// Copyright (C) 2022 Wire Swiss GmbH
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see http://www.gnu.org/licenses/.
+//
+
+import Foundation
+import XCTest
+@testable import WireSyncEngine
+
+class CallSetupTracerTests: XCTestCase {
+
+    private var time: UInt64 = 0
+    private var sut: CallSetupTracer!
+    private let conversationId = UUID()
+
+    override func setUp() {
+        super.setUp()
+        time = 0
+        sut = CallSetupTracer(clock: { [unowned self] in self.time })
+    }
+
+    override func tearDown() {
+        sut = nil
+        super.tearDown()
+    }
+
+    func testThatItRecordsTheDurationOfEachStepOnceEstablished() {
+        // when
+        stamp(.pushReceived, atMilliseconds: 0)
+        stamp(.incomingCallHandled, atMilliseconds: 40)
+        stamp(.answered, atMilliseconds: 1040)
+        stamp(.established, atMilliseconds: 1240)
+
+        // then
+        let histograms = sut.stepHistograms
+        XCTAssertEqual(histograms.count, 3)
+        XCTAssertEqual(histograms[.init(from: .pushReceived, to: .incomingCallHandled)]?.totalMilliseconds, 40)
+        XCTAssertEqual(histograms[.init(from: .incomingCallHandled, to: .answered)]?.totalMilliseconds, 1000)
+        XCTAssertEqual(histograms[.init(from: .answered, to: .established)]?.totalMilliseconds, 200)
+        XCTAssertEqual(sut.totalHistogram.count, 1)
+        XCTAssertEqual(sut.totalHistogram.totalMilliseconds, 1240)
+    }
+
+    func testThatItOnlyCountsTheFirstStampOfAStage() {
+        // when
+        stamp(.pushReceived, atMilliseconds: 0)
+        stamp(.pushReceived, atMilliseconds: 500)
+        stamp(.established, atMilliseconds: 600)
+
+        // then
+        XCTAssertEqual(sut.totalHistogram.totalMilliseconds, 600)
+    }
+
+    func testThatItDoesNotRecordDiscardedTraces() {
+        // given
+        stamp(.pushReceived, atMilliseconds: 0)
+
+        // when
+        sut.discardTrace(conversationId: conversationId)
+        stamp(.established, atMilliseconds: 100)
+
+        // then
+        XCTAssertEqual(sut.totalHistogram.count, 0)
+        XCTAssertTrue(sut.stepHistograms.isEmpty)
+    }
+
+    func testThatItDropsStampsOfConversationsWithoutAnIncomingCall() {
+        // when
+        stamp(.callEventScheduled, atMilliseconds: 0)
+        stamp(.callEventForwarded, atMilliseconds: 10)
+        stamp(.answered, atMilliseconds: 20)
+        stamp(.established, atMilliseconds: 30)
+
+        // then
+        XCTAssertEqual(sut.totalHistogram.count, 0)
+        XCTAssertEqual(openTraceCount(), 0)
+    }
+
+    func testThatItRecordsAGroupCallOnce_WhenEveryParticipantIsEstablished() {
+        // given
+        stamp(.callEventForwarded, atMilliseconds: 0)
+        stamp(.incomingCallHandled, atMilliseconds: 10)
+        stamp(.established, atMilliseconds: 100)
+
+        // when
+        stamp(.callEventForwarded, atMilliseconds: 150)
+        stamp(.established, atMilliseconds: 200)
+        stamp(.callEventForwarded, atMilliseconds: 250)
+        stamp(.established, atMilliseconds: 300)
+
+        // then
+        XCTAssertEqual(sut.totalHistogram.count, 1)
+        XCTAssertEqual(sut.totalHistogram.totalMilliseconds, 90)
+        XCTAssertEqual(openTraceCount(), 0)
+    }
+
+    func testThatItTracesTheNextCallInTheConversation_WhenTheCallEnded() {
+        // given
+        stamp(.incomingCallHandled, atMilliseconds: 0)
+        stamp(.established, atMilliseconds: 100)
+        sut.discardTrace(conversationId: conversationId)
+
+        // when
+        stamp(.incomingCallHandled, atMilliseconds: 1000)
+        stamp(.established, atMilliseconds: 1300)
+
+        // then
+        XCTAssertEqual(sut.totalHistogram.count, 2)
+        XCTAssertEqual(sut.totalHistogram.totalMilliseconds, 400)
+    }
+
+    func testThatItRecordsTheStepsInTheOrderTheStagesWereReached() {
+        // when
+        stamp(.pushReceived, atMilliseconds: 0)
+        stamp(.incomingCallReported, atMilliseconds: 10)
+        stamp(.callEventScheduled, atMilliseconds: 50)
+        stamp(.incomingCallHandled, atMilliseconds: 100)
+        stamp(.established, atMilliseconds: 300)
+
+        // then
+        let histograms = sut.stepHistograms
+        XCTAssertEqual(Set(histograms.keys), [
+            .init(from: .pushReceived, to: .incomingCallReported),
+            .init(from: .incomingCallReported, to: .callEventScheduled),
+            .init(from: .callEventScheduled, to: .incomingCallHandled),
+            .init(from: .incomingCallHandled, to: .established)
+        ])
+        XCTAssertEqual(histograms[.init(from: .incomingCallReported, to: .callEventScheduled)]?.totalMilliseconds, 40)
+        XCTAssertEqual(sut.totalHistogram.totalMilliseconds, 300)
+    }
+
+    func testThatEachAccountHasItsOwnTracer() {
+        // given
+        let accountID = UUID()
+
+        // then
+        XCTAssertTrue(CallSetupTracer.tracer(forAccount: accountID) === CallSetupTracer.tracer(forAccount: accountID))
+        XCTAssertFalse(CallSetupTracer.tracer(forAccount: accountID) === CallSetupTracer.tracer(forAccount: UUID()))
+    }
+
+    func testThatItBucketsDurations() {
+        // when
+        var histogram = CallSetupTracer.Histogram()
+        histogram.record(milliseconds: 5)
+        histogram.record(milliseconds: 700)
+        histogram.record(milliseconds: 60000)
+
+        // then
+        XCTAssertEqual(histogram.bucketCounts.first, 1)
+        XCTAssertEqual(histogram.bucketCounts[CallSetupTracer.Histogram.bucketBounds.firstIndex(of: 1000)!], 1)
+        XCTAssertEqual(histogram.bucketCounts.last, 1)
+        XCTAssertEqual(histogram.count, 3)
+    }
+
+    func testThatTheDebugExportIsValidJSON() {
+        // given
+        stamp(.pushReceived, atMilliseconds: 0)
+        stamp(.established, atMilliseconds: 100)
+        sut.stamp(.pushReceived, conversationId: UUID())
+
+        // when
+        let export = sut.debugExport()
+
+        // then
+        let json = try? JSONSerialization.jsonObject(with: Data(export.utf8)) as? [String: Any]
+        XCTAssertNotNil(json?["steps"])
+        XCTAssertEqual((json?["open_traces"] as? [Any])?.count, 1)
+    }
+
+    func testPerformanceOfStamping() {
+        let conversationIds = (0..<100).map { _ in UUID() }
+
+        measure {
+            for conversationId in conversationIds {
+                for stage in CallSetupTracer.Stage.allCases {
+                    sut.stamp(stage, conversationId: conversationId)
+                }
+            }
+            _ = sut.totalHistogram
+        }
+    }
+
+    // MARK: - Helpers
+
+    private func stamp(_ stage: CallSetupTracer.Stage, atMilliseconds milliseconds: UInt64) {
+        time = milliseconds * NSEC_PER_MSEC
+        sut.stamp(stage, conversationId: conversationId)
+    }
+
+    private func openTraceCount() -> Int? {
+        let json = try? JSONSerialization.jsonObject(with: Data(sut.debugExport().utf8)) as? [String: Any]
+        return (json?["open_traces"] as? [Any])?.count
+    }
+
+}
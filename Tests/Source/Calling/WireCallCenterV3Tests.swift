@@ -726,6 +726,65 @@ class WireCallCenterV3Tests: MessagingTest {
         }
     }
 
+    func testThatItTracesTheSetupOfAnIncomingCall() {
+        // given
+        let tracer = CallSetupTracer()
+        sut.callSetupTracer = tracer
+        let callEvent = CallEvent(data: verySmallJPEGData(), currentTimestamp: Date(), serverTimestamp: Date(), conversationId: oneOnOneConversationID, userId: otherUserID, clientId: otherUserClientID)
+        sut.setCallReady(version: 3)
+        XCTAssert(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // when
+        tracer.stamp(.pushReceived, conversationId: oneOnOneConversationID.identifier)
+        sut.processCallEvent(callEvent, completionHandler: { })
+        sut.handleIncomingCall(conversationId: oneOnOneConversationID,
+                               messageTime: Date(),
+                               client: AVSClient(userId: otherUserID, clientId: otherUserClientID),
+                               isVideoCall: false,
+                               shouldRing: true,
+                               conversationType: .oneToOne)
+        sut.handleEstablishedCall(conversationId: oneOnOneConversationID)
+        XCTAssert(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // then
+        XCTAssertEqual(tracer.totalHistogram.count, 1)
+        XCTAssertEqual(Set(tracer.stepHistograms.keys), [
+            CallSetupTracer.Step(from: .pushReceived, to: .callEventForwarded),
+            CallSetupTracer.Step(from: .callEventForwarded, to: .incomingCallHandled),
+            CallSetupTracer.Step(from: .incomingCallHandled, to: .established)
+        ])
+        XCTAssertFalse(sut.callSetupDebugReport().isEmpty)
+    }
+
+    func testThatItTracesTheSetupOfAnIncomingGroupCallOnce() {
+        // given
+        let tracer = CallSetupTracer()
+        sut.callSetupTracer = tracer
+        let callEvent = CallEvent(data: verySmallJPEGData(), currentTimestamp: Date(), serverTimestamp: Date(), conversationId: groupConversationID, userId: otherUserID, clientId: otherUserClientID)
+        sut.setCallReady(version: 3)
+        XCTAssert(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        sut.handleIncomingCall(conversationId: groupConversationID,
+                               messageTime: Date(),
+                               client: AVSClient(userId: otherUserID, clientId: otherUserClientID),
+                               isVideoCall: false,
+                               shouldRing: true,
+                               conversationType: .group)
+
+        // when
+        for _ in 0..<3 {
+            sut.handleEstablishedCall(conversationId: groupConversationID)
+            sut.processCallEvent(callEvent, completionHandler: { })
+        }
+        XCTAssert(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // then
+        XCTAssertEqual(tracer.totalHistogram.count, 1)
+        XCTAssertEqual(Set(tracer.stepHistograms.keys), [
+            CallSetupTracer.Step(from: .incomingCallHandled, to: .established)
+        ])
+    }
+
     func testThatItCallProcessCallEventCompletionHandler() {
         // given
         let userId = AVSIdentifier.stub
@@ -1455,6 +1514,91 @@ extension WireCallCenterV3Tests {
 
     }
 
+    func testThatActiveSpeakersChangesAreCoalescedWithinAFrame() {
+        // GIVEN
+        let conversationId = groupConversationID!
+        let clients = (0..<3).map { _ in AVSClient(userId: otherUserID, clientId: UUID().transportString()) }
+
+        var pendingFrameEnds = [() -> Void]()
+        sut.mediaUpdateCoalescer.frameInterval = 0.2
+        sut.mediaUpdateCoalescer.scheduler = { _, endFrame in pendingFrameEnds.append(endFrame) }
+        sut.callSnapshots = callSnapshot(conversationId: conversationId, clients: clients)
+
+        // WHEN
+        for index in clients.indices {
+            let change = activeSpeakersChange(for: conversationId, clients: Array(clients.prefix(index + 1)))
+            sut.handleActiveSpeakersChange(conversationId: conversationId, data: change.data)
+        }
+        XCTAssert(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // THEN
+        XCTAssertEqual(sut.callSnapshots[conversationId]?.activeSpeakers.map(\.client), Array(clients.prefix(1)))
+        XCTAssertEqual(sut.mediaUpdateStatistics.activeSpeakersChangesReceived, 3)
+        XCTAssertEqual(sut.mediaUpdateStatistics.activeSpeakersNotificationsPosted, 1)
+
+        XCTAssertEqual(pendingFrameEnds.count, 1)
+
+        // WHEN
+        pendingFrameEnds.removeFirst()()
+        XCTAssert(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // THEN
+        XCTAssertEqual(sut.callSnapshots[conversationId]?.activeSpeakers.map(\.client), clients)
+        XCTAssertEqual(sut.mediaUpdateStatistics.activeSpeakersNotificationsPosted, 2)
+        XCTAssertEqual(pendingFrameEnds.count, 1)
+
+        // WHEN
+        pendingFrameEnds.removeFirst()()
+        XCTAssert(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // THEN
+        XCTAssertEqual(sut.mediaUpdateStatistics.activeSpeakersNotificationsPosted, 2)
+        XCTAssertTrue(pendingFrameEnds.isEmpty)
+    }
+
+    func testThatActiveSpeakersHandlerDoesNotPostNotification_WhenRankingDidNotChange() {
+        // GIVEN
+        let conversationId = groupConversationID!
+        let client = AVSClient.mockClient
+
+        sut.mediaUpdateCoalescer.frameInterval = 0
+        sut.callSnapshots = callSnapshot(conversationId: conversationId, clients: [client])
+        sut.handleActiveSpeakersChange(conversationId: conversationId, data: activeSpeakersChange(for: conversationId, clients: [client]).data)
+        XCTAssert(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        let quieterSpeaker = AVSActiveSpeakersChange.ActiveSpeaker(userId: client.userId, clientId: client.clientId, audioLevel: 0, audioLevelNow: 50)
+        let change = AVSActiveSpeakersChange(activeSpeakers: [quieterSpeaker])
+
+        // WHEN
+        sut.handleActiveSpeakersChange(conversationId: conversationId, data: change.data)
+        XCTAssert(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // THEN
+        XCTAssertEqual(sut.callSnapshots[conversationId]?.activeSpeakers, [quieterSpeaker])
+        XCTAssertEqual(sut.mediaUpdateStatistics.activeSpeakersChangesReceived, 2)
+        XCTAssertEqual(sut.mediaUpdateStatistics.activeSpeakersNotificationsPosted, 1)
+    }
+
+    func testThatNetworkQualityHandlerDoesNotPostNotification_WhenQualityDidNotChange() {
+        // GIVEN
+        let conversationId = groupConversationID!
+        let client = AVSClient.mockClient
+
+        sut.mediaUpdateCoalescer.frameInterval = 0
+        sut.callSnapshots = callSnapshot(conversationId: conversationId, clients: [client])
+
+        // WHEN
+        for _ in 0..<3 {
+            sut.handleNetworkQualityChange(conversationId: conversationId, userId: client.userId, clientId: client.clientId, quality: .poor)
+        }
+        XCTAssert(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // THEN
+        XCTAssertEqual(sut.networkQuality(conversationId: conversationId), .poor)
+        XCTAssertEqual(sut.mediaUpdateStatistics.networkQualityChangesReceived, 3)
+        XCTAssertEqual(sut.mediaUpdateStatistics.networkQualityNotificationsPosted, 1)
+    }
+
     typealias CallParticipantsTestsAssertion = ([CallParticipant], Int) -> Void
 
     private func testCallParticipants(activeSpeakerKind: ActiveSpeakerKind,
@@ -223,4 +223,67 @@ class TypingUsersTimeoutTests: MessagingTest {
         XCTAssertTrue(sut.contains(userB, for: conversationA))
         XCTAssertEqual(sut.userIds(in: conversationA), Set([userB.objectID]))
     }
+
+    func testThatItDoesNotPruneAUserWhoseTimeoutWasExtended() {
+        // Given
+        let timeout1 = Date(timeIntervalSinceNow: 10)
+        let timeout2 = Date(timeIntervalSinceNow: 15)
+        let timeout3 = Date(timeIntervalSinceNow: 20)
+        sut.add(userA, for: conversationA, withTimeout: timeout1)
+        sut.add(userA, for: conversationA, withTimeout: timeout3)
+
+        // When
+        let result = sut.pruneConversationsThatHaveTimoutBefore(date: timeout2)
+
+        // Then
+        XCTAssertEqual(result, Set())
+        XCTAssertTrue(sut.contains(userA, for: conversationA))
+        XCTAssertEqual(sut.firstTimeout, timeout3)
+    }
+
+    func testThatItDoesNotPruneAUserWhoWasRemovedAndAddedAgain() {
+        // Given
+        let timeout1 = Date(timeIntervalSinceNow: 10)
+        let timeout2 = Date(timeIntervalSinceNow: 20)
+        sut.add(userA, for: conversationA, withTimeout: timeout1)
+        sut.remove(userA, for: conversationA)
+        sut.add(userB, for: conversationB, withTimeout: timeout2)
+
+        // When
+        let result = sut.pruneConversationsThatHaveTimoutBefore(date: timeout2)
+
+        // Then
+        XCTAssertEqual(result, Set())
+        XCTAssertEqual(sut.userIds(in: conversationA), Set())
+        XCTAssertEqual(sut.userIds(in: conversationB), Set([userB.objectID]))
+        XCTAssertEqual(sut.firstTimeout, timeout2)
+    }
+
+    // MARK: - Performance
+
+    func testPerformanceOfTrackingManyTypingUsers() {
+        // Given
+        let conversations: [ZMConversation] = (0..<20).map { _ in ZMConversation.insertNewObject(in: uiMOC) }
+        let users: [ZMUser] = (0..<500).map { _ in ZMUser.insertNewObject(in: uiMOC) }
+        XCTAssert(uiMOC.saveOrRollback())
+        let startDate = Date()
+
+        measure {
+            // When
+            for round in 0..<5 {
+                for (index, user) in users.enumerated() {
+                    let timeout = startDate.addingTimeInterval(Double(round * users.count + index))
+                    sut.add(user, for: conversations[index % conversations.count], withTimeout: timeout)
+                    _ = sut.firstTimeout
+                }
+
+                conversations.forEach { _ = sut.userIds(in: $0) }
+            }
+
+            // Then
+            let prunedConversations = sut.pruneConversationsThatHaveTimoutBefore(date: startDate.addingTimeInterval(Double(5 * users.count)))
+            XCTAssertEqual(prunedConversations.count, conversations.count)
+            XCTAssertNil(sut.firstTimeout)
+        }
+    }
 }
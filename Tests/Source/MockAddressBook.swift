@@ -38,11 +38,17 @@ class MockAddressBook: WireSyncEngine.AddressBook, WireSyncEngine.AddressBookAcc
         return UInt(self.contacts.count) + numberOfAdditionalContacts
     }
 
+    /// Number of contacts passed to the blocks of `enumerateRawContacts`
+    var numberOfEnumeratedContacts = 0
+
     /// Enumerates the contacts, invoking the block for each contact.
     /// If the block returns false, it will stop enumerating them.
     func enumerateRawContacts(block: @escaping (WireSyncEngine.ContactRecord) -> (Bool)) {
-        for contact in self.contacts where !block(contact) {
+        for contact in self.contacts {
+            numberOfEnumeratedContacts += 1
+            if !block(contact) {
                 return
+            }
         }
         let infiniteContact = MockAddressBookContact(firstName: "johnny infinite",
                                                      emailAddresses: ["johnny.infinite@example.com"],
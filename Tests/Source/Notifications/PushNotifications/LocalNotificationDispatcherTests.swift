@@ -446,6 +446,198 @@ extension LocalNotificationDispatcherTests {
         XCTAssertEqual(self.conversation1.estimatedUnreadSelfMentionCount, 0)
         XCTAssertEqual(self.conversation1.estimatedUnreadSelfReplyCount, 1)
     }
+
+    // MARK: Background batches
+
+    func testThatItPrefetchesTheConversationsOfABatch() {
+        // GIVEN
+        let events = [conversation1, conversation2, conversation1].map {
+            createUpdateEvent(UUID.create(), conversationID: $0!.remoteIdentifier!, genericMessage: GenericMessage(content: Text(content: "Hello")), senderID: self.user1.remoteIdentifier)
+        }
+
+        // WHEN
+        let conversationMap = sut.prefetchConversations(for: events)
+
+        // THEN
+        XCTAssertEqual(conversationMap.count, 2)
+        XCTAssertEqual(conversationMap[.init(id: conversation1.remoteIdentifier!, domain: nil)], conversation1)
+        XCTAssertEqual(conversationMap[.init(id: conversation2.remoteIdentifier!, domain: nil)], conversation2)
+    }
+
+    func testThatItPrefetchesConversationsWithTheSameIdentifierOnDifferentDomains() {
+        // GIVEN
+        BackendInfo.isFederationEnabled = true
+        defer { BackendInfo.isFederationEnabled = false }
+
+        conversation1.domain = "a.wire.com"
+        conversation2.remoteIdentifier = conversation1.remoteIdentifier
+        conversation2.domain = "b.wire.com"
+
+        let events = [conversation1, conversation2].map {
+            createUpdateEvent(UUID.create(), conversationID: $0!.remoteIdentifier!, conversationDomain: $0!.domain, genericMessage: GenericMessage(content: Text(content: "Hello")), senderID: self.user1.remoteIdentifier)
+        }
+
+        // WHEN
+        let conversationMap = sut.prefetchConversations(for: events)
+
+        // THEN
+        XCTAssertEqual(conversationMap.count, 2)
+        XCTAssertEqual(conversationMap[.init(id: conversation1.remoteIdentifier!, domain: "a.wire.com")], conversation1)
+        XCTAssertEqual(conversationMap[.init(id: conversation2.remoteIdentifier!, domain: "b.wire.com")], conversation2)
+    }
+
+    func testThatItIgnoresEventsWithTheNonceOfAScheduledNotificationInTheSameBatch() {
+        // GIVEN
+        let nonce = UUID.create()
+        let message = GenericMessage(content: Text(content: "Hello"), nonce: nonce)
+        let event1 = createUpdateEvent(UUID.create(), conversationID: conversation1.remoteIdentifier!, genericMessage: message, senderID: self.user1.remoteIdentifier)
+        let event2 = createUpdateEvent(UUID.create(), conversationID: conversation1.remoteIdentifier!, genericMessage: message, senderID: self.user1.remoteIdentifier)
+
+        // WHEN
+        self.sut.processEventsWhileInBackground([event1, event2])
+        XCTAssertTrue(self.waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // THEN
+        XCTAssertEqual(self.scheduledRequests.count, 1)
+        XCTAssertTrue(self.sut.eventNotifications.containsNotification(messageNonce: nonce))
+    }
+
+    func testThatItCoalescesMessageNotificationsOfAConversationInABatch() {
+        // GIVEN
+        let events = (0..<5).map {
+            createUpdateEvent(UUID.create(), conversationID: conversation1.remoteIdentifier!, genericMessage: GenericMessage(content: Text(content: "Message \($0)")), senderID: self.user1.remoteIdentifier)
+        }
+
+        // WHEN
+        self.sut.processEventsWhileInBackground(events)
+        XCTAssertTrue(self.waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // THEN
+        XCTAssertEqual(self.scheduledRequests.count, 1)
+        XCTAssertEqual(self.scheduledRequests.first?.content.body, "5 messages in Conversation 1")
+        XCTAssertEqual(self.conversation1.estimatedUnreadCount, 5)
+    }
+
+    func testThatItDoesNotCoalesceMentionsOrMessagesOfOtherConversations() {
+        // GIVEN
+        let selfUserMention = Mention(range: NSRange(), user: selfUser)
+        var events = (0..<4).map {
+            createUpdateEvent(UUID.create(), conversationID: conversation1.remoteIdentifier!, genericMessage: GenericMessage(content: Text(content: "Message \($0)")), senderID: self.user1.remoteIdentifier)
+        }
+        events.append(createUpdateEvent(UUID.create(), conversationID: conversation1.remoteIdentifier!, genericMessage: GenericMessage(content: Text(content: "Mention", mentions: [selfUserMention])), senderID: self.user1.remoteIdentifier))
+        events.append(createUpdateEvent(UUID.create(), conversationID: conversation2.remoteIdentifier!, genericMessage: GenericMessage(content: Text(content: "Hello")), senderID: self.user1.remoteIdentifier))
+
+        // WHEN
+        self.sut.processEventsWhileInBackground(events)
+        XCTAssertTrue(self.waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // THEN
+        XCTAssertEqual(self.scheduledRequests.count, 3)
+        XCTAssertEqual(self.conversation1.estimatedUnreadCount, 5)
+        XCTAssertEqual(self.conversation1.estimatedUnreadSelfMentionCount, 1)
+        XCTAssertEqual(self.conversation2.estimatedUnreadCount, 1)
+    }
+
+    func testThatItDoesNotCoalesceMessageNotificationsWhenCoalescingIsDisabled() {
+        // GIVEN
+        sut.coalescingThreshold = 0
+        let events = (0..<5).map {
+            createUpdateEvent(UUID.create(), conversationID: conversation1.remoteIdentifier!, genericMessage: GenericMessage(content: Text(content: "Message \($0)")), senderID: self.user1.remoteIdentifier)
+        }
+
+        // WHEN
+        self.sut.processEventsWhileInBackground(events)
+        XCTAssertTrue(self.waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // THEN
+        XCTAssertEqual(self.scheduledRequests.count, 5)
+    }
+
+    func testThatItCancelsTheCoalescedNotificationWhenCancellingTheConversation() {
+        // GIVEN
+        let events = (0..<5).map {
+            createUpdateEvent(UUID.create(), conversationID: conversation1.remoteIdentifier!, genericMessage: GenericMessage(content: Text(content: "Message \($0)")), senderID: self.user1.remoteIdentifier)
+        }
+        self.sut.processEventsWhileInBackground(events)
+        XCTAssertTrue(self.waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+        let id = self.scheduledRequests.first!.identifier
+
+        // WHEN
+        self.sut.cancelNotification(for: conversation1)
+
+        // THEN
+        XCTAssertTrue(self.notificationCenter.removedNotifications.contains(id))
+    }
+
+    func testThatItReschedulesTheCoalescedNotification_WhenACoveredMessageIsDeleted() {
+        // GIVEN
+        let messages = (0..<5).map { GenericMessage(content: Text(content: "Message \($0)")) }
+        let events = messages.map {
+            createUpdateEvent(UUID.create(), conversationID: conversation1.remoteIdentifier!, genericMessage: $0, senderID: self.user1.remoteIdentifier)
+        }
+        self.sut.processEventsWhileInBackground(events)
+        XCTAssertTrue(self.waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+        let id = self.scheduledRequests.first!.identifier
+
+        // WHEN
+        let delete = GenericMessage(content: MessageDelete(messageId: UUID(uuidString: messages[2].messageID)!))
+        self.sut.processEventsWhileInBackground([createUpdateEvent(UUID.create(), conversationID: conversation1.remoteIdentifier!, genericMessage: delete, senderID: self.user1.remoteIdentifier)])
+        XCTAssertTrue(self.waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // THEN
+        XCTAssertTrue(self.notificationCenter.removedNotifications.contains(id))
+        XCTAssertEqual(self.scheduledRequests.count, 2)
+        XCTAssertEqual(self.scheduledRequests.last?.content.body, "4 messages in Conversation 1")
+    }
+
+    func testThatItSchedulesTheRemainingMessagesIndividually_WhenACoveredMessageIsHiddenBelowTheThreshold() {
+        // GIVEN
+        let messages = (0..<3).map { GenericMessage(content: Text(content: "Message \($0)")) }
+        let events = messages.map {
+            createUpdateEvent(UUID.create(), conversationID: conversation1.remoteIdentifier!, genericMessage: $0, senderID: self.user1.remoteIdentifier)
+        }
+        self.sut.processEventsWhileInBackground(events)
+        XCTAssertTrue(self.waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+        let id = self.scheduledRequests.first!.identifier
+
+        // WHEN
+        let hide = GenericMessage(content: MessageHide(conversationId: conversation1.remoteIdentifier!, messageId: UUID(uuidString: messages[0].messageID)!))
+        self.sut.processEventsWhileInBackground([createUpdateEvent(UUID.create(), conversationID: conversation1.remoteIdentifier!, genericMessage: hide, senderID: self.user1.remoteIdentifier)])
+        XCTAssertTrue(self.waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // THEN
+        XCTAssertTrue(self.notificationCenter.removedNotifications.contains(id))
+        XCTAssertEqual(self.scheduledRequests.count, 3)
+        XCTAssertTrue(self.sut.summariesByMessageNonce.isEmpty)
+    }
+
+    func testPerformanceOfProcessingABackgroundBatch() {
+        // GIVEN
+        var conversations = [ZMConversation]()
+        syncMOC.performGroupedBlockAndWait {
+            conversations = (0..<50).map { _ in
+                let conversation = ZMConversation.insertNewObject(in: self.syncMOC)
+                conversation.conversationType = .group
+                conversation.remoteIdentifier = UUID.create()
+                conversation.addParticipantAndUpdateConversationState(user: self.user1, role: nil)
+                return conversation
+            }
+            self.syncMOC.saveOrRollback()
+        }
+
+        measure {
+            let events = (0..<500).map { index in
+                createUpdateEvent(UUID.create(),
+                                  conversationID: conversations[index % conversations.count].remoteIdentifier!,
+                                  genericMessage: GenericMessage(content: Text(content: "Message \(index)")),
+                                  senderID: self.user1.remoteIdentifier)
+            }
+
+            syncMOC.performGroupedBlockAndWait {
+                self.sut.processEventsWhileInBackground(events)
+            }
+        }
+    }
 }
 
 // MARK: - Helpers
@@ -478,8 +670,8 @@ extension LocalNotificationDispatcherTests {
         ]
     }
 
-    func createUpdateEvent(_ nonce: UUID, conversationID: UUID, genericMessage: GenericMessage, senderID: UUID = UUID.create()) -> ZMUpdateEvent {
-        let payload: [String: Any] = [
+    func createUpdateEvent(_ nonce: UUID, conversationID: UUID, conversationDomain: String? = nil, genericMessage: GenericMessage, senderID: UUID = UUID.create()) -> ZMUpdateEvent {
+        var payload: [String: Any] = [
             "id": UUID.create().transportString(),
             "conversation": conversationID.transportString(),
             "from": senderID.transportString(),
@@ -488,6 +680,10 @@ extension LocalNotificationDispatcherTests {
             "type": "conversation.otr-message-add"
         ]
 
+        if let conversationDomain = conversationDomain {
+            payload["qualified_conversation"] = ["id": conversationID.transportString(), "domain": conversationDomain]
+        }
+
         return ZMUpdateEvent(uuid: nonce,
                              payload: payload,
                              transient: false,
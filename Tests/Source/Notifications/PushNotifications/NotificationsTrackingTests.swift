@@ -48,6 +48,7 @@ final class NotificationsTrackerTests: XCTestCase {
     func testThatItDoesIncrementCounters_started() {
         // WHEN
         sut.registerReceivedPush()
+        sut.flush()
 
         // THEN
         let attributes = mockAnalytics.persistedAttributes(for: sut.eventName)
@@ -59,6 +60,7 @@ final class NotificationsTrackerTests: XCTestCase {
     func testThatItDoesIncrementCounters_fetching() {
         // WHEN
         sut.registerStartStreamFetching()
+        sut.flush()
 
         // THEN
         let attributes = mockAnalytics.persistedAttributes(for: sut.eventName)
@@ -70,6 +72,7 @@ final class NotificationsTrackerTests: XCTestCase {
     func testThatItDoesIncrementCounters_completedFetching() {
         // WHEN
         sut.registerFinishStreamFetching()
+        sut.flush()
 
         // THEN
         let attributes = mockAnalytics.persistedAttributes(for: sut.eventName)
@@ -81,6 +84,7 @@ final class NotificationsTrackerTests: XCTestCase {
     func testThatItDoesIncrementCounters_finished() {
         // WHEN
         sut.registerNotificationProcessingCompleted()
+        sut.flush()
 
         // THEN
         let attributes = mockAnalytics.persistedAttributes(for: sut.eventName)
@@ -92,6 +96,7 @@ final class NotificationsTrackerTests: XCTestCase {
     func testThatItDoesIncrementCounters_aborted() {
         // WHEN
         sut.registerProcessingAborted()
+        sut.flush()
 
         // THEN
         let attributes = mockAnalytics.persistedAttributes(for: sut.eventName)
@@ -104,6 +109,7 @@ final class NotificationsTrackerTests: XCTestCase {
         // WHEN
         sut.registerReceivedPush()
         sut.registerReceivedPush()
+        sut.flush()
 
         // THEN
         let attributes = mockAnalytics.persistedAttributes(for: sut.eventName)
@@ -112,6 +118,56 @@ final class NotificationsTrackerTests: XCTestCase {
         XCTAssertEqual(attributes?[identifier] as? Int, 2)
     }
 
+    func testThatItKeepsCountersInMemoryUntilFlushed() {
+        // WHEN
+        sut.registerReceivedPush()
+
+        // THEN
+        XCTAssertEqual(mockAnalytics.persistedAttributes(for: sut.eventName)?.isEmpty, true)
+
+        // AND WHEN
+        sut.flush()
+
+        // THEN
+        let identifier = NotificationsTracker.Attributes.startedProcessing.identifier
+        XCTAssertEqual(mockAnalytics.persistedAttributes(for: sut.eventName)?[identifier] as? Int, 1)
+    }
+
+    func testThatItFlushesTheCounters_WhenProcessingEnds() {
+        // WHEN
+        sut.registerReceivedPush()
+        sut.registerProcessingExpired()
+
+        // THEN
+        let attributes = mockAnalytics.persistedAttributes(for: sut.eventName)
+        XCTAssertEqual(attributes?[NotificationsTracker.Attributes.startedProcessing.identifier] as? Int, 1)
+        XCTAssertEqual(attributes?[NotificationsTracker.Attributes.processingExpired.identifier] as? Int, 1)
+    }
+
+    func testThatItCountsIncrementsFromMultipleThreads() {
+        // WHEN
+        DispatchQueue.concurrentPerform(iterations: 8) { _ in
+            for _ in 0..<1000 {
+                sut.registerStartStreamFetching()
+            }
+        }
+        sut.flush()
+
+        // THEN
+        let identifier = NotificationsTracker.Attributes.startedFetchingStream.identifier
+        XCTAssertEqual(mockAnalytics.persistedAttributes(for: sut.eventName)?[identifier] as? Int, 8000)
+    }
+
+    func testPerformanceOfIncrementingFromMultipleThreads() {
+        measure {
+            DispatchQueue.concurrentPerform(iterations: 8) { _ in
+                for _ in 0..<10_000 {
+                    sut.registerStartStreamFetching()
+                }
+            }
+        }
+    }
+
     func testThatItDispatchesPersistedAttributes() {
         // GIVEN
         sut.registerReceivedPush()
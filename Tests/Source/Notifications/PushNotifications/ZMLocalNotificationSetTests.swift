@@ -47,6 +47,7 @@ class ZMLocalNotificationSetTests: MessagingTest {
     var sut: ZMLocalNotificationSet!
     var notificationCenter: UserNotificationCenterMock!
     var keyValueStore: MockKVStore!
+    var journalURL: URL!
     let archivingKey = "archivingKey"
 
     var sender: ZMUser!
@@ -56,7 +57,8 @@ class ZMLocalNotificationSetTests: MessagingTest {
     override func setUp() {
         super.setUp()
         keyValueStore = MockKVStore()
-        sut = ZMLocalNotificationSet(archivingKey: archivingKey, keyValueStore: keyValueStore)
+        journalURL = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString).appendingPathComponent("notifications.journal")
+        sut = ZMLocalNotificationSet(archivingKey: archivingKey, keyValueStore: keyValueStore, journalURL: journalURL)
 
         notificationCenter = UserNotificationCenterMock()
         sut.notificationCenter = notificationCenter
@@ -72,6 +74,8 @@ class ZMLocalNotificationSetTests: MessagingTest {
     }
 
     override func tearDown() {
+        try? FileManager.default.removeItem(at: journalURL.deletingLastPathComponent())
+        journalURL = nil
         keyValueStore = nil
         sut = nil
         notificationCenter = nil
@@ -138,7 +142,7 @@ class ZMLocalNotificationSetTests: MessagingTest {
         sut.addObject(note!)
 
         // when recreate sut to release non-persisted objects
-        sut = ZMLocalNotificationSet(archivingKey: archivingKey, keyValueStore: keyValueStore)
+        sut = ZMLocalNotificationSet(archivingKey: archivingKey, keyValueStore: keyValueStore, journalURL: journalURL)
 
         // then
         XCTAssertTrue(sut.oldNotifications.contains(note!.userInfo!))
@@ -158,6 +162,156 @@ class ZMLocalNotificationSetTests: MessagingTest {
         XCTAssertEqual(sut.notifications.count, 0)
     }
 
+    func testThatItPersistsRemovedNotifications() {
+
+        // given
+        let notes = (0..<3).map { createNotification(text: "Hello \($0)", in: conversation1) }
+        notes.forEach { sut.addObject($0) }
+
+        // when
+        sut.remove(notes[1])
+        sut = ZMLocalNotificationSet(archivingKey: archivingKey, keyValueStore: keyValueStore, journalURL: journalURL)
+
+        // then
+        XCTAssertEqual(sut.oldNotifications.count, 2)
+        XCTAssertFalse(sut.oldNotifications.contains(notes[1].userInfo!))
+    }
+
+    func testThatItPersistsCancelledOldNotifications() {
+
+        // given
+        sut.addObject(createNotification(text: "Hello", in: conversation1))
+        sut.addObject(createNotification(text: "Bye", in: conversation2))
+        sut = ZMLocalNotificationSet(archivingKey: archivingKey, keyValueStore: keyValueStore, journalURL: journalURL)
+        sut.notificationCenter = notificationCenter
+
+        // when
+        sut.cancelNotifications(conversation1)
+        sut = ZMLocalNotificationSet(archivingKey: archivingKey, keyValueStore: keyValueStore, journalURL: journalURL)
+
+        // then
+        XCTAssertEqual(sut.oldNotifications.map(\.conversationID), [conversation2.remoteIdentifier])
+    }
+
+    func testThatItCompactsTheJournal() {
+
+        // given
+        let notes = (0...ZMLocalNotificationSet.maxJournalLength + 10).map { createNotification(text: "Hello \($0)", in: conversation1) }
+
+        // when
+        notes.forEach { sut.addObject($0) }
+        sut.remove(notes[0])
+
+        // then
+        XCTAssertLessThan(sut.journalLength, ZMLocalNotificationSet.maxJournalLength)
+        XCTAssertNotNil(keyValueStore.storedValue(key: archivingKey))
+
+        // and when
+        sut = ZMLocalNotificationSet(archivingKey: archivingKey, keyValueStore: keyValueStore, journalURL: journalURL)
+
+        // then
+        XCTAssertEqual(sut.oldNotifications.count, notes.count - 1)
+        XCTAssertFalse(sut.oldNotifications.contains(notes[0].userInfo!))
+    }
+
+    func testThatItKeepsTheJournal_WhenTheCompactedArchiveWasNotSaved() {
+
+        // given
+        let notes = (0...ZMLocalNotificationSet.maxJournalLength + 10).map { createNotification(text: "Hello \($0)", in: conversation1) }
+        sut.addObject(notes[0])
+        let savedValues = keyValueStore.keysAndValues
+
+        // when
+        notes.dropFirst().forEach { sut.addObject($0) }
+        sut.remove(notes[0])
+        keyValueStore.keysAndValues = savedValues
+        sut = ZMLocalNotificationSet(archivingKey: archivingKey, keyValueStore: keyValueStore, journalURL: journalURL)
+
+        // then
+        XCTAssertEqual(sut.oldNotifications.count, notes.count - 1)
+        XCTAssertFalse(sut.oldNotifications.contains(notes[0].userInfo!))
+    }
+
+    func testThatItDoesNotReplayTheJournalTwice_AfterTruncatingIt() {
+
+        // given
+        let notes = (0...ZMLocalNotificationSet.maxJournalLength + 10).map { createNotification(text: "Hello \($0)", in: conversation1) }
+        notes.forEach { sut.addObject($0) }
+        sut = ZMLocalNotificationSet(archivingKey: archivingKey, keyValueStore: keyValueStore, journalURL: journalURL)
+
+        // when
+        sut = ZMLocalNotificationSet(archivingKey: archivingKey, keyValueStore: keyValueStore, journalURL: journalURL)
+
+        // then
+        XCTAssertEqual(sut.oldNotifications.count, notes.count)
+        XCTAssertEqual(Set(sut.oldNotifications.compactMap(\.requestID)).count, notes.count)
+    }
+
+    func testThatItPersistsTheCompactedStateWhenCancellingAllNotifications() {
+
+        // given
+        sut.addObject(createNotification(text: "Hello", in: conversation1))
+
+        // when
+        sut.cancelAllNotifications()
+        sut = ZMLocalNotificationSet(archivingKey: archivingKey, keyValueStore: keyValueStore, journalURL: journalURL)
+
+        // then
+        XCTAssertTrue(sut.oldNotifications.isEmpty)
+        XCTAssertEqual(sut.journalLength, 0)
+    }
+
+    func testThatItPersistsNotificationsInTheArchive_WhenThereIsNoJournal() {
+
+        // given
+        sut = ZMLocalNotificationSet(archivingKey: archivingKey, keyValueStore: keyValueStore)
+        let notes = (0..<2).map { createNotification(text: "Hello \($0)", in: conversation1) }
+        notes.forEach { sut.addObject($0) }
+
+        // when
+        sut.remove(notes[0])
+        sut = ZMLocalNotificationSet(archivingKey: archivingKey, keyValueStore: keyValueStore)
+
+        // then
+        XCTAssertEqual(sut.oldNotifications, [notes[1].userInfo!])
+        XCTAssertEqual(sut.journalLength, 0)
+    }
+
+    func testThatItIgnoresAPartiallyWrittenJournalRecord() throws {
+
+        // given
+        let note = createNotification(text: "Hello", in: conversation1)
+        sut.addObject(note)
+
+        let fileHandle = try FileHandle(forWritingTo: journalURL)
+        fileHandle.seekToEndOfFile()
+        fileHandle.write(Data([0, 0, 1, 0, 42]))
+        fileHandle.closeFile()
+
+        // when
+        sut = ZMLocalNotificationSet(archivingKey: archivingKey, keyValueStore: keyValueStore, journalURL: journalURL)
+
+        // then
+        XCTAssertEqual(sut.oldNotifications, [note.userInfo!])
+        XCTAssertEqual(sut.journalLength, 1)
+    }
+
+    func testPerformanceOfSchedulingNotifications() {
+        let notes = (0..<1000).map { createNotification(text: "Hello \($0)", in: conversation1) }
+
+        measure {
+            let journalURL = self.journalURL.deletingLastPathComponent().appendingPathComponent(UUID().uuidString)
+            let sut = ZMLocalNotificationSet(archivingKey: UUID().uuidString, keyValueStore: keyValueStore, journalURL: journalURL)
+            notes.forEach { sut.addObject($0) }
+        }
+    }
+
+    func createNotification(text: String, in conversation: ZMConversation) -> ZMLocalNotification {
+        let genericMessage = GenericMessage(content: WireProtos.Text(content: text))
+        let event = createUpdateEvent(UUID.create(), conversationID: conversation.remoteIdentifier!, genericMessage: genericMessage, senderID: sender.remoteIdentifier!)
+        return ZMLocalNotification(event: event, conversation: conversation, managedObjectContext: self.uiMOC)!
+    }
+
     func createUpdateEvent(_ nonce: UUID, conversationID: UUID, genericMessage: GenericMessage, senderID: UUID = UUID.create()) -> ZMUpdateEvent {
         let payload: [String: Any] = [
             "id": UUID.create().transportString(),
@@ -448,6 +448,185 @@ extension AddressBookTests {
         // then
         checkEqual(lhs: chunk1, rhs: chunk2)
     }
+
+    func testThatChunkEncoderEncodesTheWholeAddressBookInSuccessiveChunks() {
+
+        // given
+        self.addressBook.fillWithContacts(25)
+        let queue = NSManagedObjectContext(concurrencyType: .privateQueueConcurrencyType)
+        queue.createDispatchGroups()
+        let expectation = self.expectation(description: "Completion invoked")
+        let sut = AddressBookChunkEncoder(addressBook: self.addressBook, chunkSize: 10)
+        var chunks = [EncodedAddressBookChunk]()
+
+        // when
+        sut.encode(queue, chunkHandler: { chunk in
+            chunks.append(chunk)
+        }, completion: { numberOfEncodedContacts in
+            XCTAssertEqual(numberOfEncodedContacts, 25)
+            expectation.fulfill()
+        })
+
+        self.waitForExpectations(timeout: 0.5) { error in
+            XCTAssertNil(error)
+        }
+
+        // then
+        XCTAssertEqual(chunks.map(\.includedContacts), [0..<10, 10..<20, 20..<25])
+        XCTAssertEqual(chunks.map(\.numberOfTotalContacts), [25, 25, 25])
+        for contact in self.addressBook.contacts {
+            let chunk = chunks.first { $0.otherContactsHashes[contact.localIdentifier] != nil }
+            XCTAssertEqual(chunk?.otherContactsHashes[contact.localIdentifier], contact.expectedHashes)
+        }
+    }
+
+    func testThatChunkEncoderStopsAtMaxNumberOfContacts() {
+
+        // given
+        self.addressBook.createInfiniteContacts = true
+        let queue = NSManagedObjectContext(concurrencyType: .privateQueueConcurrencyType)
+        queue.createDispatchGroups()
+        let expectation = self.expectation(description: "Completion invoked")
+        let sut = AddressBookChunkEncoder(addressBook: self.addressBook, chunkSize: 10)
+        var chunks = [EncodedAddressBookChunk]()
+
+        // when
+        sut.encode(queue, maxNumberOfContacts: 15, chunkHandler: { chunk in
+            chunks.append(chunk)
+        }, completion: { numberOfEncodedContacts in
+            XCTAssertEqual(numberOfEncodedContacts, 15)
+            expectation.fulfill()
+        })
+
+        self.waitForExpectations(timeout: 0.5) { error in
+            XCTAssertNil(error)
+        }
+
+        // then
+        XCTAssertEqual(chunks.map(\.includedContacts), [0..<10, 10..<15])
+    }
+
+    func testThatChunkEncoderEncodesNothingWhenMaxNumberOfContactsIsZero() {
+
+        // given
+        self.addressBook.fillWithContacts(5)
+        let queue = NSManagedObjectContext(concurrencyType: .privateQueueConcurrencyType)
+        queue.createDispatchGroups()
+        let expectation = self.expectation(description: "Completion invoked")
+        let sut = AddressBookChunkEncoder(addressBook: self.addressBook, chunkSize: 10)
+        var chunks = [EncodedAddressBookChunk]()
+
+        // when
+        sut.encode(queue, maxNumberOfContacts: 0, chunkHandler: { chunk in
+            chunks.append(chunk)
+        }, completion: { numberOfEncodedContacts in
+            XCTAssertEqual(numberOfEncodedContacts, 0)
+            expectation.fulfill()
+        })
+
+        self.waitForExpectations(timeout: 0.5) { error in
+            XCTAssertNil(error)
+        }
+
+        // then
+        XCTAssertTrue(chunks.isEmpty)
+    }
+
+    func testThatItEncodesAnEmptyChunkWhenMaxNumberOfContactsIsZero() {
+
+        // given
+        self.addressBook.fillWithContacts(5)
+        let queue = NSManagedObjectContext(concurrencyType: .privateQueueConcurrencyType)
+        queue.createDispatchGroups()
+        let expectation = self.expectation(description: "Callback invoked")
+
+        // when
+        self.addressBook.encodeWithCompletionHandler(queue, startingContactIndex: 0, maxNumberOfContacts: 0) { chunk in
+
+            // then
+            XCTAssertEqual(chunk?.numberOfTotalContacts, 5)
+            XCTAssertEqual(chunk?.includedContacts, UInt(0)..<UInt(0))
+            XCTAssertEqual(chunk?.otherContactsHashes.count, 0)
+            expectation.fulfill()
+        }
+
+        self.waitForExpectations(timeout: 0.5) { error in
+            XCTAssertNil(error)
+        }
+    }
+
+    func testThatChunkEncoderEnumeratesTheAddressBookAboutOnce_WhenChunksAreRequestedOneByOne() {
+
+        // given
+        self.addressBook.fillWithContacts(100)
+        let queue = NSManagedObjectContext(concurrencyType: .privateQueueConcurrencyType)
+        queue.createDispatchGroups()
+        let sut = AddressBookChunkEncoder(addressBook: self.addressBook, chunkSize: 10)
+        var chunks = [EncodedAddressBookChunk]()
+
+        // when
+        for startingContactIndex in stride(from: UInt(0), to: 100, by: 10) {
+            let expectation = self.expectation(description: "Callback invoked")
+            sut.encodeChunk(queue, startingContactIndex: startingContactIndex, maxNumberOfContacts: 10) { chunk in
+                chunk.map { chunks.append($0) }
+                expectation.fulfill()
+            }
+
+            self.waitForExpectations(timeout: 0.5) { error in
+                XCTAssertNil(error)
+            }
+        }
+
+        // then
+        XCTAssertEqual(chunks.map(\.includedContacts), stride(from: UInt(0), to: 100, by: 10).map { $0..<($0 + 10) })
+        XCTAssertEqual(Set(chunks.flatMap(\.otherContactsHashes.keys)), Set(self.addressBook.contacts.map(\.localIdentifier)))
+        XCTAssertLessThanOrEqual(self.addressBook.numberOfEnumeratedContacts, 3 * 100)
+    }
+
+    func testPerformanceOfChunkEncodingLargeAddressBook() {
+
+        // given
+        self.addressBook.fillWithContacts(20_000)
+        let queue = NSManagedObjectContext(concurrencyType: .privateQueueConcurrencyType)
+        queue.createDispatchGroups()
+        let sut = AddressBookChunkEncoder(addressBook: self.addressBook, chunkSize: 1000)
+
+        // then
+        measure {
+            let expectation = self.expectation(description: "Completion invoked")
+            sut.encode(queue, chunkHandler: { _ in }, completion: { _ in
+                expectation.fulfill()
+            })
+            self.waitForExpectations(timeout: 30)
+        }
+    }
+}
+
+// MARK: - Normalization cache
+extension AddressBookTests {
+
+    func testPerformanceOfRepeatedSearchesWithoutNormalizationCache() {
+        let addressBook = MockAddressBook(normalizationCache: nil)
+        addressBook.fillWithContacts(2000)
+
+        measure {
+            for query in ["tester", "tester 1", "tester 12", "tester 123"] {
+                _ = addressBook.contacts(matchingQuery: query)
+            }
+        }
+    }
+
+    func testPerformanceOfRepeatedSearchesWithNormalizationCache() {
+        let addressBook = MockAddressBook(normalizationCache: PhoneNumberNormalizationCache(fileURL: nil))
+        addressBook.fillWithContacts(2000)
+
+        measure {
+            for query in ["tester", "tester 1", "tester 12", "tester 123"] {
+                _ = addressBook.contacts(matchingQuery: query)
+            }
+        }
+    }
+
 }
 
 // MARK: - Helpers
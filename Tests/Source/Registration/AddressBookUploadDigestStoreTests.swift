@@ -0,0 +1,175 @@
+//
+// Wire
+// Copyright (C) 2022 Wire Swiss GmbH
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see http://www.gnu.org/licenses/.
+//
+
+import Foundation
+@testable import WireSyncEngine
+
+class AddressBookUploadDigestStoreTests: XCTestCase {
+
+    var fileURL: URL!
+
+    override func setUp() {
+        super.setUp()
+        fileURL = FileManager.default.temporaryDirectory.appendingPathComponent("\(UUID().uuidString).json")
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: fileURL)
+        fileURL = nil
+        super.tearDown()
+    }
+
+    func testThatTheFirstDiffIsAFullUpload() {
+        // given
+        let sut = AddressBookUploadDigestStore(fileURL: nil)
+        let cards = ["1": ["a"], "2": ["b", "c"]]
+
+        // when
+        let diff = sut.diff(with: cards)
+
+        // then
+        XCTAssertTrue(diff.isFullUpload)
+        XCTAssertEqual(diff.addedCards, cards)
+        XCTAssertTrue(diff.changedCards.isEmpty)
+        XCTAssertTrue(diff.removedIdentifiers.isEmpty)
+        XCTAssertEqual(diff.changeRatio, 1)
+    }
+
+    func testThatItOnlyReportsChangedCardsAfterUpload() {
+        // given
+        let sut = AddressBookUploadDigestStore(fileURL: nil)
+        sut.markAsUploaded(sut.diff(with: ["1": ["a"], "2": ["b", "c"], "3": ["d"]]))
+
+        // when
+        let diff = sut.diff(with: ["1": ["a"], "2": ["b", "x"], "4": ["e"]])
+
+        // then
+        XCTAssertFalse(diff.isFullUpload)
+        XCTAssertEqual(diff.addedCards, ["4": ["e"]])
+        XCTAssertEqual(diff.changedCards, ["2": ["b", "x"]])
+        XCTAssertEqual(diff.removedIdentifiers, ["3"])
+        XCTAssertEqual(diff.numberOfUnchangedCards, 1)
+        XCTAssertEqual(diff.changeRatio, 0.75)
+    }
+
+    func testThatTheOrderOfHashesDoesNotMatter() {
+        // given
+        let sut = AddressBookUploadDigestStore(fileURL: nil)
+        sut.markAsUploaded(sut.diff(with: ["1": ["a", "b"]]))
+
+        // when
+        let diff = sut.diff(with: ["1": ["b", "a"]])
+
+        // then
+        XCTAssertTrue(diff.isEmpty)
+    }
+
+    func testThatItRestoresPersistedDigests() {
+        // given
+        let sut = AddressBookUploadDigestStore(fileURL: fileURL)
+        sut.markAsUploaded(sut.diff(with: ["1": ["a"]]))
+
+        // when
+        let restored = AddressBookUploadDigestStore(fileURL: fileURL)
+
+        // then
+        XCTAssertEqual(restored.count, 1)
+        XCTAssertTrue(restored.diff(with: ["1": ["a"]]).isEmpty)
+    }
+
+    func testThatResetResultsInAFullUpload() {
+        // given
+        let sut = AddressBookUploadDigestStore(fileURL: nil)
+        sut.markAsUploaded(sut.diff(with: ["1": ["a"]]))
+
+        // when
+        sut.reset()
+
+        // then
+        XCTAssertTrue(sut.diff(with: ["1": ["a"]]).isFullUpload)
+    }
+
+    func testThatItEncodesTheDiffOfTheAddressBook() {
+        // given
+        let addressBook = MockAddressBook(normalizationCache: nil)
+        addressBook.fillWithContacts(20)
+        let queue = NSManagedObjectContext(concurrencyType: .privateQueueConcurrencyType)
+        queue.createDispatchGroups()
+        let sut = AddressBookUploadDigestStore(fileURL: nil)
+        let encoder = AddressBookChunkEncoder(addressBook: addressBook, chunkSize: 7)
+        let initialUpload = expectation(description: "Initial diff encoded")
+
+        encoder.encodeDiff(queue, against: sut) { diff in
+            XCTAssertEqual(diff.addedCards.count, 20)
+            sut.markAsUploaded(diff)
+            initialUpload.fulfill()
+        }
+        waitForExpectations(timeout: 0.5)
+
+        // when
+        addressBook.contacts[3].rawEmails = ["changed@example.com"]
+        let secondUpload = expectation(description: "Second diff encoded")
+        var secondDiff: AddressBookCardDiff?
+
+        encoder.encodeDiff(queue, against: sut) { diff in
+            secondDiff = diff
+            secondUpload.fulfill()
+        }
+        waitForExpectations(timeout: 0.5)
+
+        // then
+        XCTAssertEqual(secondDiff?.changedCards.keys.sorted(), [addressBook.contacts[3].localIdentifier])
+        XCTAssertEqual(secondDiff?.addedCards.count, 0)
+        XCTAssertEqual(secondDiff?.numberOfUnchangedCards, 19)
+    }
+
+    func testThatCardsOfContactsWithoutIdentifierDoNotDependOnTheirPosition() {
+        // given
+        let first = ZMAddressBookContact()
+        first.emailAddresses = ["first@example.com"]
+        let second = ZMAddressBookContact()
+        second.emailAddresses = ["second@example.com"]
+
+        // when
+        let bothCards = [first, second].contactCards(keying: .content)
+        let secondCards = [second].contactCards(keying: .content)
+
+        // then
+        XCTAssertEqual(bothCards.count, 2)
+        XCTAssertEqual(secondCards.count, 1)
+        for (identifier, hashes) in secondCards {
+            XCTAssertEqual(bothCards[identifier], hashes)
+        }
+    }
+
+    func testThatUploadedCardsOfContactsWithoutIdentifierAreKeyedByPosition() {
+        // given
+        let first = ZMAddressBookContact()
+        first.emailAddresses = ["first@example.com"]
+        let second = ZMAddressBookContact()
+        second.emailAddresses = ["second@example.com"]
+
+        // when
+        let cards = [first, second].contactCards()
+
+        // then
+        XCTAssertEqual(cards["0"], ["first@example.com".base64EncodedSHADigest])
+        XCTAssertEqual(cards["1"], ["second@example.com".base64EncodedSHADigest])
+    }
+
+}
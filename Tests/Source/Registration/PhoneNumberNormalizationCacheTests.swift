@@ -0,0 +1,138 @@
+//
+// Wire
+// Copyright (C) 2022 Wire Swiss GmbH
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see http://www.gnu.org/licenses/.
+//
+
+import Foundation
+@testable import WireSyncEngine
+
+class PhoneNumberNormalizationCacheTests: XCTestCase {
+
+    var fileURL: URL!
+
+    override func setUp() {
+        super.setUp()
+        fileURL = FileManager.default.temporaryDirectory.appendingPathComponent("\(UUID().uuidString).json")
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: fileURL)
+        fileURL = nil
+        super.tearDown()
+    }
+
+    func testThatItNormalizesEachRawNumberOnlyOnce() {
+        // given
+        let sut = PhoneNumberNormalizationCache(fileURL: nil)
+        var normalizationCount = 0
+        let normalizer: AddressBook.Normalizer = {
+            normalizationCount += 1
+            return $0 == "invalid" ? nil : "+41\($0)"
+        }
+
+        // when
+        let first = sut.normalizedNumber(for: "123", normalizer: normalizer)
+        let second = sut.normalizedNumber(for: "123", normalizer: normalizer)
+        let invalid = sut.normalizedNumber(for: "invalid", normalizer: normalizer)
+        let invalidAgain = sut.normalizedNumber(for: "invalid", normalizer: normalizer)
+
+        // then
+        XCTAssertEqual(first, "+41123")
+        XCTAssertEqual(second, "+41123")
+        XCTAssertNil(invalid)
+        XCTAssertNil(invalidAgain)
+        XCTAssertEqual(normalizationCount, 2)
+    }
+
+    func testThatItDiscardsEntriesWhenTheRegionChanges() {
+        // given
+        let sut = PhoneNumberNormalizationCache(fileURL: nil)
+        sut.invalidateIfNeeded(region: "CH")
+        _ = sut.normalizedNumber(for: "123", normalizer: { $0 })
+
+        // when
+        sut.invalidateIfNeeded(region: "CH")
+
+        // then
+        XCTAssertEqual(sut.count, 1)
+
+        // when
+        sut.invalidateIfNeeded(region: "DE")
+
+        // then
+        XCTAssertEqual(sut.count, 0)
+    }
+
+    func testThatItRestoresPersistedEntries() {
+        // given
+        let sut = PhoneNumberNormalizationCache(fileURL: fileURL)
+        sut.invalidateIfNeeded(region: "CH")
+        _ = sut.normalizedNumber(for: "123", normalizer: { _ in "+41123" })
+
+        // when
+        sut.persist()
+        let restored = PhoneNumberNormalizationCache(fileURL: fileURL)
+        restored.invalidateIfNeeded(region: "CH")
+
+        // then
+        XCTAssertEqual(restored.normalizedNumber(for: "123", normalizer: { _ in
+            XCTFail("Should not normalize again")
+            return nil
+        }), "+41123")
+    }
+
+    func testThatItDoesNotPersistRawNumbers() throws {
+        // given
+        let sut = PhoneNumberNormalizationCache(fileURL: fileURL)
+        _ = sut.normalizedNumber(for: "079 555 01 23", normalizer: { _ in "+41795550123" })
+
+        // when
+        sut.persist()
+
+        // then
+        let persisted = try String(contentsOf: fileURL)
+        XCTAssertFalse(persisted.contains("079 555 01 23"))
+    }
+
+    func testThatItEvictsEntriesWhenFull() {
+        // given
+        let sut = PhoneNumberNormalizationCache(fileURL: nil, maximumCount: 8)
+
+        // when
+        for number in 0..<20 {
+            _ = sut.normalizedNumber(for: "\(number)", normalizer: { $0 })
+        }
+
+        // then
+        XCTAssertLessThanOrEqual(sut.count, 8)
+        XCTAssertGreaterThan(sut.count, 0)
+    }
+
+    func testThatItDeletesThePersistedEntries() {
+        // given
+        let sut = PhoneNumberNormalizationCache(fileURL: fileURL)
+        _ = sut.normalizedNumber(for: "123", normalizer: { _ in "+41123" })
+        sut.persist()
+
+        // when
+        sut.delete()
+
+        // then
+        XCTAssertEqual(sut.count, 0)
+        XCTAssertFalse(FileManager.default.fileExists(atPath: fileURL.path))
+    }
+
+}
@@ -42,13 +42,15 @@ class APIVersionResolverTests: ZMTBaseTest {
     private func createSUT(
         clientProdVersions: Set<APIVersion>,
         clientDevVersions: Set<APIVersion>,
-        isDeveloperModeEnabled: Bool = false
+        isDeveloperModeEnabled: Bool = false,
+        cache: APIVersionCache? = nil
     ) -> APIVersionResolver {
         let sut = APIVersionResolver(
             clientProdVersions: clientProdVersions,
             clientDevVersions: clientDevVersions,
             transportSession: transportSession,
-            isDeveloperModeEnabled: isDeveloperModeEnabled
+            isDeveloperModeEnabled: isDeveloperModeEnabled,
+            cache: cache
         )
 
         sut.delegate = mockDelegate
@@ -71,6 +73,23 @@ class APIVersionResolverTests: ZMTBaseTest {
         transportSession.federation = isFederationEnabled
     }
 
+    private func createCache(supportedVersions: [Int32], cachedAt date: Date) -> APIVersionCache {
+        let cache = APIVersionCache(
+            userDefaults: UserDefaults(suiteName: UUID().uuidString)!,
+            backendURL: URL(string: "https://example.com")!
+        )
+
+        let payload: [String: Any] = ["supported": supportedVersions, "federation": false, "domain": "foo.com"]
+        cache.entry = APIVersionCache.Entry(
+            payload: try! JSONSerialization.data(withJSONObject: payload),
+            entityTag: "\"1\"",
+            lastModified: nil,
+            date: date
+        )
+
+        return cache
+    }
+
     // MARK: - Endpoint unavailable
 
     func testThatItDefaultsToVersionZeroIfEndpointIsUnavailable() throws {
@@ -365,6 +384,146 @@ class APIVersionResolverTests: ZMTBaseTest {
         XCTAssertTrue(mockDelegate.didReportFederationHasBeenEnabled)
     }
 
+    // MARK: - Cache
+
+    func testThatItCompletesWithoutWaitingForTheBackend_WhenTheCachedResponseIsFresh() {
+        // Given a version was resolved from a recent response.
+        setCurrentAPIVersion(.v1)
+        let cache = createCache(supportedVersions: [0, 1], cachedAt: Date())
+        let sut = createSUT(clientProdVersions: [.v0, .v1], clientDevVersions: [], cache: cache)
+
+        mockBackendInfo(
+            productionVersions: 0...1,
+            developmentVersions: nil,
+            domain: "foo.com",
+            isFederationEnabled: false
+        )
+
+        // When version is resolved.
+        let done = expectation(description: "done")
+        var didResolveBeforeCompletion = true
+        sut.resolveAPIVersion(completion: { _ in
+            didResolveBeforeCompletion = self.mockDelegate.didReportAPIVersionHasBeenResolved
+            done.fulfill()
+        })
+        XCTAssertTrue(waitForCustomExpectations(withTimeout: 0.5))
+        XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // Then it completed before the response was revalidated.
+        XCTAssertFalse(didResolveBeforeCompletion)
+        XCTAssertTrue(mockDelegate.didReportAPIVersionHasBeenResolved)
+        XCTAssertEqual(BackendInfo.apiVersion, .v1)
+    }
+
+    func testThatItWaitsForTheBackend_WhenTheCachedResponseIsStale() {
+        // Given a version was resolved from an old response.
+        setCurrentAPIVersion(.v1)
+        let cache = createCache(supportedVersions: [0, 1], cachedAt: Date(timeIntervalSinceNow: -APIVersionResolver.cacheMaxAge))
+        let sut = createSUT(clientProdVersions: [.v0, .v1], clientDevVersions: [], cache: cache)
+
+        mockBackendInfo(
+            productionVersions: 0...1,
+            developmentVersions: nil,
+            domain: "foo.com",
+            isFederationEnabled: false
+        )
+
+        // When version is resolved.
+        let done = expectation(description: "done")
+        var didResolveBeforeCompletion = false
+        sut.resolveAPIVersion(completion: { _ in
+            didResolveBeforeCompletion = self.mockDelegate.didReportAPIVersionHasBeenResolved
+            done.fulfill()
+        })
+        XCTAssertTrue(waitForCustomExpectations(withTimeout: 0.5))
+
+        // Then it completed after the response was received.
+        XCTAssertTrue(didResolveBeforeCompletion)
+        XCTAssertTrue(cache.entry!.isFresh(maxAge: APIVersionResolver.cacheMaxAge))
+    }
+
+    func testThatItReportsBlacklistReason_WhenTheRevalidatedResponseChanged() {
+        // Given a version was resolved from a recent response.
+        setCurrentAPIVersion(.v1)
+        let cache = createCache(supportedVersions: [1], cachedAt: Date())
+        let sut = createSUT(clientProdVersions: [.v1], clientDevVersions: [], cache: cache)
+
+        // Given backend no longer supports v1.
+        mockBackendInfo(
+            productionVersions: 2...2,
+            developmentVersions: nil,
+            domain: "foo.com",
+            isFederationEnabled: false
+        )
+
+        // When version is resolved.
+        let done = expectation(description: "done")
+        sut.resolveAPIVersion(completion: { _ in done.fulfill() })
+        XCTAssertTrue(waitForCustomExpectations(withTimeout: 0.5))
+        XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // Then the blacklist reason is reported once the response is revalidated.
+        XCTAssertNil(BackendInfo.apiVersion)
+        XCTAssertEqual(mockDelegate.blacklistReason, .clientAPIVersionObsolete)
+    }
+
+    func testThatItCachesTheResponse() throws {
+        // Given there is no cached response.
+        let cache = APIVersionCache(userDefaults: UserDefaults(suiteName: UUID().uuidString)!, backendURL: URL(string: "https://example.com")!)
+        let sut = createSUT(clientProdVersions: [.v0, .v1], clientDevVersions: [], cache: cache)
+
+        mockBackendInfo(
+            productionVersions: 0...1,
+            developmentVersions: nil,
+            domain: "foo.com",
+            isFederationEnabled: false
+        )
+
+        // When version is resolved.
+        let done = expectation(description: "done")
+        sut.resolveAPIVersion(completion: { _ in done.fulfill() })
+        XCTAssertTrue(waitForCustomExpectations(withTimeout: 0.5))
+
+        // Then the response is cached.
+        let entry = try XCTUnwrap(cache.entry)
+        XCTAssertTrue(entry.isFresh(maxAge: APIVersionResolver.cacheMaxAge))
+    }
+
+    // MARK: - Performance
+
+    func testPerformanceOfTheFirstResolution_WithoutCachedResponse() {
+        mockBackendInfo(productionVersions: 0...1, developmentVersions: nil, domain: "foo.com", isFederationEnabled: false)
+
+        measure {
+            // Given
+            setCurrentAPIVersion(nil)
+            let sut = createSUT(clientProdVersions: [.v0, .v1], clientDevVersions: [])
+
+            // When
+            let done = expectation(description: "done")
+            sut.resolveAPIVersion(completion: { _ in done.fulfill() })
+            XCTAssertTrue(waitForCustomExpectations(withTimeout: 0.5))
+        }
+    }
+
+    func testPerformanceOfTheFirstResolution_WithFreshCachedResponse() {
+        mockBackendInfo(productionVersions: 0...1, developmentVersions: nil, domain: "foo.com", isFederationEnabled: false)
+
+        measure {
+            // Given
+            setCurrentAPIVersion(.v1)
+            let cache = createCache(supportedVersions: [0, 1], cachedAt: Date())
+            let sut = createSUT(clientProdVersions: [.v0, .v1], clientDevVersions: [], cache: cache)
+
+            // When
+            let done = expectation(description: "done")
+            sut.resolveAPIVersion(completion: { _ in done.fulfill() })
+            XCTAssertTrue(waitForCustomExpectations(withTimeout: 0.5))
+        }
+
+        XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+    }
+
 }
 
 // MARK: - Mocks
@@ -0,0 +1,199 @@
+//
+// Wire
+// Copyright (C) 2022 Wire Swiss GmbH
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see http://www.gnu.org/licenses/.
+//
+
+import XCTest
+@testable import WireSyncEngine
+
+class MessageRetentionPurgerTests: MessagingTest {
+
+    var conversation: ZMConversation!
+    let cutoff = Date(timeIntervalSinceReferenceDate: 100_000)
+
+    override func setUp() {
+        super.setUp()
+
+        syncMOC.performGroupedBlockAndWait {
+            self.conversation = ZMConversation.insertNewObject(in: self.syncMOC)
+            self.conversation.remoteIdentifier = UUID()
+            self.conversation.conversationType = .group
+        }
+    }
+
+    override func tearDown() {
+        conversation = nil
+        super.tearDown()
+    }
+
+    // MARK: - Helpers
+
+    /// Inserts messages with a server timestamp one second apart, starting at `date`
+    func insertMessages(count: Int, startingAt date: Date) {
+        for index in 0..<count {
+            let message = try! conversation.appendText(content: "Hello \(index)") as! ZMMessage
+            message.serverTimestamp = date.addingTimeInterval(TimeInterval(index))
+        }
+
+        syncMOC.saveOrRollback()
+    }
+
+    func numberOfMessages() -> Int {
+        let fetchRequest = NSFetchRequest<ZMMessage>(entityName: ZMMessage.entityName())
+        return try! syncMOC.count(for: fetchRequest)
+    }
+
+    func deleteMessages(with purger: MessageRetentionPurger, olderThan cutoff: Date? = nil) -> MessageRetentionPurgeStatistics? {
+        var statistics: MessageRetentionPurgeStatistics?
+        purger.deleteMessages(olderThan: cutoff ?? self.cutoff) { statistics = $0 }
+        XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+        return statistics
+    }
+
+    // MARK: - Tests
+
+    func testThatItDeletesTheMessagesOlderThanTheCutoffInBatches() {
+        // given
+        syncMOC.performGroupedBlockAndWait {
+            self.insertMessages(count: 25, startingAt: self.cutoff.addingTimeInterval(-100))
+            self.insertMessages(count: 5, startingAt: self.cutoff)
+        }
+
+        // when
+        let statistics = deleteMessages(with: MessageRetentionPurger(context: syncMOC, batchSize: 10))
+
+        // then
+        syncMOC.performGroupedBlockAndWait {
+            XCTAssertEqual(self.numberOfMessages(), 5)
+        }
+        XCTAssertEqual(statistics?.numberOfBatches, 3)
+        XCTAssertEqual(statistics?.numberOfDeletedMessages, 25)
+    }
+
+    func testThatItDeletesMessagesWithTheSameTimestamp_WhenThereAreMoreThanABatch() {
+        // given
+        syncMOC.performGroupedBlockAndWait {
+            for _ in 0..<3 {
+                self.insertMessages(count: 1, startingAt: self.cutoff.addingTimeInterval(-100))
+            }
+        }
+
+        // when
+        let statistics = deleteMessages(with: MessageRetentionPurger(context: syncMOC, batchSize: 2))
+
+        // then
+        syncMOC.performGroupedBlockAndWait {
+            XCTAssertEqual(self.numberOfMessages(), 0)
+        }
+        XCTAssertEqual(statistics?.numberOfDeletedMessages, 3)
+    }
+
+    func testThatItLetsOtherWorkOnTheContextRunBetweenBatches() {
+        // given
+        syncMOC.performGroupedBlockAndWait {
+            self.insertMessages(count: 20, startingAt: self.cutoff.addingTimeInterval(-100))
+        }
+        let sut = MessageRetentionPurger(context: syncMOC, batchSize: 10)
+
+        // when
+        var numberOfMessagesBetweenBatches: Int?
+        sut.deleteMessages(olderThan: cutoff)
+        syncMOC.performGroupedBlock {
+            numberOfMessagesBetweenBatches = self.numberOfMessages()
+        }
+        XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // then
+        XCTAssertEqual(numberOfMessagesBetweenBatches, 10)
+        syncMOC.performGroupedBlockAndWait {
+            XCTAssertEqual(self.numberOfMessages(), 0)
+        }
+    }
+
+    func testThatItDoesNotLookForMessagesOlderThanTheLastPurge() {
+        // given
+        syncMOC.performGroupedBlockAndWait {
+            self.insertMessages(count: 20, startingAt: self.cutoff.addingTimeInterval(-100))
+        }
+        _ = deleteMessages(with: MessageRetentionPurger(context: syncMOC, batchSize: 10))
+
+        // when
+        let statistics = deleteMessages(with: MessageRetentionPurger(context: syncMOC, batchSize: 10))
+
+        // then
+        XCTAssertEqual(statistics?.numberOfBatches, 0)
+    }
+
+    func testThatItDeletesMessagesNewerThanTheLastPurge_WhenTheCutoffMoved() {
+        // given
+        syncMOC.performGroupedBlockAndWait {
+            self.insertMessages(count: 10, startingAt: self.cutoff.addingTimeInterval(-100))
+            self.insertMessages(count: 10, startingAt: self.cutoff.addingTimeInterval(10))
+        }
+        _ = deleteMessages(with: MessageRetentionPurger(context: syncMOC, batchSize: 10))
+
+        // when
+        let statistics = deleteMessages(with: MessageRetentionPurger(context: syncMOC, batchSize: 10), olderThan: cutoff.addingTimeInterval(15))
+
+        // then
+        XCTAssertEqual(statistics?.numberOfDeletedMessages, 5)
+        syncMOC.performGroupedBlockAndWait {
+            XCTAssertEqual(self.numberOfMessages(), 5)
+        }
+    }
+
+    func testThatItDeletesMessagesInsertedOlderThanTheLastPurge() {
+        // given
+        syncMOC.performGroupedBlockAndWait {
+            self.insertMessages(count: 10, startingAt: self.cutoff.addingTimeInterval(-100))
+        }
+        _ = deleteMessages(with: MessageRetentionPurger(context: syncMOC, batchSize: 10))
+
+        syncMOC.performGroupedBlockAndWait {
+            self.insertMessages(count: 5, startingAt: self.cutoff.addingTimeInterval(-1_000))
+        }
+
+        // when
+        let statistics = deleteMessages(with: MessageRetentionPurger(context: syncMOC, batchSize: 10))
+
+        // then
+        XCTAssertEqual(statistics?.numberOfDeletedMessages, 5)
+        syncMOC.performGroupedBlockAndWait {
+            XCTAssertEqual(self.numberOfMessages(), 0)
+        }
+    }
+
+    // MARK: - Performance
+
+    func testPerformanceOfDeletingMessagesInBatches() {
+        var cutoff = self.cutoff
+
+        measureMetrics([.wallClockTime], automaticallyStartMeasuring: false) {
+            // each purge only looks for messages newer than the previous one
+            cutoff.addTimeInterval(10_000)
+            syncMOC.performGroupedBlockAndWait {
+                self.insertMessages(count: 2_000, startingAt: cutoff.addingTimeInterval(-5_000))
+            }
+
+            startMeasuring()
+            let statistics = deleteMessages(with: MessageRetentionPurger(context: syncMOC, batchSize: 200), olderThan: cutoff)
+            stopMeasuring()
+
+            XCTAssertEqual(statistics?.numberOfDeletedMessages, 2_000)
+        }
+    }
+
+}
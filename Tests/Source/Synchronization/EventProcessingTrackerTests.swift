@@ -100,6 +100,29 @@ final class EventProcessingTrackerTests: XCTestCase {
         verifyIncrement(attribute: .savesPerformed)
     }
 
+    func testThatItCountsIncrementsFromMultipleThreads() {
+        // when
+        DispatchQueue.concurrentPerform(iterations: 8) { _ in
+            for _ in 0..<1000 {
+                sut.registerEventProcessed()
+            }
+        }
+
+        // then
+        let attributes = sut.persistedAttributes(for: sut.eventName)
+        XCTAssertEqual(attributes[EventProcessingTracker.Attributes.processedEvents.identifier] as? Int, 8000)
+    }
+
+    func testPerformanceOfIncrementingFromMultipleThreads() {
+        measure {
+            DispatchQueue.concurrentPerform(iterations: 8) { _ in
+                for _ in 0..<10_000 {
+                    sut.registerEventProcessed()
+                }
+            }
+        }
+    }
+
     func verifyIncrement(attribute: EventProcessingTracker.Attributes) {
         let attributes = sut.persistedAttributes(for: sut.eventName)
         XCTAssertNotNil(attributes)
@@ -0,0 +1,82 @@
+//
+// Wire
+// Copyright (C) 2022 Wire Swiss GmbH
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see http://www.gnu.org/licenses/.
+//
+
+import XCTest
+@testable import WireSyncEngine
+
+class SlowSyncFingerprintsTests: MessagingTest {
+
+    var sut: SlowSyncFingerprints!
+    let payload = Data("{\"labels\":[]}".utf8)
+
+    override func setUp() {
+        super.setUp()
+        sut = SlowSyncFingerprints(keyValueStore: syncMOC)
+    }
+
+    override func tearDown() {
+        sut = nil
+        super.tearDown()
+    }
+
+    func testThatAPayloadIsChanged_WhenNothingWasApplied() {
+        syncMOC.performGroupedBlockAndWait {
+            XCTAssertFalse(self.sut.isUnchanged(self.payload, for: .labels))
+        }
+    }
+
+    func testThatTheSamePayloadIsUnchanged_AfterItWasApplied() {
+        syncMOC.performGroupedBlockAndWait {
+            // when
+            self.sut.update(self.payload, for: .labels)
+
+            // then
+            XCTAssertTrue(self.sut.isUnchanged(self.payload, for: .labels))
+            XCTAssertFalse(self.sut.isUnchanged(Data("{\"labels\":[{}]}".utf8), for: .labels))
+            XCTAssertFalse(self.sut.isUnchanged(self.payload, for: .teamMembers))
+        }
+    }
+
+    func testThatAPayloadIsChanged_AfterTheResourceWasInvalidated() {
+        syncMOC.performGroupedBlockAndWait {
+            // given
+            self.sut.update(self.payload, for: .labels)
+
+            // when
+            self.sut.invalidate(.labels)
+
+            // then
+            XCTAssertFalse(self.sut.isUnchanged(self.payload, for: .labels))
+        }
+    }
+
+    func testThatTheFingerprintsArePersistedInTheStore() {
+        syncMOC.performGroupedBlockAndWait {
+            // given
+            self.sut.update(self.payload, for: .teamRoles)
+            self.syncMOC.saveOrRollback()
+
+            // when
+            let fingerprints = SlowSyncFingerprints(keyValueStore: self.syncMOC)
+
+            // then
+            XCTAssertTrue(fingerprints.isUnchanged(self.payload, for: .teamRoles))
+        }
+    }
+
+}
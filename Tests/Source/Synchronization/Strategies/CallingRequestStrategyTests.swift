@@ -258,6 +258,186 @@ class CallingRequestStrategyTests: MessagingTest {
         XCTAssertNil(secondRequest)
     }
 
+    func testThatItAnswersClientListRequestsFromTheCache() {
+        // Given
+        createSelfClient()
+        let conversationId = AVSIdentifier(identifier: UUID(), domain: nil)
+        let client = AVSClient(userId: AVSIdentifier(identifier: UUID(), domain: nil), clientId: "client1")
+        discoverClients([client], in: conversationId)
+
+        var receivedClients: [AVSClient]?
+
+        // When
+        sut.requestClientsList(conversationId: conversationId) { receivedClients = $0 }
+        XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // Then
+        XCTAssertEqual(receivedClients, [client])
+        XCTAssertNil(sut.nextRequest(for: .v0))
+        XCTAssertEqual(sut.clientDiscoveryQueue.statistics.cacheHitCount, 1)
+    }
+
+    func testThatItDoesNotShareCachedClientListsBetweenDomains() {
+        // Given
+        BackendInfo.isFederationEnabled = true
+        defer { BackendInfo.isFederationEnabled = false }
+
+        createSelfClient()
+        let uuid = UUID()
+        let conversationId = AVSIdentifier(identifier: uuid, domain: "a.example.com")
+        let otherConversationId = AVSIdentifier(identifier: uuid, domain: "b.example.com")
+        let client = AVSClient(userId: AVSIdentifier(identifier: UUID(), domain: "a.example.com"), clientId: "client1")
+        discoverClients([client], in: conversationId)
+
+        // When
+        sut.requestClientsList(conversationId: otherConversationId) { _ in }
+        XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // Then
+        XCTAssertNotNil(sut.nextRequest(for: .v0))
+        XCTAssertEqual(sut.clientDiscoveryQueue.statistics.cacheHitCount, 0)
+        XCTAssertEqual(sut.clientDiscoveryQueue.statistics.requestCount, 2)
+    }
+
+    func testThatItMergesClientListRequestsForTheSameConversation() {
+        // Given
+        createSelfClient()
+        let conversationId = AVSIdentifier(identifier: UUID(), domain: nil)
+        let client = AVSClient(userId: AVSIdentifier(identifier: UUID(), domain: nil), clientId: "client1")
+
+        let firstCompletion = expectation(description: "First completion")
+        let secondCompletion = expectation(description: "Second completion")
+
+        // When
+        sut.requestClientsList(conversationId: conversationId) { _ in firstCompletion.fulfill() }
+        sut.requestClientsList(conversationId: conversationId) { _ in secondCompletion.fulfill() }
+        XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        let request = sut.nextRequest(for: .v0)
+        XCTAssertNil(sut.nextRequest(for: .v0))
+        request?.complete(with: clientDiscoveryResponse(clients: [client]))
+
+        // Then
+        XCTAssertTrue(waitForCustomExpectations(withTimeout: 0.5))
+        XCTAssertEqual(sut.clientDiscoveryQueue.statistics.mergedRequestCount, 1)
+    }
+
+    func testThatItQueuesClientListRequestsForDifferentConversations() {
+        // Given
+        createSelfClient()
+        let conversationId1 = AVSIdentifier(identifier: UUID(), domain: nil)
+        let conversationId2 = AVSIdentifier(identifier: UUID(), domain: nil)
+
+        sut.requestClientsList(conversationId: conversationId1) { _ in }
+        sut.requestClientsList(conversationId: conversationId2) { _ in }
+        XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // When
+        let firstRequest = sut.nextRequest(for: .v0)
+        firstRequest?.complete(with: clientDiscoveryResponse(clients: []))
+        XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+        let secondRequest = sut.nextRequest(for: .v0)
+
+        // Then
+        XCTAssertEqual(firstRequest?.path, "/conversations/\(conversationId1.identifier.transportString())/otr/messages")
+        XCTAssertEqual(secondRequest?.path, "/conversations/\(conversationId2.identifier.transportString())/otr/messages")
+    }
+
+    func testThatItInvalidatesTheCachedClientList_WhenAMemberJoins() {
+        // Given
+        createSelfClient()
+        let conversationId = AVSIdentifier(identifier: UUID(), domain: nil)
+        discoverClients([], in: conversationId)
+
+        let payload: [String: Any] = [
+            "conversation": conversationId.identifier.transportString(),
+            "data": ["user_ids": [UUID().transportString()]],
+            "from": UUID().transportString(),
+            "time": Date().transportString(),
+            "type": "conversation.member-join"
+        ]
+        let event = ZMUpdateEvent(fromEventStreamPayload: payload as ZMTransportData, uuid: nil)!
+
+        // When
+        syncMOC.performGroupedBlockAndWait {
+            self.sut.processEvents([event], liveEvents: true, prefetchResult: nil)
+        }
+        sut.requestClientsList(conversationId: conversationId) { _ in }
+        XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // Then
+        XCTAssertNotNil(sut.nextRequest(for: .v0))
+    }
+
+    func testThatItInvalidatesTheCachedClientList_WhenACallStarts() {
+        // Given
+        createSelfClient()
+        let conversationId = AVSIdentifier(identifier: UUID(), domain: nil)
+        discoverClients([], in: conversationId)
+
+        let json = ["src_userid": UUID.create().uuidString,
+                    "sessid": "session1",
+                    "resp": false,
+                    "type": "SETUP"] as [String: Any]
+        let data = try! JSONSerialization.data(withJSONObject: json, options: [])
+        let message = GenericMessage(content: Calling(content: String(data: data, encoding: .utf8)!))
+        let payload = [
+            "conversation": conversationId.identifier.transportString(),
+            "data": [
+                "sender": UUID().transportString(),
+                "text": try? message.serializedData().base64String()
+            ],
+            "from": UUID().transportString(),
+            "time": Date().transportString(),
+            "type": "conversation.otr-message-add"
+        ] as [String: Any]
+        let event = ZMUpdateEvent(fromEventStreamPayload: payload as ZMTransportData, uuid: UUID())!
+
+        // When
+        syncMOC.performGroupedBlockAndWait {
+            self.sut.processEvents([event], liveEvents: true, prefetchResult: nil)
+        }
+        sut.requestClientsList(conversationId: conversationId) { _ in }
+        XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // Then
+        XCTAssertNotNil(sut.nextRequest(for: .v0))
+        XCTAssertEqual(sut.clientDiscoveryQueue.statistics.cacheHitCount, 0)
+    }
+
+    func testPerformanceOfRequestingCachedClientLists() {
+        // Given
+        createSelfClient()
+        let conversationId = AVSIdentifier(identifier: UUID(), domain: nil)
+        let clients = (0..<100).map { AVSClient(userId: AVSIdentifier(identifier: UUID(), domain: nil), clientId: "client\($0)") }
+        discoverClients(clients, in: conversationId)
+
+        // Then
+        measure {
+            for _ in 0..<100 {
+                sut.requestClientsList(conversationId: conversationId) { _ in }
+            }
+            XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+        }
+    }
+
+    private func clientDiscoveryResponse(clients: [AVSClient]) -> ZMTransportResponse {
+        let missing = Dictionary(grouping: clients, by: { $0.avsIdentifier.identifier.transportString() })
+            .mapValues { $0.map(\.clientId) }
+
+        return ZMTransportResponse(payload: ["missing": missing] as ZMTransportData,
+                                   httpStatus: 412,
+                                   transportSessionError: nil,
+                                   apiVersion: APIVersion.v0.rawValue)
+    }
+
+    private func discoverClients(_ clients: [AVSClient], in conversationId: AVSIdentifier) {
+        sut.requestClientsList(conversationId: conversationId) { _ in }
+        XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+        sut.nextRequest(for: .v0)?.complete(with: clientDiscoveryResponse(clients: clients))
+        XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+    }
+
     // MARK: - Targeted Calling Messages
 
     func testThatItTargetsCallMessagesIfTargetClientsAreSpecified() {
@@ -403,6 +583,147 @@ class CallingRequestStrategyTests: MessagingTest {
         XCTAssertEqual(Set(recipient2.clients.map(\.client)), Set([client3, client4].map(\.clientId)))
     }
 
+    func testThatItTargetsConsecutiveCallMessagesToTheSameClients() {
+        // Given
+        let selfClient = createSelfClient()
+
+        let user = ZMUser.insertNewObject(in: syncMOC)
+        user.remoteIdentifier = .create()
+        let client = createClient(for: user, connectedTo: selfClient)
+        createClient(for: user, connectedTo: selfClient)
+
+        let conversation = ZMConversation.insertNewObject(in: syncMOC)
+        conversation.remoteIdentifier = .create()
+        conversation.addParticipantsAndUpdateConversationState(users: [ZMUser.selfUser(in: syncMOC), user], role: nil)
+        conversation.needsToBeUpdatedFromBackend = false
+
+        syncMOC.saveOrRollback()
+
+        let targets = [AVSClient(userId: user.avsIdentifier, clientId: client.remoteIdentifier!)]
+
+        for _ in 0..<2 {
+            // When
+            var nextRequest: ZMTransportRequest?
+
+            syncMOC.performGroupedBlock {
+                self.sut.send(data: Data(), conversationId: conversation.avsIdentifier!, targets: targets) { _ in }
+            }
+            XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+            syncMOC.performGroupedBlock {
+                nextRequest = self.sut.nextRequest(for: .v0)
+            }
+            XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+            // Then
+            guard
+                let data = nextRequest?.binaryData,
+                let otrMessage = try? Proteus_NewOtrMessage(serializedData: data)
+            else {
+                return XCTFail("Expected OTR message")
+            }
+
+            XCTAssertEqual(otrMessage.recipients.count, 1)
+            XCTAssertEqual(otrMessage.recipients.first?.clients.map(\.client), [client.clientId])
+
+            nextRequest?.complete(with: messageSentResponse())
+            XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+        }
+
+        syncMOC.performGroupedBlockAndWait {
+            XCTAssertEqual(self.sut.callingMessageSchedulingStatistics.messageCount, 2)
+            XCTAssertNotNil(self.sut.callingMessageSchedulingStatistics.averageLatency)
+        }
+    }
+
+    func testThatItDoesNotTargetTheClientOfAnotherUserWithTheSameIdentifier() {
+        // Given
+        let selfClient = createSelfClient()
+
+        let user = ZMUser.insertNewObject(in: syncMOC)
+        user.remoteIdentifier = .create()
+        let otherUser = ZMUser.insertNewObject(in: syncMOC)
+        otherUser.remoteIdentifier = .create()
+        let client = createClient(for: user, connectedTo: selfClient)
+
+        let conversation = ZMConversation.insertNewObject(in: syncMOC)
+        conversation.remoteIdentifier = .create()
+        conversation.addParticipantsAndUpdateConversationState(users: [ZMUser.selfUser(in: syncMOC), user, otherUser], role: nil)
+        conversation.needsToBeUpdatedFromBackend = false
+
+        syncMOC.saveOrRollback()
+
+        // the target is a client of the other user, which isn't known locally
+        let targets = [AVSClient(userId: otherUser.avsIdentifier, clientId: client.remoteIdentifier!)]
+
+        // When
+        var nextRequest: ZMTransportRequest?
+
+        syncMOC.performGroupedBlock {
+            self.sut.send(data: Data(), conversationId: conversation.avsIdentifier!, targets: targets) { _ in }
+        }
+        XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        syncMOC.performGroupedBlock {
+            nextRequest = self.sut.nextRequest(for: .v0)
+        }
+        XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // Then
+        let otrMessage = nextRequest?.binaryData.flatMap { try? Proteus_NewOtrMessage(serializedData: $0) }
+        XCTAssertFalse(otrMessage?.recipients.contains { $0.user == user.userId } ?? false)
+    }
+
+    func testPerformanceOfSchedulingTargetedCallMessages() {
+        // Given
+        let selfClient = createSelfClient()
+
+        let users: [ZMUser] = (0..<20).map { _ in
+            let user = ZMUser.insertNewObject(in: syncMOC)
+            user.remoteIdentifier = .create()
+            return user
+        }
+        let targets = users.map { user in
+            AVSClient(userId: user.avsIdentifier, clientId: createClient(for: user, connectedTo: selfClient).remoteIdentifier!)
+        }
+
+        let conversation = ZMConversation.insertNewObject(in: syncMOC)
+        conversation.remoteIdentifier = .create()
+        conversation.addParticipantsAndUpdateConversationState(users: [ZMUser.selfUser(in: syncMOC)] + users, role: nil)
+        conversation.needsToBeUpdatedFromBackend = false
+
+        syncMOC.saveOrRollback()
+
+        // Then measure the time from AVS sending a message to the request being created
+        measure {
+            for _ in 0..<10 {
+                sut.send(data: Data(), conversationId: conversation.avsIdentifier!, targets: targets) { _ in }
+                XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+                syncMOC.performGroupedBlockAndWait {
+                    let request = self.sut.nextRequest(for: .v0)
+                    XCTAssertNotNil(request)
+                    request?.complete(with: self.messageSentResponse())
+                }
+                XCTAssertTrue(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+            }
+        }
+    }
+
+    private func messageSentResponse() -> ZMTransportResponse {
+        let payload: [String: Any] = [
+            "time": Date().transportString(),
+            "missing": [:],
+            "redundant": [:],
+            "deleted": [:]
+        ]
+
+        return ZMTransportResponse(payload: payload as ZMTransportData,
+                                   httpStatus: 201,
+                                   transportSessionError: nil,
+                                   apiVersion: APIVersion.v0.rawValue)
+    }
+
     @discardableResult
     private func createClient(for user: ZMUser, connectedTo userClient: UserClient) -> UserClient {
         let client = UserClient.insertNewObject(in: syncMOC)
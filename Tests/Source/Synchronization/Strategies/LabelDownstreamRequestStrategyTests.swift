@@ -184,6 +184,116 @@ class LabelDownstreamRequestStrategyTests: MessagingTest {
         }
     }
 
+    // MARK: - Delta Slow Sync
+
+    func performSlowSync(with labels: WireSyncEngine.LabelPayload) -> SyncPhaseTimeline.Entry? {
+        syncMOC.performGroupedBlockAndWait {
+            self.mockSyncStatus.forceSlowSync()
+            self.mockSyncStatus.mockPhase = .fetchingLabels
+            guard let request = self.sut.nextRequest(for: .v0) else { return XCTFail() }
+
+            let data = try! JSONEncoder().encode(labels)
+            let urlResponse = HTTPURLResponse(url: URL(string: "properties/labels")!, statusCode: 200, httpVersion: nil, headerFields: nil)!
+            request.complete(with: ZMTransportResponse(httpurlResponse: urlResponse, data: data, error: nil, apiVersion: APIVersion.v0.rawValue))
+        }
+        XCTAssertTrue(self.waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        var entry: SyncPhaseTimeline.Entry?
+        syncMOC.performGroupedBlockAndWait {
+            entry = self.mockSyncStatus.slowSyncTimeline.entry(for: .fetchingLabels)
+        }
+        return entry
+    }
+
+    func testThatItDoesNotApplyUnchangedLabels_OnNextSlowSync() {
+        // GIVEN
+        let labels = folderResponse(name: "folder", conversations: [conversation1.remoteIdentifier!])
+        let fullSync = performSlowSync(with: labels)
+
+        // WHEN
+        let deltaSync = performSlowSync(with: labels)
+
+        // THEN
+        XCTAssertEqual(fullSync?.objectsWritten, 1)
+        XCTAssertEqual(fullSync?.unchangedPayloads, 0)
+        XCTAssertEqual(deltaSync?.bytesReceived, fullSync?.bytesReceived)
+        XCTAssertEqual(deltaSync?.objectsWritten, 0)
+        XCTAssertEqual(deltaSync?.unchangedPayloads, 1)
+        XCTAssertTrue(mockSyncStatus.didCallFinishCurrentSyncPhase)
+    }
+
+    func testThatItAppliesChangedLabels_OnNextSlowSync() {
+        // GIVEN
+        let identifier = UUID()
+        _ = performSlowSync(with: folderResponse(identifier: identifier, name: "folder", conversations: []))
+
+        // WHEN
+        let deltaSync = performSlowSync(with: folderResponse(identifier: identifier, name: "renamed", conversations: []))
+
+        // THEN
+        XCTAssertEqual(deltaSync?.objectsWritten, 1)
+        syncMOC.performGroupedBlockAndWait {
+            var created = false
+            let label = Label.fetchOrCreate(remoteIdentifier: identifier, create: false, in: self.syncMOC, created: &created)
+            XCTAssertEqual(label?.name, "renamed")
+        }
+    }
+
+    func testThatItAppliesUnchangedLabels_AfterLabelsWereUpdatedByAnEvent() {
+        // GIVEN
+        let labels = folderResponse(name: "folder", conversations: [])
+        _ = performSlowSync(with: labels)
+
+        syncMOC.performGroupedBlockAndWait {
+            let event = self.updateEvent(with: self.favoriteResponse(favorites: [self.conversation1.remoteIdentifier!]))
+            self.sut.processEvents([event], liveEvents: true, prefetchResult: nil)
+        }
+
+        // WHEN
+        let deltaSync = performSlowSync(with: labels)
+
+        // THEN
+        XCTAssertEqual(deltaSync?.objectsWritten, 1)
+        XCTAssertEqual(deltaSync?.unchangedPayloads, 0)
+    }
+
+    func testThatItAppliesUnchangedLabels_WhenRefetchingIsNecessary() {
+        // GIVEN
+        let labels = folderResponse(name: "folder", conversations: [])
+        _ = performSlowSync(with: labels)
+
+        syncMOC.performGroupedBlockAndWait {
+            ZMUser.selfUser(in: self.syncMOC).needsToRefetchLabels = true
+        }
+
+        // WHEN
+        let deltaSync = performSlowSync(with: labels)
+
+        // THEN
+        XCTAssertEqual(deltaSync?.unchangedPayloads, 0)
+        XCTAssertEqual(deltaSync?.objectsWritten, 0)
+    }
+
+    func testThatItOnlyCountsTheLabelsWhichChanged() {
+        // GIVEN
+        let folderIdentifier = UUID()
+
+        syncMOC.performGroupedBlockAndWait {
+            self.sut.update(with: self.folderResponse(identifier: folderIdentifier, name: "folder", conversations: [self.conversation1.remoteIdentifier!]))
+            self.syncMOC.saveOrRollback()
+        }
+
+        syncMOC.performGroupedBlockAndWait {
+            // WHEN
+            let unchanged = self.sut.update(with: self.folderResponse(identifier: folderIdentifier, name: "folder", conversations: [self.conversation1.remoteIdentifier!]))
+            let moved = self.sut.update(with: self.folderResponse(identifier: folderIdentifier, name: "folder", conversations: [self.conversation2.remoteIdentifier!]))
+
+            // THEN
+            XCTAssertEqual(unchanged, 0)
+            XCTAssertEqual(moved, 1)
+        }
+    }
+
     // MARK: - Event Processing
 
     func testThatItUpdatesLabels_OnPropertiesUpdateEvent() {
@@ -336,4 +446,70 @@ class LabelDownstreamRequestStrategyTests: MessagingTest {
         }
     }
 
+    func testThatItDoesNotSaveTheContext_WhenDeletingLabels() {
+        syncMOC.performGroupedBlockAndWait {
+            // GIVEN
+            var created = false
+            let label = Label.fetchOrCreate(remoteIdentifier: UUID(), create: true, in: self.syncMOC, created: &created)!
+            label.name = "Folder A"
+            self.syncMOC.saveOrRollback()
+
+            // WHEN
+            self.sut.update(with: self.folderResponse(name: "Folder B", conversations: []))
+
+            // THEN
+            XCTAssertTrue(label.isDeleted)
+            XCTAssertTrue(self.syncMOC.deletedObjects.contains(label))
+        }
+    }
+
+    func testThatItDoesNotModifyLabels_WhenTheyDidNotChange() {
+        let folderIdentifier = UUID()
+
+        syncMOC.performGroupedBlockAndWait {
+            // GIVEN
+            var created = false
+            let label = Label.fetchOrCreate(remoteIdentifier: folderIdentifier, create: true, in: self.syncMOC, created: &created)
+            label?.name = "Folder A"
+            label?.conversations = Set([self.conversation1, self.conversation2])
+            self.syncMOC.saveOrRollback()
+
+            // WHEN
+            self.sut.update(with: self.folderResponse(identifier: folderIdentifier,
+                                                      name: "Folder A",
+                                                      conversations: [self.conversation2.remoteIdentifier!, self.conversation1.remoteIdentifier!]))
+
+            // THEN
+            XCTAssertFalse(self.syncMOC.hasChanges)
+        }
+    }
+
+    func testPerformanceOfUpdatingManyLabels() {
+        var labels: WireSyncEngine.LabelPayload!
+
+        syncMOC.performGroupedBlockAndWait {
+            let conversations: [ZMConversation] = (0..<500).map { _ in
+                let conversation = ZMConversation.insertNewObject(in: self.syncMOC)
+                conversation.remoteIdentifier = UUID()
+                return conversation
+            }
+            let conversationIDs = conversations.compactMap(\.remoteIdentifier)
+
+            let folders = (0..<200).map { index in
+                WireSyncEngine.LabelUpdate(id: UUID(), type: Label.Kind.folder.rawValue, name: "Folder \(index)", conversations: Array(conversationIDs.shuffled().prefix(20)))
+            }
+            let favorites = WireSyncEngine.LabelUpdate(id: UUID(), type: Label.Kind.favorite.rawValue, name: "", conversations: Array(conversationIDs.prefix(100)))
+            labels = WireSyncEngine.LabelPayload(labels: folders + [favorites])
+
+            self.sut.update(with: labels)
+            self.syncMOC.saveOrRollback()
+        }
+
+        measure {
+            self.syncMOC.performGroupedBlockAndWait {
+                self.sut.update(with: labels)
+            }
+        }
+    }
+
 }
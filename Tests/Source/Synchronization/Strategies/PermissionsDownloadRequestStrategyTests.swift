@@ -172,6 +172,106 @@ class PermissionsDownloadRequestStrategyTests: MessagingTest {
         }
     }
 
+    func testThatItCoalescesMembersOfATeamIntoOneListRequest() {
+        syncMOC.performGroupedBlockAndWait {
+            // given
+            self.mockApplicationStatus.mockSynchronizationState = .online
+            let teamId = UUID.create()
+            let team = Team.insertNewObject(in: self.syncMOC)
+            team.remoteIdentifier = teamId
+            let members = (0..<3).map { _ in self.createMember(in: team) }
+
+            // when
+            self.boostrapChangeTrackers(with: members)
+
+            // then
+            guard let request = self.sut.nextRequest(for: .v0) else { return XCTFail("No request generated") }
+            XCTAssertEqual(request.method, .methodPOST)
+            XCTAssertEqual(request.path, "/teams/\(teamId.transportString())/get-members-by-ids-using-post")
+
+            let userIDs = (request.payload as? [String: Any])?["user_ids"] as? [String]
+            XCTAssertEqual(Set(userIDs ?? []), Set(members.compactMap { $0.remoteIdentifier?.transportString() }))
+            XCTAssertNil(self.sut.nextRequest(for: .v0))
+        }
+    }
+
+    func testThatItUpdatesTheMembersWithTheListResponse_AndDeletesTheMissingOnes() {
+        var team: Team!
+        var updatedMember: Member!
+        var missingUserID: UUID!
+
+        syncMOC.performGroupedBlock {
+            // given
+            self.mockApplicationStatus.mockSynchronizationState = .online
+            team = Team.insertNewObject(in: self.syncMOC)
+            team.remoteIdentifier = .create()
+            updatedMember = self.createMember(in: team)
+            let missingMember = self.createMember(in: team)
+            missingUserID = missingMember.remoteIdentifier
+
+            self.boostrapChangeTrackers(with: [updatedMember, missingMember])
+            guard let request = self.sut.nextRequest(for: .v0) else { return XCTFail("No request generated") }
+
+            let payload: [String: Any] = [
+                "hasMore": false,
+                "members": [
+                    [
+                        "user": updatedMember.remoteIdentifier!.transportString(),
+                        "permissions": ["self": 17, "copy": 0]
+                    ]
+                ]
+            ]
+
+            let response = ZMTransportResponse(payload: payload as ZMTransportData, httpStatus: 200, transportSessionError: nil, apiVersion: APIVersion.v0.rawValue)
+
+            // when
+            request.complete(with: response)
+        }
+
+        XCTAssert(waitForAllGroupsToBeEmpty(withTimeout: 0.2))
+
+        syncMOC.performGroupedBlockAndWait {
+            // then
+            XCTAssertFalse(updatedMember.needsToBeUpdatedFromBackend)
+            XCTAssertEqual(updatedMember.permissions, [.createConversation, .addRemoveConversationMember])
+            XCTAssertNil(Member.fetch(with: missingUserID, in: self.syncMOC))
+            XCTAssertNil(self.sut.nextRequestIfAllowed(for: .v0))
+        }
+    }
+
+    func testThatItFetchesTheMembersOneByOne_WhenTheListRequestFailsPermanently() {
+        var members: [Member]!
+
+        syncMOC.performGroupedBlock {
+            // given
+            self.mockApplicationStatus.mockSynchronizationState = .online
+            let team = Team.insertNewObject(in: self.syncMOC)
+            team.remoteIdentifier = .create()
+            members = (0..<2).map { _ in self.createMember(in: team) }
+
+            self.boostrapChangeTrackers(with: members)
+            guard let request = self.sut.nextRequest(for: .v0) else { return XCTFail("No request generated") }
+
+            let response = ZMTransportResponse(payload: [] as ZMTransportData, httpStatus: 400, transportSessionError: nil, apiVersion: APIVersion.v0.rawValue)
+
+            // when
+            request.complete(with: response)
+        }
+
+        XCTAssert(waitForAllGroupsToBeEmpty(withTimeout: 0.2))
+
+        syncMOC.performGroupedBlockAndWait {
+            // then
+            let requests = [self.sut.nextRequest(for: .v0), self.sut.nextRequest(for: .v0)].compactMap { $0 }
+            let teamPath = "/teams/\(members[0].team!.remoteIdentifier!.transportString())/members/"
+            let expectedPaths = Set(members.map { teamPath + $0.remoteIdentifier!.transportString() })
+
+            XCTAssertEqual(Set(requests.map(\.path)), expectedPaths)
+            XCTAssertTrue(members.allSatisfy(\.needsToBeUpdatedFromBackend))
+            XCTAssertNil(self.sut.nextRequest(for: .v0))
+        }
+    }
+
     // MARK: - Payload decoding
 
     func testMembershipPayloadDecoding_AllFields() {
@@ -221,12 +321,24 @@ class PermissionsDownloadRequestStrategyTests: MessagingTest {
     // MARK: - Helper
 
     private func boostrapChangeTrackers(with objects: ZMManagedObject...) {
+        boostrapChangeTrackers(with: objects)
+    }
+
+    private func boostrapChangeTrackers(with objects: [ZMManagedObject]) {
         sut.contextChangeTrackers.forEach {
             $0.objectsDidChange(Set(objects))
         }
 
     }
 
+    private func createMember(in team: Team) -> Member {
+        let user = ZMUser.insertNewObject(in: syncMOC)
+        user.remoteIdentifier = .create()
+        let member = Member.getOrCreateMember(for: user, in: team, context: syncMOC)
+        member.needsToBeUpdatedFromBackend = true
+        return member
+    }
+
 }
 
 extension Dictionary {
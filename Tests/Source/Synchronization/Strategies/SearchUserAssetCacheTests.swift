@@ -0,0 +1,64 @@
+//
+// Wire
+// Copyright (C) 2022 Wire Swiss GmbH
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see http://www.gnu.org/licenses/.
+//
+
+import Foundation
+@testable import WireSyncEngine
+
+class SearchUserAssetCacheTests: XCTestCase {
+
+    var accountContainer: URL!
+
+    override func setUp() {
+        super.setUp()
+        accountContainer = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: accountContainer)
+        accountContainer = nil
+        super.tearDown()
+    }
+
+    func testThatItDoesNotShareAssetsBetweenAccounts() {
+        // given
+        let otherAccountContainer = accountContainer.appendingPathComponent("other", isDirectory: true)
+        let sut = SearchUserAssetCache(directory: SearchUserAssetCache.directory(in: accountContainer))
+        sut.store(Data("image".utf8), forAssetKey: "3-1-asset")
+
+        // when
+        let otherAccountCache = SearchUserAssetCache(directory: SearchUserAssetCache.directory(in: otherAccountContainer))
+
+        // then
+        XCTAssertNil(otherAccountCache.data(forAssetKey: "3-1-asset"))
+    }
+
+    func testThatItDeletesThePersistedAssets_WhenRemovingAll() {
+        // given
+        let directory = SearchUserAssetCache.directory(in: accountContainer)
+        let sut = SearchUserAssetCache(directory: directory)
+        sut.store(Data("image".utf8), forAssetKey: "3-1-asset")
+
+        // when
+        sut.removeAll()
+
+        // then
+        XCTAssertNil(sut.data(forAssetKey: "3-1-asset"))
+        XCTAssertFalse(FileManager.default.fileExists(atPath: directory.path))
+    }
+
+}
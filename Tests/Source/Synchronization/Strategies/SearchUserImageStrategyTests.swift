@@ -27,17 +27,23 @@ class SearchUserImageStrategyTests: MessagingTest {
 
     var sut: SearchUserImageStrategy!
     var mockApplicationStatus: MockApplicationStatus!
+    var assetCache: SearchUserAssetCache!
 
     override func setUp() {
         super.setUp()
         uiMOC.zm_searchUserCache = NSCache()
         mockApplicationStatus = MockApplicationStatus()
         mockApplicationStatus.mockSynchronizationState = .online
-        sut = SearchUserImageStrategy(applicationStatus: mockApplicationStatus, managedObjectContext: uiMOC)
+        assetCache = SearchUserAssetCache(directory: nil)
+        sut = SearchUserImageStrategy(applicationStatus: mockApplicationStatus,
+                                      managedObjectContext: uiMOC,
+                                      assetCache: assetCache,
+                                      profileBatchingInterval: 0)
     }
 
     override func tearDown() {
         sut = nil
+        assetCache = nil
         uiMOC.zm_searchUserCache = nil
         mockApplicationStatus = nil
         BackendInfo.domain = nil
@@ -459,4 +465,96 @@ extension SearchUserImageStrategyTests {
         XCTAssertTrue(note.imageMediumDataChanged)
         XCTAssertEqual(note.user as? ZMSearchUser, searchUser1)
     }
+
+    // MARK: - Caching and batching
+
+    func testThatItServesPreviewAssetsFromTheCacheWithoutARequest() {
+        // given
+        let imageData = verySmallJPEGData()
+        let searchUser = setupSearchDirectory(userCount: 1).first!
+        let previewAssetKey = UUID().transportString()
+        searchUser.update(from: userData(previewAssetKey: previewAssetKey, for: searchUser.remoteIdentifier!))
+        uiMOC.zm_searchUserCache?.setObject(searchUser, forKey: searchUser.remoteIdentifier! as NSUUID)
+        assetCache.store(imageData, forAssetKey: previewAssetKey)
+
+        // when
+        searchUser.requestPreviewProfileImage()
+        let request = sut.nextRequest(for: .v0)
+        XCTAssert(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // then
+        XCTAssertNil(request)
+        XCTAssertEqual(searchUser.previewImageData, imageData)
+        XCTAssertEqual(sut.statistics.assetCacheHitCount, 1)
+        XCTAssertEqual(sut.statistics.assetRequestCount, 0)
+    }
+
+    func testThatItStoresDownloadedPreviewAssetsInTheCache() {
+        // given
+        let imageData = verySmallJPEGData()
+        let searchUser = setupSearchDirectory(userCount: 1).first!
+        let previewAssetKey = UUID().transportString()
+        searchUser.update(from: userData(previewAssetKey: previewAssetKey, for: searchUser.remoteIdentifier!))
+        searchUser.requestPreviewProfileImage()
+
+        // when
+        guard let request = sut.nextRequest(for: .v0) else { return XCTFail() }
+        request.complete(with: ZMTransportResponse(imageData: imageData, httpStatus: 200, transportSessionError: nil, headers: nil, apiVersion: APIVersion.v0.rawValue))
+        XCTAssert(waitForAllGroupsToBeEmpty(withTimeout: 0.5))
+
+        // then
+        XCTAssertEqual(assetCache.data(forAssetKey: previewAssetKey), imageData)
+        XCTAssertEqual(sut.statistics.assetRequestCount, 1)
+    }
+
+    func testThatItDeduplicatesRepeatedRequestsForTheSameUser() {
+        // given
+        let searchUser = setupSearchDirectory(userCount: 1).first!
+        searchUser.update(from: userData(previewAssetKey: UUID().transportString(), for: searchUser.remoteIdentifier!))
+
+        // when
+        searchUser.requestPreviewProfileImage()
+        searchUser.requestPreviewProfileImage()
+
+        // then
+        XCTAssertNotNil(sut.nextRequest(for: .v0))
+        XCTAssertNil(sut.nextRequest(for: .v0))
+        XCTAssertEqual(sut.statistics.deduplicatedRequestCount, 1)
+    }
+
+    func testThatItWaitsForTheBatchingIntervalBeforeFetchingProfiles() {
+        // given
+        sut = SearchUserImageStrategy(applicationStatus: mockApplicationStatus,
+                                      managedObjectContext: uiMOC,
+                                      assetCache: assetCache,
+                                      profileBatchingInterval: 60)
+        let searchSet = setupSearchDirectory(userCount: 3)
+
+        // when
+        searchSet.forEach({ $0.requestPreviewProfileImage() })
+
+        // then
+        XCTAssertNil(sut.nextRequest(for: .v0))
+        XCTAssertEqual(sut.statistics.profileRequestCount, 0)
+    }
+
+    func testThatItFetchesProfilesBeforeTheBatchingIntervalWhenTheBatchIsFull() {
+        // given
+        sut = SearchUserImageStrategy(applicationStatus: mockApplicationStatus,
+                                      managedObjectContext: uiMOC,
+                                      assetCache: assetCache,
+                                      profileBatchingInterval: 60)
+        let searchSet = setupSearchDirectory(userCount: SearchUserImageStrategy.maxProfileBatchSize + 10)
+
+        // when
+        searchSet.forEach({ $0.requestPreviewProfileImage() })
+
+        // then
+        guard let request1 = sut.nextRequest(for: .v0) else { return XCTFail() }
+        guard let request2 = sut.nextRequest(for: .v0) else { return XCTFail() }
+        XCTAssertEqual(userIDs(in: request1).count, SearchUserImageStrategy.maxProfileBatchSize)
+        XCTAssertEqual(userIDs(in: request2).count, 10)
+        XCTAssertEqual(userIDs(in: request1).union(userIDs(in: request2)), userIDs(from: searchSet))
+        XCTAssertEqual(sut.statistics.profileRequestCount, 2)
+    }
 }
@@ -644,6 +644,149 @@ class TeamDownloadRequestStrategy_EventsTests: MessagingTest {
         XCTAssertEqual(member.team, team)
     }
 
+    // MARK: - Batched Member Events
+
+    func testThatItProcessesABatchOfMemberEventsWithPrefetchedUsers() {
+        // given
+        let teamId = UUID.create()
+        let existingUserId = UUID.create()
+        let newUserId = UUID.create()
+        let leavingUserId = UUID.create()
+
+        syncMOC.performGroupedBlockAndWait {
+            let team = Team.fetchOrCreate(with: teamId, create: true, in: self.syncMOC, created: nil)!
+            let existingUser = ZMUser.insertNewObject(in: self.syncMOC)
+            existingUser.remoteIdentifier = existingUserId
+            let leavingUser = ZMUser.insertNewObject(in: self.syncMOC)
+            leavingUser.remoteIdentifier = leavingUserId
+            _ = Member.getOrCreateMember(for: leavingUser, in: team, context: self.syncMOC)
+            XCTAssert(self.syncMOC.saveOrRollback())
+        }
+
+        let events = [
+            memberEvent(type: "team.member-join", teamId: teamId, userId: existingUserId),
+            memberEvent(type: "team.member-join", teamId: teamId, userId: newUserId),
+            memberEvent(type: "team.member-update", teamId: teamId, userId: newUserId),
+            memberEvent(type: "team.member-leave", teamId: teamId, userId: leavingUserId)
+        ]
+
+        // when
+        processEvents(events, prefetching: true)
+
+        // then
+        syncMOC.performGroupedBlockAndWait {
+            guard let team = Team.fetch(with: teamId, in: self.syncMOC) else { return XCTFail("No team") }
+            guard let existingUser = ZMUser.fetch(with: existingUserId, in: self.syncMOC) else { return XCTFail("No existing user") }
+            guard let newUser = ZMUser.fetch(with: newUserId, in: self.syncMOC) else { return XCTFail("No new user") }
+
+            XCTAssertEqual(existingUser.membership?.team, team)
+            XCTAssertEqual(newUser.membership?.team, team)
+            XCTAssert(newUser.needsToBeUpdatedFromBackend)
+            XCTAssertEqual(newUser.membership?.needsToBeUpdatedFromBackend, true)
+            XCTAssertNil(Member.fetch(with: leavingUserId, in: self.syncMOC))
+        }
+    }
+
+    func testThatItDoesNotDuplicateAUserInsertedAfterThePrefetch() {
+        // given
+        let teamId = UUID.create()
+        let userId = UUID.create()
+        let events = [memberEvent(type: "team.member-join", teamId: teamId, userId: userId)]
+
+        syncMOC.performGroupedBlockAndWait {
+            _ = Team.fetchOrCreate(with: teamId, create: true, in: self.syncMOC, created: nil)
+            XCTAssert(self.syncMOC.saveOrRollback())
+        }
+
+        // when
+        syncMOC.performGroupedBlockAndWait {
+            self.sut.prefetchObjects(toProcessEvents: events)
+
+            let user = ZMUser.insertNewObject(in: self.syncMOC)
+            user.remoteIdentifier = userId
+
+            events.forEach { self.sut.processEvents([$0], liveEvents: false, prefetchResult: nil) }
+            self.sut.didProcessEvents()
+            XCTAssert(self.syncMOC.saveOrRollback())
+        }
+
+        // then
+        syncMOC.performGroupedBlockAndWait {
+            let fetchRequest = NSFetchRequest<ZMUser>(entityName: ZMUser.entityName())
+            fetchRequest.predicate = NSPredicate(format: "%K == %@", ZMUser.remoteIdentifierDataKey()!, userId.uuidData as NSData)
+            let users = self.syncMOC.fetchOrAssert(request: fetchRequest)
+
+            XCTAssertEqual(users.count, 1)
+            XCTAssertNotNil(users.first?.membership)
+        }
+    }
+
+    func testThatItFetchesTheUsersOfABatchOfMemberEventsOnce() {
+        // given
+        let teamId = UUID.create()
+        let userIds = (0..<100).map { _ in UUID.create() }
+
+        syncMOC.performGroupedBlockAndWait {
+            _ = Team.fetchOrCreate(with: teamId, create: true, in: self.syncMOC, created: nil)
+            for userId in userIds.prefix(50) {
+                let user = ZMUser.insertNewObject(in: self.syncMOC)
+                user.remoteIdentifier = userId
+            }
+            XCTAssert(self.syncMOC.saveOrRollback())
+        }
+
+        let events = userIds.map { memberEvent(type: "team.member-join", teamId: teamId, userId: $0) }
+            + userIds.map { memberEvent(type: "team.member-update", teamId: teamId, userId: $0) }
+
+        // when
+        processEvents(events, prefetching: true)
+
+        // then
+        XCTAssertEqual(sut.memberEventsStatistics.userFetchCount, 1)
+        syncMOC.performGroupedBlockAndWait {
+            for userId in userIds {
+                XCTAssertNotNil(ZMUser.fetch(with: userId, in: self.syncMOC)?.membership)
+            }
+        }
+    }
+
+    func testPerformanceOfProcessingMemberJoinEvents_OneByOne() {
+        measureProcessingMemberJoinEvents(prefetching: false)
+    }
+
+    func testPerformanceOfProcessingMemberJoinEvents_Prefetched() {
+        measureProcessingMemberJoinEvents(prefetching: true)
+    }
+
+    private func measureProcessingMemberJoinEvents(prefetching: Bool) {
+        // given
+        let teamId = UUID.create()
+        let userIds = (0..<5_000).map { _ in UUID.create() }
+
+        syncMOC.performGroupedBlockAndWait {
+            _ = Team.fetchOrCreate(with: teamId, create: true, in: self.syncMOC, created: nil)
+            for userId in userIds.prefix(2_500) {
+                let user = ZMUser.insertNewObject(in: self.syncMOC)
+                user.remoteIdentifier = userId
+            }
+            XCTAssert(self.syncMOC.saveOrRollback())
+        }
+
+        let events = userIds.map { memberEvent(type: "team.member-join", teamId: teamId, userId: $0) }
+
+        // when
+        measure {
+            self.syncMOC.performGroupedBlockAndWait {
+                if prefetching {
+                    self.sut.prefetchObjects(toProcessEvents: events)
+                }
+                events.forEach { self.sut.processEvents([$0], liveEvents: false, prefetchResult: nil) }
+                self.sut.didProcessEvents()
+                self.syncMOC.rollback()
+            }
+        }
+    }
+
     // MARK: - Team Conversation-Create
 
     func testThatItIgnoresTeamConversationCreateUpdateEvent() {
@@ -687,4 +830,29 @@ class TeamDownloadRequestStrategy_EventsTests: MessagingTest {
         XCTAssert(waitForAllGroupsToBeEmpty(withTimeout: 0.5), file: file, line: line)
     }
 
+    /// Processes the events one by one like the event processor does, optionally prefetching the objects of the batch
+    private func processEvents(_ events: [ZMUpdateEvent], prefetching: Bool, file: StaticString = #file, line: UInt = #line) {
+        syncMOC.performGroupedBlock {
+            if prefetching {
+                self.sut.prefetchObjects(toProcessEvents: events)
+            }
+            events.forEach { self.sut.processEvents([$0], liveEvents: false, prefetchResult: nil) }
+            self.sut.didProcessEvents()
+            XCTAssert(self.syncMOC.saveOrRollback(), file: file, line: line)
+        }
+
+        XCTAssert(waitForAllGroupsToBeEmpty(withTimeout: 0.5), file: file, line: line)
+    }
+
+    private func memberEvent(type: String, teamId: UUID, userId: UUID) -> ZMUpdateEvent {
+        let payload: [String: Any] = [
+            "type": type,
+            "team": teamId.transportString(),
+            "time": Date().transportString(),
+            "data": ["user": userId.transportString()]
+        ]
+
+        return ZMUpdateEvent(fromEventStreamPayload: payload as ZMTransportData, uuid: nil)!
+    }
+
 }
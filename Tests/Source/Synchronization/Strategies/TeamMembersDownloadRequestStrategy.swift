@@ -196,4 +196,69 @@ class TeamMembersDownloadRequestStrategyTests: MessagingTest {
         }
     }
 
+    // MARK: - Delta Slow Sync
+
+    func performSlowSync(with payload: [String: Any]) -> SyncPhaseTimeline.Entry? {
+        var entry: SyncPhaseTimeline.Entry?
+
+        syncMOC.performGroupedBlockAndWait {
+            self.mockApplicationStatus.mockSynchronizationState = .slowSyncing
+            self.mockSyncStatus.forceSlowSync()
+            self.mockSyncStatus.mockPhase = .fetchingTeamMembers
+
+            guard let request = self.sut.nextRequest(for: .v0) else { return XCTFail("No request generated") }
+
+            let response = ZMTransportResponse(payload: payload as ZMTransportData, httpStatus: 200, transportSessionError: nil, apiVersion: APIVersion.v0.rawValue)
+            request.complete(with: response)
+        }
+
+        XCTAssert(waitForAllGroupsToBeEmpty(withTimeout: 0.2))
+
+        syncMOC.performGroupedBlockAndWait {
+            entry = self.mockSyncStatus.slowSyncTimeline.entry(for: .fetchingTeamMembers)
+        }
+
+        return entry
+    }
+
+    func testThatItDoesNotApplyUnchangedTeamMembers_OnNextSlowSync() {
+        // given
+        syncMOC.performGroupedBlockAndWait {
+            _ = self.createTeam()
+        }
+        let fullSync = performSlowSync(with: sampleResponseForSmallTeam)
+
+        // when
+        let deltaSync = performSlowSync(with: sampleResponseForSmallTeam)
+
+        // then
+        XCTAssertEqual(fullSync?.objectsWritten, 1)
+        XCTAssertGreaterThan(fullSync?.bytesReceived ?? 0, 0)
+        XCTAssertEqual(deltaSync?.bytesReceived, fullSync?.bytesReceived)
+        XCTAssertEqual(deltaSync?.objectsWritten, 0)
+        XCTAssertEqual(deltaSync?.unchangedPayloads, 1)
+        XCTAssertTrue(mockSyncStatus.didCallFinishCurrentSyncPhase)
+    }
+
+    func testThatItAppliesChangedTeamMembers_OnNextSlowSync() {
+        // given
+        var team: Team!
+        syncMOC.performGroupedBlockAndWait {
+            team = self.createTeam()
+        }
+        _ = performSlowSync(with: sampleResponseForSmallTeam)
+
+        var payload = sampleResponseForSmallTeam
+        payload["members"] = (sampleResponseForSmallTeam["members"] as! [[String: Any]]) + [["user": UUID().transportString()]]
+
+        // when
+        let deltaSync = performSlowSync(with: payload)
+
+        // then
+        XCTAssertEqual(deltaSync?.objectsWritten, 2)
+        syncMOC.performGroupedBlockAndWait {
+            XCTAssertEqual(team.members.count, 3)
+        }
+    }
+
 }
@@ -77,7 +77,7 @@ class TypingStrategyTests: MessagingTest {
         self.mockApplicationStatus = MockApplicationStatus()
         self.mockApplicationStatus.mockSynchronizationState = .online
 
-        self.sut = TypingStrategy(applicationStatus: mockApplicationStatus, syncContext: syncMOC, uiContext: uiMOC, typing: typing)
+        self.sut = TypingStrategy(applicationStatus: mockApplicationStatus, syncContext: syncMOC, uiContext: uiMOC, typing: typing, stopGraceInterval: 0)
 
         syncMOC.performGroupedBlockAndWait {
             self.conversationA = ZMConversation.insertNewObject(in: self.syncMOC)
@@ -737,6 +737,21 @@ extension TypingStrategyTests {
             XCTAssert(waitForCustomExpectations(withTimeout: 0.1))
         }
     }
+
+    func testThatItReschedulesTheThrottlingTimer_WhenAnEarlierEventIsPending() {
+        syncMOC.performGroupedBlockAndWait {
+            // given
+            let now = Date()
+            self.sut.scheduleThrottlingTimer(for: now.addingTimeInterval(10))
+
+            // when
+            self.sut.scheduleThrottlingTimer(for: now.addingTimeInterval(1))
+            self.sut.scheduleThrottlingTimer(for: now.addingTimeInterval(5))
+
+            // then
+            XCTAssertEqual(self.sut.throttlingTimerDate, now.addingTimeInterval(1))
+        }
+    }
 }
 
 class TypingEventTests: MessagingTest {
@@ -827,3 +842,163 @@ class TypingEventTests: MessagingTest {
 
     }
 }
+
+class TypingEventQueueTests: MessagingTest {
+
+    var sut: TypingEventQueue!
+    var conversationID: NSManagedObjectID!
+    var otherConversationID: NSManagedObjectID!
+    let startDate = Date()
+
+    override func setUp() {
+        super.setUp()
+        sut = TypingEventQueue()
+        conversationID = insertUIConversation().objectID
+        otherConversationID = insertUIConversation().objectID
+    }
+
+    override func tearDown() {
+        sut = nil
+        conversationID = nil
+        otherConversationID = nil
+        super.tearDown()
+    }
+
+    func insertUIConversation() -> ZMConversation {
+        let conversation = ZMConversation.insertNewObject(in: uiMOC)
+        conversation.remoteIdentifier = UUID.create()
+        uiMOC.saveOrRollback()
+        return conversation
+    }
+
+    func events(until date: Date) -> [TypingEvent] {
+        var events = [TypingEvent]()
+        while let event = sut.nextEvent(at: date) {
+            events.append(event)
+        }
+        return events
+    }
+
+    func testThatItCollapsesAKeystrokeStormIntoOneStateChange() {
+        // given
+        sut.addItem(conversationID: conversationID, isTyping: true)
+        XCTAssertEqual(events(until: startDate).map(\.isTyping), [true])
+
+        // when
+        for _ in 0..<100 {
+            sut.addItem(conversationID: conversationID, isTyping: false)
+            sut.addItem(conversationID: conversationID, isTyping: true)
+        }
+
+        // then
+        XCTAssertTrue(events(until: startDate.addingTimeInterval(0.1)).isEmpty)
+        XCTAssertEqual(sut.statistics.sentRequests, 1)
+        XCTAssertEqual(sut.statistics.suppressedRequests, 200)
+    }
+
+    func testThatItSendsTheTrailingStopOfAKeystrokeStorm() {
+        // given
+        sut.addItem(conversationID: conversationID, isTyping: true, at: startDate)
+        _ = events(until: startDate)
+
+        // when
+        for _ in 0..<100 {
+            sut.addItem(conversationID: conversationID, isTyping: true, at: startDate)
+            sut.addItem(conversationID: conversationID, isTyping: false, at: startDate)
+        }
+
+        // then
+        let sentEvents = events(until: startDate.addingTimeInterval(sut.stopGraceInterval))
+        XCTAssertEqual(sentEvents.map(\.isTyping), [false])
+        XCTAssertEqual(sut.statistics.sentRequests, 2)
+        XCTAssertEqual(sut.statistics.suppressedRequests, 199)
+    }
+
+    func testThatItHoldsBackStoppingForTheGraceInterval() {
+        // given
+        sut.addItem(conversationID: conversationID, isTyping: true, at: startDate)
+        _ = events(until: startDate)
+
+        // when
+        sut.addItem(conversationID: conversationID, isTyping: false, at: startDate)
+        let heldBackEvents = events(until: startDate.addingTimeInterval(sut.stopGraceInterval / 2))
+        let nextEventDate = sut.nextEventDate
+        let sentEvents = events(until: startDate.addingTimeInterval(sut.stopGraceInterval))
+
+        // then
+        XCTAssertTrue(heldBackEvents.isEmpty)
+        XCTAssertEqual(nextEventDate, startDate.addingTimeInterval(sut.stopGraceInterval))
+        XCTAssertEqual(sentEvents.map(\.isTyping), [false])
+    }
+
+    func testThatItDoesNotSendStoppingWhichIsFollowedByStarting_WhenPollingAfterEveryChange() {
+        // given
+        sut.addItem(conversationID: conversationID, isTyping: true, at: startDate)
+        var sentEvents = events(until: startDate)
+
+        // when
+        for index in 1...20 {
+            let date = startDate.addingTimeInterval(Double(index) * 0.1)
+            sut.addItem(conversationID: conversationID, isTyping: index % 2 == 0, at: date)
+            sentEvents.append(contentsOf: events(until: date))
+        }
+
+        // then
+        XCTAssertEqual(sentEvents.map(\.isTyping), [true])
+        XCTAssertEqual(sut.statistics.sentRequests, 1)
+    }
+
+    func testThatItHoldsBackARestartUntilTheMinimumResendIntervalPassed() {
+        // given
+        let stopDate = startDate.addingTimeInterval(sut.stopGraceInterval)
+        sut.addItem(conversationID: conversationID, isTyping: true, at: startDate)
+        XCTAssertEqual(events(until: startDate).map(\.isTyping), [true])
+        sut.addItem(conversationID: conversationID, isTyping: false, at: startDate)
+        XCTAssertEqual(events(until: stopDate).map(\.isTyping), [false])
+
+        // when
+        sut.addItem(conversationID: conversationID, isTyping: true, at: stopDate)
+        let heldBackEvents = events(until: stopDate.addingTimeInterval(0.5))
+        let nextEventDate = sut.nextEventDate
+        let sentEvents = events(until: stopDate.addingTimeInterval(TypingEventQueue.minimumResendInterval))
+
+        // then
+        XCTAssertTrue(heldBackEvents.isEmpty)
+        XCTAssertEqual(nextEventDate, stopDate.addingTimeInterval(TypingEventQueue.minimumResendInterval))
+        XCTAssertEqual(sentEvents.map(\.isTyping), [true])
+        XCTAssertNil(sut.nextEventDate)
+    }
+
+    func testThatItLimitsTheNumberOfRequestsForAllConversations() {
+        // given
+        let conversationIDs = (0..<(TypingEventQueue.requestLimit * 2)).map { _ in insertUIConversation().objectID }
+        var sentEvents = [TypingEvent]()
+
+        // when
+        for (index, conversationID) in conversationIDs.enumerated() {
+            let date = startDate.addingTimeInterval(Double(index) * 0.01)
+            sut.addItem(conversationID: conversationID, isTyping: false, at: date.addingTimeInterval(-sut.stopGraceInterval))
+            sentEvents.append(contentsOf: events(until: date))
+        }
+
+        // then
+        XCTAssertEqual(sentEvents.count, TypingEventQueue.requestLimit)
+        XCTAssertEqual(sut.nextEventDate, startDate.addingTimeInterval(TypingEventQueue.requestLimitInterval))
+        XCTAssertFalse(sut.conversations.isEmpty)
+    }
+
+    func testThatItDoesNotStopAConversationAgain_WhenTypingStartsInAnotherConversation() {
+        // given
+        sut.addItem(conversationID: conversationID, isTyping: true)
+        sut.addItem(conversationID: otherConversationID, isTyping: true)
+        _ = events(until: startDate)
+
+        // when
+        sut.addItem(conversationID: otherConversationID, isTyping: false)
+        sut.addItem(conversationID: otherConversationID, isTyping: true)
+
+        // then
+        XCTAssertNil(sut.conversations[conversationID])
+    }
+
+}
@@ -726,6 +726,55 @@ static NSString * const LastUpdateEventIDStoreKey = @"LastUpdateEventID";
     WaitForAllGroupsToBeEmpty(0.5);
 }
 
+- (void)testThatItResumesFromTheLastStoredEventWhenThePushChannelFlapsDuringQuickSync
+{
+    // given
+    NSUInteger const numberOfPages = 9;
+    NSUUID *lastEventID = nil;
+    [self.mockSyncStatus pushChannelDidOpen];
+    XCTAssertEqual(self.mockSyncStatus.currentSyncPhase, SyncPhaseFetchingMissedEvents);
+    
+    // when
+    for (NSUInteger page = 0; page < numberOfPages; page++) {
+        ZMTransportRequest *request = [self.sut nextRequestForAPIVersion:APIVersionV0];
+        XCTAssertNotNil(request);
+        
+        if (lastEventID != nil) {
+            NSURLComponents *components = [NSURLComponents componentsWithString:request.path];
+            XCTAssertTrue([components.queryItems containsObject:[NSURLQueryItem queryItemWithName:@"since" value:lastEventID.transportString]]);
+        }
+        
+        if (page % 3 == 2) {
+            // the push channel reconnects while the page is being fetched
+            [self.mockSyncStatus pushChannelDidClose];
+            [self.mockSyncStatus pushChannelDidOpen];
+        }
+        
+        lastEventID = [NSUUID timeBasedUUID];
+        [request completeWithResponse:[self responseForSettingLastUpdateEventID:lastEventID hasMore:page + 1 < numberOfPages]];
+        WaitForAllGroupsToBeEmpty(0.5);
+    }
+    
+    // then
+    // the stream is fetched once more from the last stored event to cover the last reconnect
+    XCTAssertEqual(self.mockSyncStatus.currentSyncPhase, SyncPhaseFetchingMissedEvents);
+    XCTAssertFalse(self.mockSyncStatus.needsToRestartQuickSync);
+    
+    ZMTransportRequest *request = [self.sut nextRequestForAPIVersion:APIVersionV0];
+    NSURLComponents *components = [NSURLComponents componentsWithString:request.path];
+    XCTAssertTrue([components.queryItems containsObject:[NSURLQueryItem queryItemWithName:@"since" value:lastEventID.transportString]]);
+    
+    NSDictionary *payload = @{@"notifications" : @[], @"has_more" : @NO};
+    [request completeWithResponse:[ZMTransportResponse responseWithPayload:payload HTTPStatus:200 transportSessionError:nil apiVersion:0]];
+    WaitForAllGroupsToBeEmpty(0.5);
+    
+    XCTAssertEqual(self.mockSyncStatus.currentSyncPhase, SyncPhaseDone);
+    XCTAssertEqual(self.mockSyncStatus.lastQuickSyncStatistics.numberOfFetches, 2);
+    XCTAssertEqual(self.mockSyncStatus.lastQuickSyncStatistics.numberOfFetchedEvents, numberOfPages);
+    XCTAssertEqual(self.mockSyncStatus.lastQuickSyncStatistics.numberOfDuplicateEvents, 0);
+    XCTAssertEqualObjects(self.uiMOC.zm_lastNotificationID, lastEventID);
+}
+
 @end
 
 
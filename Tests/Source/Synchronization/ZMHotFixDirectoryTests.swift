@@ -167,4 +167,67 @@ class ZMHotFixDirectoryTests: MessagingTest {
         }
     }
 
+    func testThatANewConversationSystemMessageIsOnlyInsertedInTheConversationsOfTheChunk() {
+        syncMOC.performGroupedBlockAndWait {
+            // given
+            let conversations: [ZMConversation] = (0..<3).map { _ in
+                let conversation = ZMConversation.insertNewObject(in: self.syncMOC)
+                conversation.conversationType = .group
+                return conversation
+            }
+            self.syncMOC.saveOrRollback()
+
+            // when
+            let processedCount = ZMHotFixDirectory.insertNewConversationSystemMessage(self.syncMOC, offset: 1, limit: 1)
+
+            // then
+            XCTAssertEqual(processedCount, 1)
+            XCTAssertEqual(conversations.filter { $0.lastMessage != nil }.count, 1)
+        }
+    }
+
+    func testThatANewConversationSystemMessageIsInsertedInAllConversations_WhenAppliedChunkByChunk() {
+        syncMOC.performGroupedBlockAndWait {
+            // given
+            let conversations: [ZMConversation] = (0..<5).map { _ in
+                let conversation = ZMConversation.insertNewObject(in: self.syncMOC)
+                conversation.remoteIdentifier = UUID()
+                conversation.conversationType = .group
+                return conversation
+            }
+            self.syncMOC.saveOrRollback()
+
+            // when
+            var offset = 0
+            var processedCount: Int
+            repeat {
+                processedCount = ZMHotFixDirectory.insertNewConversationSystemMessage(self.syncMOC, offset: offset, limit: 2)
+                offset += processedCount
+                self.syncMOC.saveOrRollback()
+            } while processedCount == 2
+
+            // then
+            XCTAssertEqual(offset, conversations.count)
+            XCTAssertTrue(conversations.allSatisfy { $0.lastMessage != nil })
+        }
+    }
+
+    func testThatANewConversationSystemMessageIsNotInsertedTwice() {
+        syncMOC.performGroupedBlockAndWait {
+            // given
+            let conversation = ZMConversation.insertNewObject(in: self.syncMOC)
+            conversation.conversationType = .group
+            conversation.appendNewConversationSystemMessage(at: Date(), users: [])
+            _ = try! conversation.appendText(content: "Hello")
+            self.syncMOC.saveOrRollback()
+            let messageCount = conversation.allMessages.count
+
+            // when
+            ZMHotFixDirectory.insertNewConversationSystemMessage(self.syncMOC)
+
+            // then
+            XCTAssertEqual(conversation.allMessages.count, messageCount)
+        }
+    }
+
 }
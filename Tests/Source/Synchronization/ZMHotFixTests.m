@@ -66,6 +66,37 @@
 
 
 
+@interface FakeChunkedHotFixDirectory : ZMHotFixDirectory
+@property (nonatomic) NSInteger numberOfObjectsToPatch;
+@property (nonatomic) NSMutableArray<NSNumber *> *chunkOffsets;
+@end
+
+@implementation FakeChunkedHotFixDirectory
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        self.chunkOffsets = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (NSArray *)patches
+{
+    return @[
+             [ZMHotFixPatch patchWithVersion:@"1.0" chunkedPatchCode:^NSInteger(NSManagedObjectContext *moc, NSInteger offset, NSInteger limit) {
+                 NOT_USED(moc);
+                 [self.chunkOffsets addObject:@(offset)];
+                 return MAX(0, MIN(limit, self.numberOfObjectsToPatch - offset));
+             }],
+    ];
+}
+
+@end
+
+
+
 @interface PushTokenNotificationObserver : NSObject
 @property (nonatomic) NSUInteger notificationCount;
 @end
@@ -211,6 +242,79 @@
     }];
 }
 
+- (void)testThatItAppliesAChunkedPatchChunkByChunk
+{
+    FakeChunkedHotFixDirectory *directory = [[FakeChunkedHotFixDirectory alloc] init];
+    directory.numberOfObjectsToPatch = 2 * ZMHotFixPatchChunkSize + 1;
+
+    [self.syncMOC performGroupedBlockAndWait:^{
+        // given
+        [self saveNewVersion];
+        self.sut = [[ZMHotFix alloc] initWithHotFixDirectory:directory syncMOC:self.syncMOC];
+
+        // when
+        [self.sut applyPatchesForCurrentVersion:@"1.0"];
+    }];
+    WaitForAllGroupsToBeEmpty(0.5);
+
+    [self.syncMOC performGroupedBlockAndWait:^{
+        // then
+        NSArray *expectedOffsets = @[@0, @(ZMHotFixPatchChunkSize), @(2 * ZMHotFixPatchChunkSize)];
+        XCTAssertEqualObjects(directory.chunkOffsets, expectedOffsets);
+        XCTAssertEqualObjects([self.syncMOC persistentStoreMetadataForKey:@"lastSavedVersion"], @"1.0");
+        XCTAssertNil([self.syncMOC persistentStoreMetadataForKey:@"hotFixPatchInProgressVersion"]);
+        XCTAssertNil([self.syncMOC persistentStoreMetadataForKey:@"hotFixPatchInProgressOffset"]);
+    }];
+}
+
+- (void)testThatItResumesAChunkedPatchFromTheSavedOffset
+{
+    FakeChunkedHotFixDirectory *directory = [[FakeChunkedHotFixDirectory alloc] init];
+    directory.numberOfObjectsToPatch = 2 * ZMHotFixPatchChunkSize + 1;
+
+    [self.syncMOC performGroupedBlockAndWait:^{
+        // given
+        [self saveNewVersion];
+        [self.syncMOC setPersistentStoreMetadata:@"1.0" forKey:@"hotFixPatchInProgressVersion"];
+        [self.syncMOC setPersistentStoreMetadata:@(2 * ZMHotFixPatchChunkSize) forKey:@"hotFixPatchInProgressOffset"];
+        self.sut = [[ZMHotFix alloc] initWithHotFixDirectory:directory syncMOC:self.syncMOC];
+
+        // when
+        [self.sut applyPatchesForCurrentVersion:@"1.0"];
+    }];
+    WaitForAllGroupsToBeEmpty(0.5);
+
+    [self.syncMOC performGroupedBlockAndWait:^{
+        // then
+        XCTAssertEqualObjects(directory.chunkOffsets, @[@(2 * ZMHotFixPatchChunkSize)]);
+        XCTAssertEqualObjects([self.syncMOC persistentStoreMetadataForKey:@"lastSavedVersion"], @"1.0");
+    }];
+}
+
+- (void)testThatItSavesAfterEachChunk_WhenApplyingAllChunksOfAPatch
+{
+    NSInteger numberOfObjectsToPatch = 2 * ZMHotFixPatchChunkSize + 1;
+    NSMutableArray<NSNumber *> *unsavedInsertionCounts = [NSMutableArray array];
+    ZMHotFixPatch *patch = [ZMHotFixPatch patchWithVersion:@"1.0" chunkedPatchCode:^NSInteger(NSManagedObjectContext *moc, NSInteger offset, NSInteger limit) {
+        [unsavedInsertionCounts addObject:@(moc.insertedObjects.count)];
+        [ZMConversation insertNewObjectInManagedObjectContext:moc];
+        return MAX(0, MIN(limit, numberOfObjectsToPatch - offset));
+    }];
+
+    [self.syncMOC performGroupedBlockAndWait:^{
+        // given
+        self.sut = [[ZMHotFix alloc] initWithSyncMOC:self.syncMOC];
+
+        // when
+        [self.sut applyAllChunksOfPatch:patch];
+
+        // then
+        XCTAssertEqualObjects(unsavedInsertionCounts, (@[@0, @0, @0]));
+        XCTAssertFalse(self.syncMOC.hasChanges);
+        XCTAssertNil([self.syncMOC persistentStoreMetadataForKey:@"hotFixPatchInProgressVersion"]);
+    }];
+}
+
 
 #pragma mark - CurrentFixes
 
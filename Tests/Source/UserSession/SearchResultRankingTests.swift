@@ -0,0 +1,178 @@
+//
+// Wire
+// Copyright (C) 2022 Wire Swiss GmbH
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see http://www.gnu.org/licenses/.
+//
+
+import Foundation
+@testable import WireSyncEngine
+
+class SearchResultRankingTests: DatabaseTest {
+
+    // MARK: - Ranking
+
+    func testThatItRanksExactHandleMatchesFirst() {
+        // given
+        let fuzzy = searchUser(name: "Hannes Smith", handle: "hsmith")
+        let prefix = searchUser(name: "Hans Peter", handle: "peter")
+        let token = searchUser(name: "Peter Hansen", handle: "ph")
+        let exact = searchUser(name: "Someone", handle: "hans")
+        let sut = SearchResultRanker(query: "hans")
+
+        // when
+        let ranked = sut.rank([fuzzy, token, prefix, exact])
+
+        // then
+        XCTAssertEqual(ranked, [exact, prefix, token, fuzzy])
+    }
+
+    func testThatItKeepsTheOriginalOrderForEqualScores() {
+        // given
+        let users = (0..<10).map { searchUser(name: "User \($0)", handle: "user\($0)x") }
+        let sut = SearchResultRanker(query: "user")
+
+        // when
+        let ranked = sut.rank(users)
+
+        // then
+        XCTAssertEqual(ranked, users)
+    }
+
+    func testThatItDoesNotReorderWhenQueryIsEmpty() {
+        // given
+        let users = [searchUser(name: "B", handle: "b"), searchUser(name: "A", handle: "a")]
+        let sut = SearchResultRanker(query: "")
+
+        // then
+        XCTAssertEqual(sut.rank(users), users)
+    }
+
+    // MARK: - Merging
+
+    func testThatDirectoryUnionDeduplicatesTeamMembersAndKeepsOrder() {
+        // given
+        let first = searchUser(name: "First", handle: "first")
+        let second = searchUser(name: "Second", handle: "second")
+        let third = searchUser(name: "Third", handle: "third")
+        let local = result(teamMembers: [first, second])
+        let remote = result(teamMembers: [second, third])
+
+        // when
+        let merged = local.union(withDirectoryResult: remote)
+
+        // then
+        XCTAssertEqual(merged.teamMembers, [first, second, third])
+    }
+
+    func testThatDeduplicatedResultDoesNotDependOnTheOrderOfTheMerges() {
+        // given
+        let contact = searchUser(name: "Contact", handle: "contact")
+        let teamMember = searchUser(name: "Team Member", handle: "member")
+        let stranger = searchUser(name: "Stranger", handle: "stranger")
+        let local = result(contacts: [contact], teamMembers: [teamMember])
+        let remote = result(teamMembers: [teamMember], directory: [contact, teamMember, stranger])
+
+        // when
+        let localFirst = SearchResult.empty.union(withLocalResult: local).union(withDirectoryResult: remote).deduplicated()
+        let remoteFirst = SearchResult.empty.union(withDirectoryResult: remote).union(withLocalResult: local).deduplicated()
+
+        // then
+        for merged in [localFirst, remoteFirst] {
+            XCTAssertEqual(merged.contacts, [contact])
+            XCTAssertEqual(merged.teamMembers, [teamMember])
+            XCTAssertEqual(merged.directory, [stranger])
+        }
+    }
+
+    func testThatDeduplicatedResultListsAddressBookUsersOnce() {
+        // given
+        let contact = searchUser(name: "Contact", handle: "contact")
+        let addressBookUser = searchUser(name: "Address Book", handle: "addressbook")
+        let sut = result(contacts: [contact],
+                         addressBook: [contact, addressBookUser, addressBookUser, contact])
+
+        // when
+        let deduplicated = sut.deduplicated()
+
+        // then
+        XCTAssertEqual(deduplicated.contacts, [contact])
+        XCTAssertEqual(deduplicated.addressBook, [contact, addressBookUser])
+    }
+
+    // MARK: - Changes
+
+    func testThatChangeSetContainsInsertedAndDeletedIndexes() {
+        // given
+        let first = searchUser(name: "First", handle: "first")
+        let second = searchUser(name: "Second", handle: "second")
+        let third = searchUser(name: "Third", handle: "third")
+
+        // when
+        let changes = SearchResultChangeSet(from: result(directory: [first, second]),
+                                            to: result(directory: [second, third]))
+
+        // then
+        XCTAssertFalse(changes.isEmpty)
+        XCTAssertEqual(changes.directory.deletedIndexes, IndexSet(integer: 0))
+        XCTAssertEqual(changes.directory.insertedIndexes, IndexSet(integer: 1))
+        XCTAssertTrue(changes.teamMembers.isEmpty)
+    }
+
+    func testThatChangeSetIsEmptyForIdenticalResults() {
+        // given
+        let users = [searchUser(name: "First", handle: "first")]
+
+        // when
+        let changes = SearchResultChangeSet(from: result(directory: users), to: result(directory: users))
+
+        // then
+        XCTAssertTrue(changes.isEmpty)
+    }
+
+    // MARK: - Performance
+
+    func testPerformanceOfMergingAndRankingLargeResults() {
+        // given
+        let local = result(teamMembers: (0..<1000).map { searchUser(name: "Local \($0)", handle: "local\($0)") })
+        let remote = result(teamMembers: Array(local.teamMembers.suffix(500)) + (0..<500).map { searchUser(name: "Remote \($0)", handle: "remote\($0)") },
+                            directory: (0..<1000).map { searchUser(name: "Directory \($0)", handle: "dir\($0)") })
+        let ranker = SearchResultRanker(query: "re")
+
+        // then
+        measure {
+            let merged = local.union(withDirectoryResult: remote).deduplicated().ranked(by: ranker)
+            _ = SearchResultChangeSet(from: local, to: merged)
+        }
+    }
+
+    // MARK: - Helpers
+
+    private func searchUser(name: String, handle: String) -> ZMSearchUser {
+        return ZMSearchUser(contextProvider: coreDataStack!, name: name, handle: handle, accentColor: .brightOrange, remoteIdentifier: UUID())
+    }
+
+    private func result(contacts: [ZMSearchUser] = [],
+                        teamMembers: [ZMSearchUser] = [],
+                        addressBook: [ZMSearchUser] = [],
+                        directory: [ZMSearchUser] = []) -> SearchResult {
+        return SearchResult(contacts: contacts,
+                            teamMembers: teamMembers,
+                            addressBook: addressBook,
+                            directory: directory,
+                            conversations: [],
+                            services: [])
+    }
+
+}
@@ -104,6 +104,34 @@ class SearchTaskTests: DatabaseTest {
 
     }
 
+    func testThatItDeliversInsertedIndexesToResultChangeHandlers() {
+
+        // given
+        let resultArrived = expectation(description: "received result change")
+
+        mockTransportSession.performRemoteChanges { (remoteChanges) in
+            let mockUser = remoteChanges.insertUser(withName: "Dale Cooper")
+            mockUser.handle = "bob"
+        }
+
+        let request = SearchRequest(query: "bob", searchOptions: [.directory])
+        let task = SearchTask(request: request, searchContext: searchMOC, contextProvider: coreDataStack!, transportSession: mockTransportSession)
+
+        // expect
+        task.onResultChange { (result, changes, isCompleted) in
+            resultArrived.fulfill()
+            XCTAssertTrue(isCompleted)
+            XCTAssertEqual(result.directory.count, 1)
+            XCTAssertEqual(changes.directory.insertedIndexes, IndexSet(integer: 0))
+            XCTAssertTrue(changes.directory.deletedIndexes.isEmpty)
+        }
+
+        // when
+        task.performRemoteSearchForTeamUser()
+        XCTAssertTrue(waitForCustomExpectations(withTimeout: 0.5))
+
+    }
+
     func testThatItReturnsNothingWhenSearchingForSelfUserByHandle() {
 
         // given
@@ -348,6 +348,49 @@ extension SyncStatusTests {
         XCTAssertEqual(sut.currentSyncPhase, .fetchingMissedEvents)
     }
 
+    func testThatItDoesNotRestartQuickSyncAgain_WhenTheStreamIsFetchedAgainAfterThePushChannelOpened() {
+        // given
+        uiMOC.zm_lastNotificationID = UUID.timeBasedUUID() as UUID
+        sut = SyncStatus(managedObjectContext: uiMOC, syncStateDelegate: mockSyncDelegate)
+        let fetchBeganAt = Date()
+        sut.pushChannelDidOpen()
+        XCTAssertTrue(sut.needsToRestartQuickSync)
+
+        // when
+        sut.completedFetchingNotificationStream(fetchBeganAt: fetchBeganAt)
+
+        // then
+        XCTAssertEqual(sut.currentSyncPhase, .fetchingMissedEvents)
+        XCTAssertFalse(sut.needsToRestartQuickSync)
+
+        // and when
+        sut.completedFetchingNotificationStream(fetchBeganAt: Date())
+
+        // then
+        XCTAssertEqual(sut.currentSyncPhase, .done)
+    }
+
+    func testThatItCountsDuplicateEventsFetchedDuringQuickSync() {
+        // given
+        uiMOC.zm_lastNotificationID = UUID.timeBasedUUID() as UUID
+        sut = SyncStatus(managedObjectContext: uiMOC, syncStateDelegate: mockSyncDelegate)
+        let eventIDs = [UUID(), UUID()]
+
+        // when
+        sut.didStartFetchingMissedEvents()
+        sut.didFetchMissedEvents(withIDs: eventIDs)
+        sut.didStartFetchingMissedEvents()
+        sut.didFetchMissedEvents(withIDs: [eventIDs[1], UUID()])
+        sut.finishCurrentSyncPhase(phase: .fetchingMissedEvents)
+
+        // then
+        XCTAssertEqual(sut.currentSyncPhase, .done)
+        XCTAssertEqual(sut.lastQuickSyncStatistics?.numberOfFetches, 2)
+        XCTAssertEqual(sut.lastQuickSyncStatistics?.numberOfFetchedEvents, 4)
+        XCTAssertEqual(sut.lastQuickSyncStatistics?.numberOfDuplicateEvents, 1)
+        XCTAssertEqual(sut.quickSyncStatistics.numberOfFetchedEvents, 0)
+    }
+
     func testThatItRestartsSlowSyncWhenRestartSlowSyncIsCalled() {
         // given
         uiMOC.zm_lastNotificationID = UUID.timeBasedUUID() as UUID
@@ -485,4 +528,116 @@ extension SyncStatusTests {
         XCTAssertEqual(uiMOC.zm_lastNotificationID, newID)
         XCTAssertNotEqual(uiMOC.zm_lastNotificationID, oldID)
     }
+
+    // MARK: Concurrent phases
+
+    func testThatIndependentPhasesBecomeActiveWhenTheirPrerequisitesFinish() {
+        // given
+        XCTAssertFalse(sut.isActive(phase: .fetchingTeamRoles))
+
+        // when
+        sut.finishCurrentSyncPhase(phase: .fetchingLastUpdateEventID)
+        sut.finishCurrentSyncPhase(phase: .fetchingTeams)
+
+        // then
+        XCTAssertEqual(sut.currentSyncPhase, .fetchingTeamMembers)
+        XCTAssertTrue(sut.isActive(phase: .fetchingTeamMembers))
+        XCTAssertTrue(sut.isActive(phase: .fetchingTeamRoles))
+        XCTAssertTrue(sut.isActive(phase: .fetchingLegalHoldStatus))
+        XCTAssertFalse(sut.isActive(phase: .fetchingConnections))
+        XCTAssertFalse(sut.isActive(phase: .fetchingLabels))
+    }
+
+    func testThatItSkipsPhasesWhichFinishedAheadOfTheCurrentPhase() {
+        // given
+        sut.finishCurrentSyncPhase(phase: .fetchingLastUpdateEventID)
+        sut.finishCurrentSyncPhase(phase: .fetchingTeams)
+
+        // when
+        sut.finishCurrentSyncPhase(phase: .fetchingTeamRoles)
+
+        // then
+        XCTAssertEqual(sut.currentSyncPhase, .fetchingTeamMembers)
+        XCTAssertFalse(sut.isActive(phase: .fetchingTeamRoles))
+
+        // when
+        sut.finishCurrentSyncPhase(phase: .fetchingTeamMembers)
+
+        // then
+        XCTAssertEqual(sut.currentSyncPhase, .fetchingConnections)
+    }
+
+    func testThatItFinishesSlowSyncOnlyWhenAllPhasesFinished() {
+        // given
+        sut.finishCurrentSyncPhase(phase: .fetchingLastUpdateEventID)
+        sut.finishCurrentSyncPhase(phase: .fetchingTeams)
+        sut.finishCurrentSyncPhase(phase: .fetchingTeamMembers)
+        sut.finishCurrentSyncPhase(phase: .fetchingTeamRoles)
+        sut.finishCurrentSyncPhase(phase: .fetchingConnections)
+        sut.finishCurrentSyncPhase(phase: .fetchingConversations)
+
+        // when
+        sut.finishCurrentSyncPhase(phase: .fetchingLabels)
+        sut.finishCurrentSyncPhase(phase: .fetchingLegalHoldStatus)
+        sut.finishCurrentSyncPhase(phase: .fetchingUsers)
+
+        // then
+        XCTAssertFalse(mockSyncDelegate.didCallFinishSlowSync)
+        XCTAssertEqual(sut.currentSyncPhase, .fetchingSelfUser)
+
+        // when
+        sut.finishCurrentSyncPhase(phase: .fetchingSelfUser)
+
+        // then
+        XCTAssertTrue(mockSyncDelegate.didCallFinishSlowSync)
+        XCTAssertEqual(sut.currentSyncPhase, .fetchingMissedEvents)
+    }
+
+    func testThatItRecordsTheTimelineOfTheSlowSyncPhases() {
+        // given
+        sut.finishCurrentSyncPhase(phase: .fetchingLastUpdateEventID)
+        sut.finishCurrentSyncPhase(phase: .fetchingTeams)
+
+        // when
+        sut.finishCurrentSyncPhase(phase: .fetchingTeamRoles)
+
+        // then
+        let timeline = sut.slowSyncTimeline
+        XCTAssertEqual(timeline.entries.map(\.phase), [.fetchingLastUpdateEventID, .fetchingTeams, .fetchingTeamMembers, .fetchingTeamRoles, .fetchingLegalHoldStatus])
+        XCTAssertNotNil(timeline.entry(for: .fetchingTeams)?.endDate)
+        XCTAssertNotNil(timeline.entry(for: .fetchingTeamRoles)?.endDate)
+        XCTAssertNil(timeline.entry(for: .fetchingTeamMembers)?.endDate)
+    }
+
+    func testThatItResetsTheTimelineWhenForcingASlowSync() {
+        // given
+        sut.finishCurrentSyncPhase(phase: .fetchingLastUpdateEventID)
+        sut.finishCurrentSyncPhase(phase: .fetchingTeams)
+        sut.finishCurrentSyncPhase(phase: .fetchingTeamRoles)
+
+        // when
+        sut.forceSlowSync()
+
+        // then
+        XCTAssertEqual(sut.currentSyncPhase, .fetchingTeams)
+        XCTAssertEqual(sut.slowSyncTimeline.entries.map(\.phase), [.fetchingTeams])
+    }
+
+    func testThatItRecordsThePayloadsOfTheSlowSyncPhases() {
+        // given
+        sut.finishCurrentSyncPhase(phase: .fetchingLastUpdateEventID)
+
+        // when
+        sut.recordSlowSyncPayload(phase: .fetchingTeams, byteCount: 100, objectsWritten: 1)
+        sut.recordSlowSyncPayload(phase: .fetchingTeams, byteCount: 50, objectsWritten: 0, isUnchanged: true)
+        sut.recordSlowSyncPayload(phase: .fetchingLabels, byteCount: 10, objectsWritten: 1)
+
+        // then
+        let entry = sut.slowSyncTimeline.entry(for: .fetchingTeams)
+        XCTAssertEqual(entry?.bytesReceived, 150)
+        XCTAssertEqual(entry?.objectsWritten, 1)
+        XCTAssertEqual(entry?.unchangedPayloads, 1)
+        XCTAssertNil(sut.slowSyncTimeline.entry(for: .fetchingLabels), "Payloads of phases which didn't start are not recorded")
+        XCTAssertEqual(sut.slowSyncTimeline.bytesReceived, 150)
+    }
 }
@@ -42,6 +42,8 @@
     
     [[NSUserDefaults standardUserDefaults] setObject:nil forKey:@"min_version"];
     [[NSUserDefaults standardUserDefaults] setObject:nil forKey:@"exclude"];
+    [[NSUserDefaults standardUserDefaults] setObject:nil forKey:@"blacklist_etag"];
+    [[NSUserDefaults standardUserDefaults] setObject:nil forKey:@"blacklist_last_modified"];
     [[NSUserDefaults standardUserDefaults] synchronize];
     self.successCheckTimeInterval = 30000;
     self.failureCheckTimeInterval = 4000;
@@ -76,6 +78,8 @@
     self.sut = nil;
     [[NSUserDefaults standardUserDefaults] setObject:nil forKey:@"min_version"];
     [[NSUserDefaults standardUserDefaults] setObject:nil forKey:@"exclude"];
+    [[NSUserDefaults standardUserDefaults] setObject:nil forKey:@"blacklist_etag"];
+    [[NSUserDefaults standardUserDefaults] setObject:nil forKey:@"blacklist_last_modified"];
     [[NSUserDefaults standardUserDefaults] synchronize];
     WaitForAllGroupsToBeEmpty(0.5);
     [super tearDown];
@@ -293,4 +297,56 @@ typedef NS_ENUM(int, TestPhase) {
 }
 
 
+- (void)testThatItReportsTheCachedBlacklistWithoutWaitingForTheDownload
+{
+    [self performIgnoringZMLogError:^{
+        // given
+        [self simulateCachedValuesForMinVersion:@"2" excluded:@[@"5"]];
+        NSError *error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNotConnectedToInternet userInfo:nil];
+        [self stubRequestWithResponseObject:nil responseError:error statusCode:0];
+
+        XCTestExpectation *didComplete = [self expectationWithDescription:@"did complete"];
+
+        // when
+        [self createSUTWithCompletionHandler:^(NSString *minVersion, NSArray *excludeVersions) {
+            XCTAssertEqualObjects(minVersion, @"2");
+            XCTAssertEqualObjects(excludeVersions, @[@"5"]);
+            [didComplete fulfill];
+        }];
+
+        // then
+        XCTAssert([self waitForCustomExpectationsWithTimeout:0.5]);
+        [self stopTimers];
+    }];
+}
+
+- (void)testThatItRevalidatesTheCachedBlacklistWithAConditionalRequest
+{
+    [self performIgnoringZMLogError:^{
+        // given
+        [self simulateCachedValuesForMinVersion:@"2" excluded:@[@"5"]];
+        [[NSUserDefaults standardUserDefaults] setObject:@"\"abc\"" forKey:@"blacklist_etag"];
+
+        id<BackendEnvironmentProvider> env = [[MockEnvironment alloc] init];
+        NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[env.blackListURL URLByAppendingPathComponent:@"ios"]];
+        [request setValue:@"\"abc\"" forHTTPHeaderField:@"If-None-Match"];
+        [self stubRequest:request withResponseData:nil responseError:nil HTTPStatusCode:304];
+
+        __block NSUInteger timesCalled = 0;
+
+        // when
+        [self createSUTWithCompletionHandler:^(NSString *minVersion, NSArray *excludeVersions) {
+            XCTAssertEqualObjects(minVersion, @"2");
+            XCTAssertEqualObjects(excludeVersions, @[@"5"]);
+            ++timesCalled;
+        }];
+        WaitForAllGroupsToBeEmpty(0.5);
+
+        // then the cached blacklist was only reported once
+        XCTAssertEqual(timesCalled, 1u);
+        XCTAssertEqualObjects([[NSUserDefaults standardUserDefaults] objectForKey:@"min_version"], @"2");
+        [self stopTimers];
+    }];
+}
+
 @end